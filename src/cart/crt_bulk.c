@@ -202,6 +202,306 @@ out:
 	return rc;
 }
 
+/** Tracking info of one segmented bulk transfer */
+struct crt_bulk_seg_info {
+	/** the caller's descriptor, reported back to the completion cb */
+	struct crt_bulk_desc		 bsi_desc;
+	crt_bulk_cb_t			 bsi_cb;
+	void				*bsi_arg;
+	/** trailer of the local buffer, NULL if it is not streamed */
+	struct crt_bulk_stream_trailer	*bsi_trailer;
+	size_t				 bsi_seg_size;
+	/** offset (relative to bsi_desc) of the next segment to issue */
+	size_t				 bsi_next;
+	/** length of the filled prefix of the local buffer */
+	size_t				 bsi_done;
+	/** bit i is set if segment i after bsi_done completed */
+	uint32_t			 bsi_done_mask;
+	uint32_t			 bsi_inflight;
+	/** filled prefix of the remote buffer, bd_len if it is not streamed */
+	size_t				 bsi_src_ready;
+	/** the ready length of the remote buffer is being pulled */
+	bool				 bsi_polling;
+	/** first error hit by any of the segments */
+	int				 bsi_rc;
+	pthread_mutex_t			 bsi_lock;
+};
+
+static int crt_bulk_seg_cb(const struct crt_bulk_cb_info *cb_info);
+static int crt_bulk_poll_cb(const struct crt_bulk_cb_info *cb_info);
+
+/* Pull the ready length of the remote buffer, called with bsi_lock */
+static int
+crt_bulk_seg_poll(struct crt_bulk_seg_info *info)
+{
+	struct crt_bulk_desc	poll_desc;
+	int			rc;
+
+	poll_desc = info->bsi_desc;
+	poll_desc.bd_remote_off += info->bsi_desc.bd_len +
+		offsetof(struct crt_bulk_stream_trailer, bst_ready);
+	poll_desc.bd_local_off += info->bsi_desc.bd_len +
+		offsetof(struct crt_bulk_stream_trailer, bst_poll);
+	poll_desc.bd_len = sizeof(info->bsi_trailer->bst_poll);
+
+	rc = crt_hg_bulk_transfer(&poll_desc, crt_bulk_poll_cb, info, NULL,
+				  false);
+	if (rc != 0) {
+		D_ERROR("poll of ready length failed, rc: "DF_RC"\n",
+			DP_RC(rc));
+		info->bsi_rc = rc;
+		return rc;
+	}
+	info->bsi_polling = true;
+
+	return 0;
+}
+
+/*
+ * Issue segments until the window after the filled prefix is full, only whole
+ * segments of the filled prefix of a streamed remote buffer are pulled, and
+ * its ready length is polled again if the end is not reached. Called with
+ * bsi_lock.
+ */
+static int
+crt_bulk_seg_submit(struct crt_bulk_seg_info *info)
+{
+	struct crt_bulk_desc	seg_desc;
+	size_t			len;
+	int			rc;
+
+	while (info->bsi_next < info->bsi_desc.bd_len &&
+	       info->bsi_next - info->bsi_done <
+	       CRT_BULK_SEG_INFLIGHT_MAX * info->bsi_seg_size) {
+		len = min(info->bsi_seg_size,
+			  info->bsi_desc.bd_len - info->bsi_next);
+		if (info->bsi_next + len > info->bsi_src_ready)
+			break;
+
+		seg_desc = info->bsi_desc;
+		seg_desc.bd_remote_off += info->bsi_next;
+		seg_desc.bd_local_off += info->bsi_next;
+		seg_desc.bd_len = len;
+
+		rc = crt_hg_bulk_transfer(&seg_desc, crt_bulk_seg_cb, info,
+					  NULL, false);
+		if (rc != 0) {
+			D_ERROR("segment at "DF_U64" failed, rc: "DF_RC"\n",
+				info->bsi_next, DP_RC(rc));
+			info->bsi_rc = rc;
+			return rc;
+		}
+		info->bsi_next += len;
+		info->bsi_inflight++;
+	}
+
+	if (info->bsi_src_ready < info->bsi_desc.bd_len && !info->bsi_polling)
+		return crt_bulk_seg_poll(info);
+
+	return 0;
+}
+
+/* Account the segment at \a off, called with bsi_lock */
+static void
+crt_bulk_seg_done(struct crt_bulk_seg_info *info, size_t off)
+{
+	info->bsi_done_mask |= 1U << ((off - info->bsi_done) /
+				      info->bsi_seg_size);
+	while (info->bsi_done_mask & 1) {
+		info->bsi_done += min(info->bsi_seg_size,
+				      info->bsi_desc.bd_len - info->bsi_done);
+		info->bsi_done_mask >>= 1;
+	}
+
+	/* the segments are complete in memory before they are published */
+	if (info->bsi_trailer != NULL)
+		atomic_store_release(&info->bsi_trailer->bst_ready,
+				     info->bsi_done);
+}
+
+static int
+crt_bulk_seg_complete(struct crt_bulk_seg_info *info)
+{
+	struct crt_bulk_cb_info	done_info;
+	int			rc = 0;
+
+	done_info.bci_bulk_desc = &info->bsi_desc;
+	done_info.bci_arg = info->bsi_arg;
+	done_info.bci_rc = info->bsi_rc;
+	if (info->bsi_cb != NULL)
+		rc = info->bsi_cb(&done_info);
+
+	D_MUTEX_DESTROY(&info->bsi_lock);
+	D_FREE(info);
+	return rc;
+}
+
+/* Stop issuing on the first error and tell the readers, called with bsi_lock */
+static void
+crt_bulk_seg_fail(struct crt_bulk_seg_info *info, int rc)
+{
+	if (info->bsi_rc == 0)
+		info->bsi_rc = rc;
+	if (info->bsi_trailer != NULL)
+		atomic_store_release(&info->bsi_trailer->bst_ready,
+				     CRT_BULK_STREAM_FAILED);
+}
+
+static int
+crt_bulk_seg_cb(const struct crt_bulk_cb_info *cb_info)
+{
+	struct crt_bulk_seg_info	*info = cb_info->bci_arg;
+	bool				 done;
+
+	D_MUTEX_LOCK(&info->bsi_lock);
+	D_ASSERT(info->bsi_inflight > 0);
+	info->bsi_inflight--;
+	if (cb_info->bci_rc != 0)
+		crt_bulk_seg_fail(info, cb_info->bci_rc);
+	/* keep the pipeline full, stop issuing new segments on error */
+	if (info->bsi_rc == 0) {
+		crt_bulk_seg_done(info, cb_info->bci_bulk_desc->bd_local_off -
+					info->bsi_desc.bd_local_off);
+		if (crt_bulk_seg_submit(info) != 0)
+			crt_bulk_seg_fail(info, info->bsi_rc);
+	}
+	done = (info->bsi_inflight == 0 && !info->bsi_polling);
+	D_MUTEX_UNLOCK(&info->bsi_lock);
+
+	if (!done)
+		return 0;
+
+	return crt_bulk_seg_complete(info);
+}
+
+static int
+crt_bulk_poll_cb(const struct crt_bulk_cb_info *cb_info)
+{
+	struct crt_bulk_seg_info	*info = cb_info->bci_arg;
+	uint64_t			 ready;
+	bool				 done;
+
+	D_MUTEX_LOCK(&info->bsi_lock);
+	D_ASSERT(info->bsi_polling);
+	info->bsi_polling = false;
+	ready = info->bsi_trailer->bst_poll;
+	if (cb_info->bci_rc != 0) {
+		crt_bulk_seg_fail(info, cb_info->bci_rc);
+	} else if (ready == CRT_BULK_STREAM_FAILED) {
+		D_ERROR("source of the bulk failed to be filled.\n");
+		crt_bulk_seg_fail(info, -DER_IO);
+	} else if (ready > info->bsi_src_ready) {
+		info->bsi_src_ready = min(ready, info->bsi_desc.bd_len);
+	}
+	if (info->bsi_rc == 0 && crt_bulk_seg_submit(info) != 0)
+		crt_bulk_seg_fail(info, info->bsi_rc);
+	done = (info->bsi_inflight == 0 && !info->bsi_polling);
+	D_MUTEX_UNLOCK(&info->bsi_lock);
+
+	if (!done)
+		return 0;
+
+	return crt_bulk_seg_complete(info);
+}
+
+/**
+ * Bulk transfer used by CaRT internal data propagation (chained bulk of corpc,
+ * IV values). Large payloads are split into crt_gdata.cg_bulk_seg_size sized
+ * segments which are kept concurrently inflight, so that the transfer is not
+ * serialized on one single bulk operation. \a complete_cb is called once with
+ * the original descriptor after all segments completed.
+ */
+int
+crt_bulk_seg_transfer(struct crt_bulk_desc *bulk_desc,
+		      crt_bulk_cb_t complete_cb, void *arg)
+{
+	size_t	seg_size = crt_gdata.cg_bulk_seg_size;
+
+	if (seg_size == 0 || bulk_desc == NULL || bulk_desc->bd_len <= seg_size)
+		return crt_bulk_transfer(bulk_desc, complete_cb, arg, NULL);
+
+	return crt_bulk_stream_transfer(bulk_desc, false, NULL, complete_cb,
+					arg);
+}
+
+/**
+ * Segmented bulk transfer (see crt_bulk_seg_transfer) between buffers which
+ * can be forwarded down a tree before they are filled, so that a rank pulls
+ * segment k from its parent while the parent still pulls segment k + 1.
+ *
+ * A streamed buffer is followed by a struct crt_bulk_stream_trailer, both
+ * covered by its bulk handle, \a bulk_desc only describes the payload.
+ *
+ * \param[in] bulk_desc		descriptor of the payload
+ * \param[in] src_stream	the remote buffer is streamed, only its filled
+ *				prefix is pulled, its ready length is polled
+ * \param[in] trailer		trailer of the local buffer to publish its
+ *				filled prefix to the readers, NULL if the local
+ *				buffer is not streamed
+ * \param[in] complete_cb	called once after the whole payload landed
+ * \param[in] arg		argument of \a complete_cb
+ */
+int
+crt_bulk_stream_transfer(struct crt_bulk_desc *bulk_desc, bool src_stream,
+			 struct crt_bulk_stream_trailer *trailer,
+			 crt_bulk_cb_t complete_cb, void *arg)
+{
+	struct crt_bulk_seg_info	*info;
+	size_t				 seg_size;
+	int				 rc;
+
+	if (!crt_bulk_desc_valid(bulk_desc) || (src_stream && trailer == NULL)) {
+		D_ERROR("invalid parameter of bulk_desc.\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	seg_size = crt_gdata.cg_bulk_seg_size;
+	if (seg_size == 0 || seg_size > bulk_desc->bd_len)
+		seg_size = bulk_desc->bd_len;
+
+	D_ALLOC_PTR(info);
+	if (info == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	rc = D_MUTEX_INIT(&info->bsi_lock, NULL);
+	if (rc != 0) {
+		D_FREE(info);
+		D_GOTO(out, rc);
+	}
+	info->bsi_desc = *bulk_desc;
+	info->bsi_cb = complete_cb;
+	info->bsi_arg = arg;
+	info->bsi_trailer = trailer;
+	info->bsi_seg_size = seg_size;
+	info->bsi_src_ready = src_stream ? 0 : bulk_desc->bd_len;
+
+	D_DEBUG(DB_NET, "bulk of %zu bytes in %zu bytes segments%s.\n",
+		bulk_desc->bd_len, seg_size,
+		src_stream ? " from a streamed buffer" : "");
+
+	D_MUTEX_LOCK(&info->bsi_lock);
+	rc = crt_bulk_seg_submit(info);
+	if (rc != 0 && info->bsi_inflight == 0 && !info->bsi_polling) {
+		/* nothing issued, fail synchronously like crt_bulk_transfer */
+		D_MUTEX_UNLOCK(&info->bsi_lock);
+		D_MUTEX_DESTROY(&info->bsi_lock);
+		D_FREE(info);
+		D_GOTO(out, rc);
+	}
+	if (rc != 0)
+		crt_bulk_seg_fail(info, rc);
+	D_MUTEX_UNLOCK(&info->bsi_lock);
+
+	/* error of a partially issued transfer is reported by complete_cb */
+	return 0;
+
+out:
+	if (trailer != NULL)
+		atomic_store_release(&trailer->bst_ready,
+				     CRT_BULK_STREAM_FAILED);
+	return rc;
+}
+
 int
 crt_bulk_get_len(crt_bulk_t bulk_hdl, size_t *bulk_len)
 {
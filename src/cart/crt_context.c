@@ -12,6 +12,15 @@
 
 static void crt_epi_destroy(struct crt_ep_inflight *epi);
 
+/* Queue time histogram: 16us, 64us, 256us ... ~1s buckets */
+#define CRT_QUEUE_TIME_BUCKETS	10
+#define CRT_QUEUE_TIME_WIDTH	16
+
+static const char *crt_rpc_prio_str[CRT_RPC_PRIO_MAX] = {
+	[CRT_RPC_PRIO_NORMAL]	= "normal",
+	[CRT_RPC_PRIO_HIGH]	= "high",
+};
+
 static struct crt_ep_inflight *
 epi_link2ptr(d_list_t *rlink)
 {
@@ -244,6 +253,7 @@ crt_context_provider_create(crt_context_t *crt_ctx, int provider)
 	/** initialize sensors */
 	if (crt_gdata.cg_use_sensors) {
 		int	ret;
+		int	i;
 		char	*prov;
 
 		prov = crt_provider_name_get(ctx->cc_hg_ctx.chc_provider);
@@ -272,6 +282,26 @@ crt_context_provider_create(crt_context_t *crt_ctx, int provider)
 		if (ret)
 			D_WARN("Failed to create failed addr counter: "DF_RC
 			       "\n", DP_RC(ret));
+
+		for (i = 0; i < CRT_RPC_PRIO_MAX; i++) {
+			struct d_tm_node_t	*node;
+			char			 path[D_TM_MAX_NAME_LEN];
+
+			snprintf(path, sizeof(path), "net/%s/queue_time/%s/ctx_%u",
+				 prov, crt_rpc_prio_str[i], ctx->cc_idx);
+			ret = d_tm_add_metric(&node, D_TM_STATS_GAUGE,
+					      "Queue time of RPC requests before"
+					      " dispatch", D_TM_MICROSECOND, path);
+			if (ret == 0)
+				ret = d_tm_init_histogram(node, path,
+							  CRT_QUEUE_TIME_BUCKETS,
+							  CRT_QUEUE_TIME_WIDTH, 4);
+			if (ret)
+				D_WARN("Failed to create queue time histogram: "
+				       DF_RC"\n", DP_RC(ret));
+			else
+				ctx->cc_queue_time[i] = node;
+		}
 	}
 
 	if (crt_is_service() &&
@@ -1245,6 +1275,25 @@ out:
 	return rc;
 }
 
+int
+crt_context_progress_cnt(crt_context_t crt_ctx, uint64_t *cnt)
+{
+	struct crt_context	*ctx;
+	int			rc = 0;
+
+	if (crt_ctx == CRT_CONTEXT_NULL || cnt == NULL) {
+		D_ERROR("invalid parameter, crt_ctx: %p, cnt: %p.\n",
+			crt_ctx, cnt);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	ctx = crt_ctx;
+	*cnt = ctx->cc_hg_ctx.chc_trigger_cnt;
+
+out:
+	return rc;
+}
+
 int
 crt_self_uri_get(int tag, char **uri)
 {
@@ -89,7 +89,7 @@ crt_corpc_info_fini(struct crt_rpc_priv *rpc_priv)
 }
 
 static int
-crt_corpc_initiate(struct crt_rpc_priv *rpc_priv)
+crt_corpc_initiate(struct crt_rpc_priv *rpc_priv, bool bulk_stream)
 {
 	struct crt_grp_gdata	*grp_gdata;
 	struct crt_grp_priv	*grp_priv;
@@ -137,6 +137,7 @@ crt_corpc_initiate(struct crt_rpc_priv *rpc_priv)
 			  DP_RC(rc));
 		D_GOTO(out, rc);
 	}
+	rpc_priv->crp_corpc_info->co_bulk_stream = bulk_stream;
 
 	rc = crt_corpc_req_hdlr(rpc_priv);
 	if (rc != 0)
@@ -147,11 +148,41 @@ out:
 	return rc;
 }
 
+static void crt_corpc_local_hdlr(struct crt_rpc_priv *rpc_priv, int rc);
+
+/* Let the local RPC handler see the payload of a streamed buffer only */
+static int
+crt_corpc_bulk_payload(struct crt_rpc_priv *rpc_priv, void *bulk_buf,
+		       size_t bulk_len)
+{
+	d_sg_list_t	bulk_sgl;
+	d_iov_t		bulk_iov;
+	crt_bulk_t	bulk_hdl;
+	int		rc;
+
+	d_iov_set(&bulk_iov, bulk_buf, bulk_len);
+	bulk_sgl.sg_nr = 1;
+	bulk_sgl.sg_iovs = &bulk_iov;
+
+	rc = crt_bulk_create(rpc_priv->crp_pub.cr_ctx, &bulk_sgl, CRT_BULK_RW,
+			     &bulk_hdl);
+	if (rc != 0) {
+		RPC_ERROR(rpc_priv, "crt_bulk_create failed: "DF_RC"\n",
+			  DP_RC(rc));
+		return rc;
+	}
+
+	/* the streamed handle in coh_bulk_hdl is freed by crt_corpc_complete */
+	rpc_priv->crp_pub.cr_co_bulk_hdl = bulk_hdl;
+	return 0;
+}
+
 static int
 crt_corpc_chained_bulk_cb(const struct crt_bulk_cb_info *cb_info)
 {
 	crt_rpc_t			*rpc_req;
 	struct crt_rpc_priv		*rpc_priv;
+	struct crt_corpc_info		*co_info;
 	struct crt_corpc_hdr		*co_hdr;
 	struct crt_bulk_desc		*bulk_desc;
 	crt_bulk_t			 local_bulk_hdl;
@@ -172,6 +203,23 @@ crt_corpc_chained_bulk_cb(const struct crt_bulk_cb_info *cb_info)
 	remote_bulk_hdl = bulk_desc->bd_remote_hdl;
 	D_ASSERT(local_bulk_hdl != NULL);
 
+	/*
+	 * The streamed RPC was forwarded before the bulk landed, co_hdr already
+	 * holds the local bulk handle, only the local handler is left.
+	 */
+	co_info = rpc_priv->crp_corpc_info;
+	if (co_info != NULL && co_info->co_bulk_stream) {
+		crt_bulk_free(remote_bulk_hdl);
+		if (rc == 0)
+			rc = crt_corpc_bulk_payload(rpc_priv, bulk_buf,
+						    bulk_desc->bd_len);
+		else
+			RPC_ERROR(rpc_priv, "streamed chained bulk failed: "
+				  DF_RC"\n", DP_RC(rc));
+		crt_corpc_local_hdlr(rpc_priv, rc);
+		D_GOTO(out, rc = 0);
+	}
+
 	/* chained bulk done, free remote_bulk_hdl, reset co_hdr->coh_bulk_hdl as NULL as
 	 * crt_corpc_initiate() will reuse it as chained bulk handle for child RPC.
 	 */
@@ -187,7 +235,7 @@ crt_corpc_chained_bulk_cb(const struct crt_bulk_cb_info *cb_info)
 	}
 
 	rpc_priv->crp_pub.cr_co_bulk_hdl = local_bulk_hdl;
-	rc = crt_corpc_initiate(rpc_priv);
+	rc = crt_corpc_initiate(rpc_priv, false);
 	if (rc != 0) {
 		RPC_ERROR(rpc_priv, "crt_corpc_initiate failed: "DF_RC"\n",
 			  DP_RC(rc));
@@ -249,17 +297,40 @@ out:
 	return rc;
 }
 
+/*
+ * Whether to forward the RPC before its chained bulk of \a bulk_len bytes lands,
+ * so that the children pull the segments as they arrive here instead of after
+ * the whole payload, which makes the propagation time grow with the depth of
+ * the tree plus the size rather than with their product.
+ */
+static inline bool
+crt_corpc_bulk_stream(struct crt_rpc_priv *rpc_priv, size_t bulk_len)
+{
+	struct crt_corpc_ops	*co_ops = rpc_priv->crp_opc_info->coi_co_ops;
+	uint32_t		 seg_size = crt_gdata.cg_bulk_seg_size;
+
+	/* the parent streams its buffer, keep streaming it down the tree */
+	if (rpc_priv->crp_coreq_hdr.coh_bulk_stream)
+		return true;
+
+	/* the pre-forward callback may need the whole payload */
+	return seg_size != 0 && bulk_len > seg_size &&
+	       (co_ops == NULL || co_ops->co_pre_forward == NULL);
+}
+
 /* only be called in crt_rpc_handler_common after RPC header unpacked */
 int
 crt_corpc_common_hdlr(struct crt_rpc_priv *rpc_priv)
 {
-	struct crt_corpc_hdr	*co_hdr;
-	crt_bulk_t		 parent_bulk_hdl, local_bulk_hdl;
-	d_sg_list_t		 bulk_sgl;
-	d_iov_t			 bulk_iov;
-	size_t			 bulk_len;
-	struct crt_bulk_desc	 bulk_desc;
-	int			 rc = 0;
+	struct crt_bulk_stream_trailer	*trailer = NULL;
+	struct crt_corpc_hdr		*co_hdr;
+	crt_bulk_t			 parent_bulk_hdl, local_bulk_hdl;
+	d_sg_list_t			 bulk_sgl;
+	d_iov_t				 bulk_iov;
+	size_t				 bulk_len;
+	struct crt_bulk_desc		 bulk_desc;
+	bool				 stream;
+	int				 rc = 0;
 
 	D_ASSERT(rpc_priv != NULL && (rpc_priv->crp_flags & CRT_RPC_FLAG_COLL));
 
@@ -272,7 +343,10 @@ crt_corpc_common_hdlr(struct crt_rpc_priv *rpc_priv)
 		D_GOTO(out, rc = -DER_NO_PERM);
 	}
 
-	/* handle possible chained bulk first and then initiate the corpc */
+	/*
+	 * handle possible chained bulk first and then initiate the corpc, or
+	 * initiate it first for a streamed bulk
+	 */
 	co_hdr = &rpc_priv->crp_coreq_hdr;
 	parent_bulk_hdl = co_hdr->coh_bulk_hdl;
 	if (parent_bulk_hdl != CRT_BULK_NULL) {
@@ -283,10 +357,23 @@ crt_corpc_common_hdlr(struct crt_rpc_priv *rpc_priv)
 			D_GOTO(out, rc);
 		}
 
-		D_ALLOC(bulk_iov.iov_buf, bulk_len);
+		/* the ready length of a streamed buffer trails its payload */
+		if (co_hdr->coh_bulk_stream) {
+			if (bulk_len <= sizeof(*trailer)) {
+				RPC_ERROR(rpc_priv, "bad streamed bulk length "
+					  "%zu\n", bulk_len);
+				D_GOTO(out, rc = -DER_PROTO);
+			}
+			bulk_len -= sizeof(*trailer);
+		}
+		stream = crt_corpc_bulk_stream(rpc_priv, bulk_len);
+
+		D_ALLOC(bulk_iov.iov_buf,
+			bulk_len + (stream ? sizeof(*trailer) : 0));
 		if (bulk_iov.iov_buf == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
-		bulk_iov.iov_buf_len = bulk_len;
+		bulk_iov.iov_buf_len = bulk_len +
+				       (stream ? sizeof(*trailer) : 0);
 		bulk_sgl.sg_nr = 1;
 		bulk_sgl.sg_iovs = &bulk_iov;
 
@@ -307,20 +394,56 @@ crt_corpc_common_hdlr(struct crt_rpc_priv *rpc_priv)
 		bulk_desc.bd_local_off = 0;
 		bulk_desc.bd_len = bulk_len;
 
+		if (stream) {
+			trailer = bulk_iov.iov_buf + bulk_len;
+
+			/*
+			 * Forward to the children with the local buffer, they
+			 * pull its segments as they land, and the local handler
+			 * runs in crt_corpc_chained_bulk_cb.
+			 */
+			co_hdr->coh_bulk_hdl = CRT_BULK_NULL;
+			rpc_priv->crp_pub.cr_co_bulk_hdl = local_bulk_hdl;
+			rc = crt_corpc_initiate(rpc_priv, true);
+			if (rc != 0) {
+				RPC_ERROR(rpc_priv, "crt_corpc_initiate failed: "
+					  DF_RC"\n", DP_RC(rc));
+				rpc_priv->crp_pub.cr_co_bulk_hdl = CRT_BULK_NULL;
+				co_hdr->coh_bulk_hdl = parent_bulk_hdl;
+				crt_bulk_free(local_bulk_hdl);
+				D_FREE(bulk_iov.iov_buf);
+				D_GOTO(out, rc);
+			}
+		}
+
 		RPC_ADDREF(rpc_priv);
 
-		rc = crt_bulk_transfer(&bulk_desc, crt_corpc_chained_bulk_cb,
-				       bulk_iov.iov_buf, NULL);
+		if (stream)
+			rc = crt_bulk_stream_transfer(&bulk_desc,
+						      co_hdr->coh_bulk_stream,
+						      trailer,
+						      crt_corpc_chained_bulk_cb,
+						      bulk_iov.iov_buf);
+		else
+			rc = crt_bulk_seg_transfer(&bulk_desc,
+						   crt_corpc_chained_bulk_cb,
+						   bulk_iov.iov_buf);
 		if (rc != 0) {
-			RPC_ERROR(rpc_priv, "crt_bulk_transfer failed: "
+			RPC_ERROR(rpc_priv, "chained bulk transfer failed: "
 				  DF_RC"\n", DP_RC(rc));
-			D_FREE(bulk_iov.iov_buf);
 			RPC_DECREF(rpc_priv);
+			if (stream) {
+				/* the corpc owns the local buffer already */
+				crt_bulk_free(parent_bulk_hdl);
+				crt_corpc_local_hdlr(rpc_priv, rc);
+				D_GOTO(out, rc = 0);
+			}
+			D_FREE(bulk_iov.iov_buf);
 		}
 		D_GOTO(out, rc);
 	} else {
 		rpc_priv->crp_pub.cr_co_bulk_hdl = CRT_BULK_NULL;
-		rc = crt_corpc_initiate(rpc_priv);
+		rc = crt_corpc_initiate(rpc_priv, false);
 		if (rc != 0)
 			RPC_ERROR(rpc_priv, "crt_corpc_initiate failed: "
 				  DF_RC"\n", DP_RC(rc));
@@ -491,9 +614,9 @@ corpc_add_child_rpc(struct crt_rpc_priv *parent_rpc_priv,
 	child_co_hdr->coh_grp_ver = parent_co_hdr->coh_grp_ver;
 	child_co_hdr->coh_tree_topo = parent_co_hdr->coh_tree_topo;
 	child_co_hdr->coh_root = parent_co_hdr->coh_root;
-	child_co_hdr->coh_padding = parent_co_hdr->coh_padding;
 
 	co_info = parent_rpc_priv->crp_corpc_info;
+	child_co_hdr->coh_bulk_stream = co_info->co_bulk_stream;
 
 	RPC_ADDREF(child_rpc_priv);
 
@@ -554,8 +677,13 @@ crt_corpc_complete(struct crt_rpc_priv *rpc_priv)
 				  DF_RC"\n", DP_RC(rc));
 		/*
 		 * on root node, don't need to free chained bulk handle as it is
-		 * created and passed in by user.
+		 * created and passed in by user. The local handler of a streamed
+		 * bulk got a separate handle of the payload.
 		 */
+		if (rpc_priv->crp_pub.cr_co_bulk_hdl !=
+		    rpc_priv->crp_coreq_hdr.coh_bulk_hdl)
+			crt_bulk_free(rpc_priv->crp_pub.cr_co_bulk_hdl);
+		rpc_priv->crp_pub.cr_co_bulk_hdl = CRT_BULK_NULL;
 		rc = crt_corpc_free_chained_bulk(
 			rpc_priv->crp_coreq_hdr.coh_bulk_hdl);
 		if (rc != 0)
@@ -764,6 +892,36 @@ aggregate_done:
 	}
 }
 
+/*
+ * Invoke RPC handler on local node, \a rc is the error which happened before
+ * the handler can be invoked, for example the failure of the chained bulk.
+ */
+static void
+crt_corpc_local_hdlr(struct crt_rpc_priv *rpc_priv, int rc)
+{
+	struct crt_corpc_info	*co_info = rpc_priv->crp_corpc_info;
+
+	if (rc == 0)
+		rc = crt_rpc_common_hdlr(rpc_priv);
+	if (rc == 0)
+		return;
+
+	RPC_ERROR(rpc_priv, "crt_rpc_common_hdlr failed: "DF_RC"\n",
+		  DP_RC(rc));
+	crt_corpc_fail_child_rpc(rpc_priv, 1, rc);
+
+	D_SPIN_LOCK(&rpc_priv->crp_lock);
+	co_info->co_local_done = 1;
+	rpc_priv->crp_reply_pending = 0;
+	D_SPIN_UNLOCK(&rpc_priv->crp_lock);
+
+	/* Handle ref count difference between call on root vs
+	 * call on intermediate nodes
+	 */
+	if (co_info->co_root != co_info->co_grp_priv->gp_self)
+		RPC_DECREF(rpc_priv);
+}
+
 int
 crt_corpc_req_hdlr(struct crt_rpc_priv *rpc_priv)
 {
@@ -913,26 +1071,12 @@ forward_done:
 		D_GOTO(out, rc);
 	}
 
-	/* invoke RPC handler on local node */
-	rc = crt_rpc_common_hdlr(rpc_priv);
-	if (rc != 0) {
-		RPC_ERROR(rpc_priv, "crt_rpc_common_hdlr failed: "DF_RC"\n",
-			  DP_RC(rc));
-		crt_corpc_fail_child_rpc(rpc_priv, 1, rc);
-
-		D_SPIN_LOCK(&rpc_priv->crp_lock);
-		co_info->co_local_done = 1;
-		rpc_priv->crp_reply_pending = 0;
-		D_SPIN_UNLOCK(&rpc_priv->crp_lock);
+	/* the chained bulk callback invokes the handler once the bulk landed */
+	if (co_info->co_bulk_stream)
+		D_GOTO(out, rc = 0);
 
-		/* Handle ref count difference between call on root vs
-		 * call on intermediate nodes
-		 */
-		if (co_info->co_root != co_info->co_grp_priv->gp_self)
-			RPC_DECREF(rpc_priv);
-
-		rc = 0;
-	}
+	crt_corpc_local_hdlr(rpc_priv, 0);
+	rc = 0;
 
 out:
 	if (children_rank_list != NULL)
@@ -1415,6 +1415,7 @@ crt_hg_progress(struct crt_hg_context *hg_ctx, int64_t timeout)
 			return -DER_HG;
 		}
 
+		hg_ctx->chc_trigger_cnt += count;
 		if (count == 0 || rc)
 			/** nothing to trigger */
 			return rc;
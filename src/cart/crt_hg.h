@@ -120,6 +120,7 @@ struct crt_hg_context {
 	hg_context_t		*chc_bulkctx; /* bulk context */
 	struct crt_hg_pool	 chc_hg_pool; /* HG handle pool */
 	int			 chc_provider; /* provider */
+	uint64_t		 chc_trigger_cnt; /* triggered callbacks */
 };
 
 /* crt_hg.c */
@@ -270,12 +270,12 @@ crt_proc_corpc_hdr(crt_proc_t proc, struct crt_corpc_hdr *hdr)
 		buf[0] = hdr->coh_grp_ver;
 		buf[1] = hdr->coh_tree_topo;
 		buf[2] = hdr->coh_root;
-		buf[3] = hdr->coh_padding;
+		buf[3] = hdr->coh_bulk_stream;
 	} else { /* DECODING(proc_op) */
 		hdr->coh_grp_ver   = buf[0];
 		hdr->coh_tree_topo = buf[1];
 		hdr->coh_root      = buf[2];
-		hdr->coh_padding   = buf[3];
+		hdr->coh_bulk_stream = buf[3];
 	}
 
 out:
@@ -625,11 +625,17 @@ crt_proc_out_common(crt_proc_t proc, crt_rpc_output_t *data)
 
 			if (crt_is_service()) {
 				uint64_t clock_offset;
+				uint64_t hlc = 0;
 
-				rc = crt_hlc_get_msg(hdr->cch_hlc,
-						     NULL /* hlc_out */,
+				rc = crt_hlc_get_msg(hdr->cch_hlc, &hlc,
 						     &clock_offset);
-				if (rc != 0) {
+				if (rc == 0) {
+					/* Track the offset to the peer. */
+					crt_hlc_peer_sample(
+						rpc_priv->crp_req_hdr.cch_dst_rank,
+						rpc_priv->crp_req_hdr.cch_hlc,
+						hdr->cch_hlc, hlc);
+				} else {
 					REPORT_HLC_SYNC_ERR("failed to sync "
 							    "HLC for reply: "
 							    "opc=%x ts="DF_U64
@@ -31,6 +31,49 @@ static ATOMIC uint64_t crt_hlc;
 /** See crt_hlc_epsilon_set's API doc */
 static uint64_t crt_hlc_epsilon = 1ULL * NSEC_PER_SEC * CRT_HLC_NSEC;
 
+/** Ranks whose HLC offsets are tracked, higher ranks are never sampled. */
+#define CRT_HLC_PEER_MAX 1024
+
+/**
+ * A peer HLC offset sample expires after 10 seconds, or after two SWIM
+ * rounds over the primary group if longer (see crt_hlc_peer_age).
+ */
+#define CRT_HLC_PEER_AGE (10ULL * NSEC_PER_SEC * CRT_HLC_NSEC)
+
+/** The uncertainty window is recomputed at most once per second. */
+#define CRT_HLC_WINDOW_INTVL (1ULL * NSEC_PER_SEC * CRT_HLC_NSEC)
+
+/**
+ * Clock drift allowance since a sample is taken, 1/CRT_HLC_DRIFT of the
+ * sample age (i.e., 100 ppm).
+ */
+#define CRT_HLC_DRIFT 10000ULL
+
+/**
+ * HLC offsets between the local HLC and a peer's, measured by a request
+ * sent to the peer and its reply. The peer stamped the reply between the
+ * local HLC readings when sending the request and receiving the reply, so:
+ *
+ *   peer - local <= reply - request	(hp_ahead)
+ *   local - peer <= received - reply	(hp_behind)
+ *
+ * Both include the round trip time, so are always safe upper bounds.
+ */
+struct crt_hlc_peer {
+	/** Odd while a sample is being stored, see crt_hlc_peer_load */
+	ATOMIC uint32_t	hp_seq;
+	ATOMIC uint64_t	hp_ahead;
+	ATOMIC uint64_t	hp_behind;
+	/** Local HLC when the sample is taken, zero if never sampled */
+	ATOMIC uint64_t	hp_stamp;
+};
+
+static struct crt_hlc_peer crt_hlc_peers[CRT_HLC_PEER_MAX];
+
+/** See crt_hlc_uncertainty_get's API doc, zero if not computed yet */
+static ATOMIC uint64_t crt_hlc_window;
+static ATOMIC uint64_t crt_hlc_window_stamp;
+
 /** Get local physical time */
 static inline uint64_t crt_hlc_localtime_get(void)
 {
@@ -135,9 +178,150 @@ uint64_t crt_unixnsec2hlc(uint64_t unixnsec)
 	return (unixnsec - start) * CRT_HLC_NSEC;
 }
 
+void crt_hlc_peer_sample(d_rank_t rank, uint64_t request, uint64_t reply,
+			 uint64_t received)
+{
+	struct crt_hlc_peer	*peer;
+	uint32_t		 seq;
+
+	if (rank >= CRT_HLC_PEER_MAX)
+		return;
+
+	peer = &crt_hlc_peers[rank];
+	seq = peer->hp_seq;
+	/* Another reply from the same peer is being stored, drop this one. */
+	if ((seq & 1) || !atomic_compare_exchange(&peer->hp_seq, seq, seq + 1))
+		return;
+
+	peer->hp_ahead = reply > request ? reply - request : 0;
+	peer->hp_behind = received > reply ? received - reply : 0;
+	peer->hp_stamp = received;
+	atomic_store_release(&peer->hp_seq, seq + 2);
+}
+
+/** Read a consistent sample of \a peer, retrying a concurrent store. */
+static void crt_hlc_peer_load(struct crt_hlc_peer *peer, uint64_t *ahead,
+			      uint64_t *behind, uint64_t *stamp)
+{
+	uint32_t seq;
+
+	do {
+		seq = peer->hp_seq;
+		if (seq & 1)
+			continue;
+		*ahead = peer->hp_ahead;
+		*behind = peer->hp_behind;
+		*stamp = peer->hp_stamp;
+	} while ((seq & 1) || seq != peer->hp_seq);
+}
+
+/**
+ * SWIM pings the members one per protocol period, so a peer exchanging no
+ * other RPC with us is sampled about once every \a nr periods. Allow two
+ * such rounds before a sample is considered stale.
+ */
+static uint64_t crt_hlc_peer_age(uint32_t nr)
+{
+	uint64_t age;
+
+	age = 2ULL * nr * swim_period_get() * NSEC_PER_MSEC * CRT_HLC_NSEC;
+	return max(age, CRT_HLC_PEER_AGE);
+}
+
+/**
+ * Any two engines' HLCs are within the max tracked offsets between the local
+ * HLC and the others': writer - chooser <= (writer - local) + (local - chooser).
+ * Each offset grows by the clock drift allowance since its sample is taken.
+ * If any member of \a membs other than \a self has no sample younger than
+ * \a age, fall back to the (pessimistic) maximum system clock offset.
+ */
+uint64_t crt_hlc_window_calc(d_rank_list_t *membs, d_rank_t self, uint64_t now,
+			     uint64_t age)
+{
+	uint64_t	ahead = 0;
+	uint64_t	behind = 0;
+	uint64_t	p_ahead;
+	uint64_t	p_behind;
+	uint64_t	stamp;
+	uint64_t	drift;
+	d_rank_t	rank;
+	int		i;
+
+	if (membs == NULL || membs->rl_nr == 0)
+		return crt_hlc_epsilon;
+
+	for (i = 0; i < membs->rl_nr; i++) {
+		rank = membs->rl_ranks[i];
+		if (rank == self)
+			continue;
+
+		if (rank >= CRT_HLC_PEER_MAX)
+			return crt_hlc_epsilon;
+
+		crt_hlc_peer_load(&crt_hlc_peers[rank], &p_ahead, &p_behind,
+				  &stamp);
+		if (stamp == 0 || stamp + age < now)
+			return crt_hlc_epsilon;
+
+		drift = (now > stamp ? now - stamp : 0) / CRT_HLC_DRIFT;
+		ahead = max(ahead, p_ahead + drift);
+		behind = max(behind, p_behind + drift);
+	}
+
+	return min(crt_hlc_epsilon,
+		   (ahead + behind + CRT_HLC_MASK) & ~CRT_HLC_MASK);
+}
+
+static uint64_t crt_hlc_window_compute(uint64_t now)
+{
+	struct crt_grp_priv	*grp_priv;
+	d_rank_list_t		*membs;
+	uint64_t		 window;
+
+	if (!crt_initialized() || !crt_is_service())
+		return crt_hlc_epsilon;
+
+	grp_priv = crt_gdata.cg_grp->gg_primary_grp;
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	membs = grp_priv->gp_membs.cgm_list;
+	window = crt_hlc_window_calc(membs, grp_priv->gp_self, now,
+				     crt_hlc_peer_age(membs == NULL ?
+						      0 : membs->rl_nr));
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+
+	return window;
+}
+
+uint64_t crt_hlc_uncertainty_get(void)
+{
+	uint64_t now = crt_hlc_get();
+	uint64_t window = crt_hlc_window;
+	uint64_t stamp = crt_hlc_window_stamp;
+
+	if (window != 0 && stamp + CRT_HLC_WINDOW_INTVL > now)
+		return window;
+
+	window = crt_hlc_window_compute(now);
+	if (window != crt_hlc_window)
+		D_DEBUG(DB_TRACE, "HLC uncertainty window "DF_U64" -> "DF_U64" ns\n",
+			crt_hlc2nsec(crt_hlc_window), crt_hlc2nsec(window));
+
+	crt_hlc_window = window;
+	crt_hlc_window_stamp = now;
+
+	return window;
+}
+
+uint64_t crt_hlc_uncertainty_get_bound(uint64_t hlc)
+{
+	return (hlc + crt_hlc_uncertainty_get()) | CRT_HLC_MASK;
+}
+
 void crt_hlc_epsilon_set(uint64_t epsilon)
 {
 	crt_hlc_epsilon = (epsilon + CRT_HLC_MASK) & ~CRT_HLC_MASK;
+	/* Recompute the uncertainty window with the new epsilon. */
+	crt_hlc_window = 0;
 	D_INFO("set maximum system clock offset to "DF_U64" ns\n",
 	       crt_hlc_epsilon);
 }
@@ -29,7 +29,8 @@ dump_envariables(void)
 		"OFI_PORT", "OFI_INTERFACE", "OFI_DOMAIN", "CRT_CREDIT_EP_CTX",
 		"CRT_CTX_SHARE_ADDR", "CRT_CTX_NUM", "D_FI_CONFIG",
 		"FI_UNIVERSE_SIZE", "CRT_ENABLE_MEM_PIN",
-		"FI_OFI_RXM_USE_SRX", "D_LOG_FLUSH", "CRT_MRC_ENABLE" };
+		"FI_OFI_RXM_USE_SRX", "D_LOG_FLUSH", "CRT_MRC_ENABLE",
+		"CRT_BULK_SEG_SIZE" };
 
 	D_INFO("-- ENVARS: --\n");
 	for (i = 0; i < ARRAY_SIZE(envars); i++) {
@@ -107,6 +108,7 @@ prov_data_init(struct crt_prov_gdata *prov_data, int provider,
 static int data_init(int server, crt_init_options_t *opt)
 {
 	uint32_t	timeout;
+	uint32_t	seg_size;
 	uint32_t	credits;
 	uint32_t	fi_univ_size = 0;
 	uint32_t	mem_pin_enable = 0;
@@ -203,6 +205,12 @@ static int data_init(int server, crt_init_options_t *opt)
 	crt_gdata.cg_credit_ep_ctx = credits;
 	D_ASSERT(crt_gdata.cg_credit_ep_ctx <= CRT_MAX_CREDITS_PER_EP_CTX);
 
+	seg_size = CRT_DEFAULT_BULK_SEG_SIZE;
+	d_getenv_int("CRT_BULK_SEG_SIZE", &seg_size);
+	crt_gdata.cg_bulk_seg_size = seg_size;
+	D_DEBUG(DB_ALL, "internal bulk segment size %u bytes%s.\n", seg_size,
+		seg_size == 0 ? " (pipelining disabled)" : "");
+
 	/** Enable statistics only for the server side and if requested */
 	if (opt && opt->cio_use_sensors && server) {
 		int	ret;
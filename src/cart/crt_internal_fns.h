@@ -39,6 +39,19 @@ int crt_req_timeout_track(struct crt_rpc_priv *rpc_priv);
 void crt_req_timeout_untrack(struct crt_rpc_priv *rpc_priv);
 void crt_req_force_timeout(struct crt_rpc_priv *rpc_priv);
 
+/** crt_bulk.c */
+int crt_bulk_seg_transfer(struct crt_bulk_desc *bulk_desc,
+			  crt_bulk_cb_t complete_cb, void *arg);
+int crt_bulk_stream_transfer(struct crt_bulk_desc *bulk_desc, bool src_stream,
+			     struct crt_bulk_stream_trailer *trailer,
+			     crt_bulk_cb_t complete_cb, void *arg);
+
+/** crt_hlc.c */
+void crt_hlc_peer_sample(d_rank_t rank, uint64_t request, uint64_t reply,
+			 uint64_t received);
+uint64_t crt_hlc_window_calc(d_rank_list_t *membs, d_rank_t self, uint64_t now,
+			     uint64_t age);
+
 /** crt_hlct.c */
 uint64_t crt_hlct_get(void);
 void crt_hlct_sync(uint64_t msg);
@@ -77,6 +77,9 @@ struct crt_gdata {
 	/** credits limitation for #inflight RPCs per target EP CTX */
 	uint32_t		cg_credit_ep_ctx;
 
+	/** segment size (bytes) of pipelined internal bulk, 0 to disable */
+	uint32_t		cg_bulk_seg_size;
+
 	/** the global opcode map */
 	struct crt_opc_map	*cg_opc_map;
 	/** HG level global data */
@@ -162,6 +165,25 @@ extern struct crt_plugin_gdata		crt_plugin_gdata;
 #define CRT_DEFAULT_CREDITS_PER_EP_CTX	(32)
 #define CRT_MAX_CREDITS_PER_EP_CTX	(256)
 
+/* default segment size and max inflight segments of pipelined bulk */
+#define CRT_DEFAULT_BULK_SEG_SIZE	(1UL << 20)
+#define CRT_BULK_SEG_INFLIGHT_MAX	(8)
+
+/* ready length of a streamed bulk buffer which failed to be filled */
+#define CRT_BULK_STREAM_FAILED		(~0ULL)
+
+/**
+ * Trailer after the payload of a bulk buffer which is forwarded before it is
+ * filled (see crt_bulk_stream_transfer). The readers pull bst_ready of the
+ * buffer they read into bst_poll of their own buffer.
+ */
+struct crt_bulk_stream_trailer {
+	/** length of the filled prefix of the payload */
+	ATOMIC uint64_t		bst_ready;
+	/** landing slot of the ready length of the source buffer */
+	uint64_t		bst_poll;
+};
+
 /* crt_context */
 struct crt_context {
 	d_list_t		 cc_link;	/** link to gdata.cg_ctx_list */
@@ -193,6 +215,11 @@ struct crt_context {
 	struct d_tm_node_t	*cc_timedout_uri;
 	/** Total number of failed address resolution, of type counter */
 	struct d_tm_node_t	*cc_failed_addr;
+	/**
+	 * Time (us) from handing a request to the custom RPC handler until it
+	 * is dispatched, per priority class, of type histogram
+	 */
+	struct d_tm_node_t	*cc_queue_time[CRT_RPC_PRIO_MAX];
 
 	/** Stores self uri for the current context */
 	char			 cc_self_uri[CRT_ADDR_STR_MAX_LEN];
@@ -242,7 +269,8 @@ struct crt_opc_info {
 				 coi_coops_init:1,
 				 coi_no_reply:1, /* flag of one-way RPC */
 				 coi_queue_front:1, /* add to front of queue */
-				 coi_reset_timer:1; /* reset timer on timeout */
+				 coi_reset_timer:1, /* reset timer on timeout */
+				 coi_high_prio:1; /* dispatch ahead of others */
 
 	crt_rpc_cb_t		 coi_rpc_cb;
 	struct crt_corpc_ops	*coi_co_ops;
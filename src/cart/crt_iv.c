@@ -969,7 +969,6 @@ crt_ivf_bulk_transfer(struct crt_ivns_internal *ivns_internal,
 {
 	struct crt_ivf_transfer_cb_info	*cb_info = NULL;
 	struct crt_bulk_desc		 bulk_desc;
-	crt_bulk_opid_t			 opid;
 	crt_bulk_t			 bulk_hdl;
 	struct crt_iv_fetch_out		*output;
 	int				 size;
@@ -1018,8 +1017,8 @@ crt_ivf_bulk_transfer(struct crt_ivns_internal *ivns_internal,
 	cb_info->tci_iv_value = *iv_value;
 	cb_info->tci_user_priv = user_priv;
 
-	rc = crt_bulk_transfer(&bulk_desc, crt_ivf_bulk_transfer_done_cb,
-			       cb_info, &opid);
+	rc = crt_bulk_seg_transfer(&bulk_desc, crt_ivf_bulk_transfer_done_cb,
+				   cb_info);
 cleanup:
 	if (rc != 0) {
 		D_ERROR("Bulk transfer failed; "DF_RC"\n", DP_RC(rc));
@@ -2496,8 +2495,8 @@ int transfer_back_to_child(crt_iv_key_t *key, struct update_cb_info *cb_info,
 	bulk_desc.bd_local_off = 0;
 	bulk_desc.bd_len = size;
 
-	rc = crt_bulk_transfer(&bulk_desc, bulk_update_transfer_back_done,
-			       cb_info, 0);
+	rc = crt_bulk_seg_transfer(&bulk_desc, bulk_update_transfer_back_done,
+				   cb_info);
 	if (rc != 0) {
 		D_ERROR("Failed to transfer data back\n");
 		/* IVNS_DECREF done in the function */
@@ -3188,10 +3187,10 @@ crt_hdlr_iv_update(crt_rpc_t *rpc_req)
 	cb_info->buc_iv_value = iv_value;
 	cb_info->buc_user_priv = user_priv;
 
-	rc = crt_bulk_transfer(&bulk_desc, bulk_update_transfer_done,
-			       cb_info, 0);
+	rc = crt_bulk_seg_transfer(&bulk_desc, bulk_update_transfer_done,
+				   cb_info);
 	if (rc != 0) {
-		D_ERROR("crt_bulk_transfer(): "DF_RC"\n", DP_RC(rc));
+		D_ERROR("crt_bulk_seg_transfer(): "DF_RC"\n", DP_RC(rc));
 		crt_bulk_free(local_bulk_handle);
 		RPC_PUB_DECREF(bulk_desc.bd_rpc);
 		IVNS_DECREF(cb_info->buc_ivns);
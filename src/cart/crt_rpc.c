@@ -1643,6 +1643,18 @@ crt_handle_rpc(void *arg)
 	D_ASSERT(rpc_priv->crp_opc_info != NULL);
 	D_ASSERT(rpc_priv->crp_opc_info->coi_rpc_cb != NULL);
 
+	if (rpc_priv->crp_queue_ts != 0) {
+		struct crt_context	*crt_ctx = rpc_pub->cr_ctx;
+		struct timespec		 now;
+		int			 prio;
+
+		prio = rpc_priv->crp_opc_info->coi_high_prio ?
+		       CRT_RPC_PRIO_HIGH : CRT_RPC_PRIO_NORMAL;
+		d_gettime(&now);
+		d_tm_set_gauge(crt_ctx->cc_queue_time[prio],
+			       d_time2us(now) - rpc_priv->crp_queue_ts);
+	}
+
 	/*
 	 * for user initiated corpc if it delivered to itself, in user's RPC
 	 * handler after sending reply the refcount possibly be dropped at
@@ -1718,6 +1730,12 @@ crt_rpc_common_hdlr(struct crt_rpc_priv *rpc_priv)
 
 	if (crt_rpc_cb_customized(crt_ctx, &rpc_priv->crp_pub) &&
 	    !crt_opc_is_swim(rpc_priv->crp_req_hdr.cch_opc)) {
+		if (crt_gdata.cg_use_sensors) {
+			struct timespec now;
+
+			d_gettime(&now);
+			rpc_priv->crp_queue_ts = d_time2us(now);
+		}
 		rc = crt_ctx->cc_rpc_cb((crt_context_t)crt_ctx,
 					&rpc_priv->crp_pub,
 					crt_handle_rpc,
@@ -1857,6 +1875,30 @@ out:
 	return rc;
 }
 
+int
+crt_req_prio_get(crt_rpc_t *rpc, int *prio)
+{
+	struct crt_rpc_priv	*rpc_priv = NULL;
+	int			rc = 0;
+
+	if (rpc == NULL) {
+		D_ERROR("NULL rpc passed\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	if (prio == NULL) {
+		D_ERROR("NULL prio passed\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	rpc_priv = container_of(rpc, struct crt_rpc_priv, crp_pub);
+	D_ASSERT(rpc_priv->crp_opc_info != NULL);
+	*prio = rpc_priv->crp_opc_info->coi_high_prio ? CRT_RPC_PRIO_HIGH :
+							CRT_RPC_PRIO_NORMAL;
+out:
+	return rc;
+}
+
 int
 crt_register_hlc_error_cb(crt_hlc_error_cb event_handler, void *arg)
 {
@@ -49,7 +49,11 @@ struct crt_corpc_hdr {
 	uint32_t		 coh_tree_topo;
 	/* root rank of the tree, it is the logical rank within the group */
 	uint32_t		 coh_root;
-	uint32_t		 coh_padding;
+	/*
+	 * non-zero if the sender forwards the RPC before coh_bulk_hdl is
+	 * filled, its ready length trails the payload
+	 */
+	uint32_t		 coh_bulk_stream;
 };
 
 /* CaRT layer common header */
@@ -115,7 +119,12 @@ struct crt_corpc_info {
 	/* co_root_excluded is the flag of root in excluded rank list */
 				 co_root_excluded:1,
 	/* flag of if refcount taken for co_grp_priv */
-				 co_grp_ref_taken:1;
+				 co_grp_ref_taken:1,
+	/*
+	 * the RPC is forwarded before the chained bulk lands, the local RPC
+	 * handler is invoked by the chained bulk callback
+	 */
+				 co_bulk_stream:1;
 	int			 co_rc;
 };
 
@@ -133,6 +142,8 @@ struct crt_rpc_priv {
 	uint32_t		crp_timeout_sec;
 	/* time stamp to be timeout, the key of timeout binheap */
 	uint64_t		crp_timeout_ts;
+	/* time stamp (us) of queuing to the custom RPC handler */
+	uint64_t		crp_queue_ts;
 	crt_cb_t		crp_complete_cb;
 	void			*crp_arg; /* argument for crp_complete_cb */
 	struct crt_ep_inflight	*crp_epi; /* point back to inflight ep */
@@ -201,7 +212,7 @@ struct crt_rpc_priv {
  */
 #define CRT_INTERNAL_RPCS_LIST						\
 	X(CRT_OPC_URI_LOOKUP,						\
-		0, &CQF_crt_uri_lookup,					\
+		CRT_RPC_FEAT_HIGH_PRIO, &CQF_crt_uri_lookup,		\
 		crt_hdlr_uri_lookup, NULL)				\
 	X(CRT_OPC_PROTO_QUERY,						\
 		0, &CQF_crt_proto_query,				\
@@ -272,13 +283,13 @@ struct crt_rpc_priv {
 
 #define CRT_IV_RPCS_LIST						\
 	X(CRT_OPC_IV_FETCH,						\
-		0, &CQF_crt_iv_fetch,					\
+		CRT_RPC_FEAT_HIGH_PRIO, &CQF_crt_iv_fetch,		\
 		crt_hdlr_iv_fetch, NULL)				\
 	X(CRT_OPC_IV_UPDATE,						\
-		0, &CQF_crt_iv_update,					\
+		CRT_RPC_FEAT_HIGH_PRIO, &CQF_crt_iv_update,		\
 		crt_hdlr_iv_update, NULL)				\
 	X(CRT_OPC_IV_SYNC,						\
-		0, &CQF_crt_iv_sync,					\
+		CRT_RPC_FEAT_HIGH_PRIO, &CQF_crt_iv_sync,		\
 		crt_hdlr_iv_sync, &crt_iv_sync_co_ops)			\
 
 /* Define for RPC enum population below */
@@ -83,12 +83,12 @@ static void crt_swim_srv_cb(crt_rpc_t *rpc);
 
 static struct crt_proto_rpc_format crt_swim_proto_rpc_fmt[] = {
 	{
-		.prf_flags	= CRT_RPC_FEAT_QUEUE_FRONT,
+		.prf_flags	= CRT_RPC_FEAT_QUEUE_FRONT | CRT_RPC_FEAT_HIGH_PRIO,
 		.prf_req_fmt	= &CQF_crt_rpc_swim,
 		.prf_hdlr	= crt_swim_srv_cb,
 		.prf_co_ops	= NULL,
 	}, {
-		.prf_flags	= CRT_RPC_FEAT_QUEUE_FRONT,
+		.prf_flags	= CRT_RPC_FEAT_QUEUE_FRONT | CRT_RPC_FEAT_HIGH_PRIO,
 		.prf_req_fmt	= &CQF_crt_rpc_swim,
 		.prf_hdlr	= crt_swim_srv_cb,
 		.prf_co_ops	= NULL,
@@ -753,6 +753,74 @@ static void crt_swim_update_last_unpack_hlc(struct crt_swim_membs *csm)
 	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
 }
 
+static void crt_swim_stats_publish(struct crt_swim_membs *csm)
+{
+	struct swim_stats stats;
+
+	if (!crt_gdata.cg_use_sensors)
+		return;
+
+	swim_stats_get(csm->csm_ctx, &stats);
+	d_tm_set_counter(csm->csm_suspicions, stats.ss_suspicions);
+	d_tm_set_counter(csm->csm_confirms, stats.ss_confirms);
+	d_tm_set_counter(csm->csm_refutes, stats.ss_refutes);
+	d_tm_set_counter(csm->csm_false_pos, stats.ss_false_pos);
+	d_tm_set_counter(csm->csm_deaths, stats.ss_deaths);
+	d_tm_set_gauge(csm->csm_lhm, stats.ss_lhm);
+	d_tm_set_gauge(csm->csm_piggyback, stats.ss_piggyback_max);
+}
+
+static void crt_swim_stats_init(struct crt_swim_membs *csm)
+{
+	int rc;
+
+	if (!crt_gdata.cg_use_sensors)
+		return;
+
+	rc = d_tm_add_metric(&csm->csm_suspicions, D_TM_COUNTER,
+			     "Total number of members put under suspicion",
+			     "", "net/swim/suspicions");
+	if (rc)
+		D_WARN("Failed to create suspicions counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_confirms, D_TM_COUNTER,
+			     "Total number of independent suspicion confirmations",
+			     "", "net/swim/confirms");
+	if (rc)
+		D_WARN("Failed to create confirms counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_refutes, D_TM_COUNTER,
+			     "Total number of refuted suspicions of self",
+			     "", "net/swim/refutes");
+	if (rc)
+		D_WARN("Failed to create refutes counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_false_pos, D_TM_COUNTER,
+			     "Total number of suspected members seen alive again",
+			     "", "net/swim/false_positives");
+	if (rc)
+		D_WARN("Failed to create false positives counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_deaths, D_TM_COUNTER,
+			     "Total number of members declared dead",
+			     "", "net/swim/deaths");
+	if (rc)
+		D_WARN("Failed to create deaths counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_lhm, D_TM_GAUGE,
+			     "Local health multiplier of SWIM timeouts",
+			     "", "net/swim/local_health");
+	if (rc)
+		D_WARN("Failed to create local health gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&csm->csm_piggyback, D_TM_GAUGE,
+			     "Max number of piggybacked updates per message",
+			     "entries", "net/swim/piggyback_max");
+	if (rc)
+		D_WARN("Failed to create piggyback gauge: "DF_RC"\n", DP_RC(rc));
+}
+
 static int64_t crt_swim_progress_cb(crt_context_t crt_ctx, int64_t timeout_us, void *arg)
 {
 	struct crt_grp_priv	*grp_priv = crt_gdata.cg_grp->gg_primary_grp;
@@ -779,6 +847,7 @@ static int64_t crt_swim_progress_cb(crt_context_t crt_ctx, int64_t timeout_us, v
 		uint64_t now = swim_now_ms();
 
 		crt_swim_update_last_unpack_hlc(csm);
+		crt_swim_stats_publish(csm);
 
 		/*
 		 * Check for network idle in all contexts.
@@ -878,6 +947,7 @@ int crt_swim_init(int crt_ctx_idx)
 	}
 
 	crt_gdata.cg_swim_inited = 1;
+	crt_swim_stats_init(csm);
 	if (self != CRT_NO_RANK && grp_membs != NULL) {
 		if (grp_membs->rl_nr != grp_priv->gp_size) {
 			D_ERROR("Mismatch in group size. Expected %d got %d\n",
@@ -1205,8 +1275,10 @@ out_unlock:
 	crt_swim_csm_unlock(csm);
 	D_FREE(cst);
 
-	if (id != SWIM_ID_INVALID)
+	if (id != SWIM_ID_INVALID) {
 		(void)swim_member_new_remote(csm->csm_ctx, id);
+		swim_members_count_set(csm->csm_ctx, grp_priv->gp_size);
+	}
 
 	if (rc && rc != -DER_ALREADY) {
 		if (rank_in_list)
@@ -1253,8 +1325,10 @@ int crt_swim_rank_del(struct crt_grp_priv *grp_priv, d_rank_t rank)
 		swim_self_set(csm->csm_ctx, SWIM_ID_INVALID);
 	crt_swim_csm_unlock(csm);
 
-	if (rc == 0)
+	if (rc == 0) {
 		D_FREE(cst);
+		swim_members_count_set(csm->csm_ctx, grp_priv->gp_size);
+	}
 
 	return rc;
 }
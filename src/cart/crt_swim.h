@@ -36,6 +36,15 @@ struct crt_swim_membs {
 	int				 csm_crt_ctx_idx;
 	int				 csm_nglitches;
 	int				 csm_nmessages;
+
+	/** SWIM statistics (when cg_use_sensors = true) */
+	struct d_tm_node_t		*csm_suspicions;
+	struct d_tm_node_t		*csm_confirms;
+	struct d_tm_node_t		*csm_refutes;
+	struct d_tm_node_t		*csm_false_pos;
+	struct d_tm_node_t		*csm_deaths;
+	struct d_tm_node_t		*csm_lhm;
+	struct d_tm_node_t		*csm_piggyback;
 };
 
 static inline void
@@ -122,6 +122,7 @@ int
 swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 		     struct swim_member_update **pupds, size_t *pnupds)
 {
+	TAILQ_HEAD(, swim_item)		 sent;
 	struct swim_member_update	*upds;
 	struct swim_item		*next, *item;
 	swim_id_t			 self_id = swim_self_get(ctx);
@@ -133,7 +134,17 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
-	nupds = SWIM_PIGGYBACK_ENTRIES + 1 /* id */;
+	TAILQ_INIT(&sent);
+	swim_ctx_lock(ctx);
+
+	/*
+	 * Size the piggyback buffer by the count of pending updates, so that
+	 * a burst of membership changes is drained quickly without making
+	 * every message of a quiet group bigger.
+	 */
+	nupds = min(max(ctx->sc_updates_nr, SWIM_PIGGYBACK_ENTRIES),
+		    ctx->sc_piggyback_max);
+	nupds++; /* id */
 	if (id != self_id)
 		nupds++; /* self_id */
 	if (id != to)
@@ -141,9 +152,7 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 
 	D_ALLOC_ARRAY(upds, nupds);
 	if (upds == NULL)
-		D_GOTO(out, rc = -DER_NOMEM);
-
-	swim_ctx_lock(ctx);
+		D_GOTO(out_unlock, rc = -DER_NOMEM);
 
 	rc = ctx->sc_ops->get_member_state(ctx, id, &upds[n].smu_state);
 	if (rc) {
@@ -178,17 +187,17 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 		upds[n++].smu_id = to;
 	}
 
+	/*
+	 * The entries sent with this message are rotated to the tail, so the
+	 * ones that do not fit are the first to be sent with next messages.
+	 */
 	item = TAILQ_FIRST(&ctx->sc_updates);
 	while (item != NULL) {
 		next = TAILQ_NEXT(item, si_link);
 
-		/* delete entries that are too many */
-		if (n >= nupds) {
-			TAILQ_REMOVE(&ctx->sc_updates, item, si_link);
-			D_FREE(item);
-			item = next;
-			continue;
-		}
+		/* the rest of entries will be sent with next messages */
+		if (n >= nupds)
+			break;
 
 		/* update with recent updates */
 		if (item->si_id != id &&
@@ -200,6 +209,7 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 				if (rc == -DER_NONEXIST) {
 					/* this member was removed already */
 					TAILQ_REMOVE(&ctx->sc_updates, item, si_link);
+					ctx->sc_updates_nr--;
 					D_FREE(item);
 					item = next;
 					continue;
@@ -211,9 +221,12 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 			upds[n++].smu_id = item->si_id;
 		}
 
+		TAILQ_REMOVE(&ctx->sc_updates, item, si_link);
 		if (++item->u.si_count > ctx->sc_piggyback_tx_max) {
-			TAILQ_REMOVE(&ctx->sc_updates, item, si_link);
+			ctx->sc_updates_nr--;
 			D_FREE(item);
+		} else {
+			TAILQ_INSERT_TAIL(&sent, item, si_link);
 		}
 
 		item = next;
@@ -221,6 +234,7 @@ swim_updates_prepare(struct swim_context *ctx, swim_id_t id, swim_id_t to,
 	rc = 0;
 
 out_unlock:
+	TAILQ_CONCAT(&ctx->sc_updates, &sent, si_link);
 	swim_ctx_unlock(ctx);
 
 	if (rc) {
@@ -257,6 +271,7 @@ swim_updates_notify(struct swim_context *ctx, swim_id_t from, swim_id_t id,
 		    struct swim_member_state *id_state, uint64_t count)
 {
 	struct swim_item *item;
+	struct swim_item *evict = NULL;
 
 	/* determine if this member already have an update */
 	TAILQ_FOREACH(item, &ctx->sc_updates, si_link) {
@@ -265,17 +280,33 @@ swim_updates_notify(struct swim_context *ctx, swim_id_t from, swim_id_t id,
 			item->u.si_count = count;
 			D_GOTO(update, 0);
 		}
+
+		if (evict == NULL || item->u.si_count > evict->u.si_count)
+			evict = item;
+	}
+
+	/*
+	 * Bound the pending updates, drop the most transferred one to make
+	 * room, it has been spread more than any other.
+	 */
+	if (ctx->sc_updates_nr >=
+	    SWIM_PIGGYBACK_QUEUE_MULT * ctx->sc_piggyback_max && evict != NULL) {
+		TAILQ_REMOVE(&ctx->sc_updates, evict, si_link);
+		ctx->sc_updates_nr--;
+		D_FREE(evict);
 	}
 
 	/* add this update to recent update list so it will be
-	 * piggybacked on future protocol messages
+	 * piggybacked on future protocol messages, after the pending
+	 * ones so none of them is starved by a burst of new updates
 	 */
 	D_ALLOC_PTR(item);
 	if (item != NULL) {
 		item->si_id   = id;
 		item->si_from = from;
 		item->u.si_count = count;
-		TAILQ_INSERT_HEAD(&ctx->sc_updates, item, si_link);
+		TAILQ_INSERT_TAIL(&ctx->sc_updates, item, si_link);
+		ctx->sc_updates_nr++;
 	}
 update:
 	return ctx->sc_ops->set_member_state(ctx, id, id_state);
@@ -316,6 +347,10 @@ swim_member_alive(struct swim_context *ctx, swim_id_t from, swim_id_t id, uint64
 		D_GOTO(out, rc = -DER_ALREADY);
 
 update:
+	/* the suspicion was refuted by the member itself */
+	if (id_state.sms_status == SWIM_MEMBER_SUSPECT)
+		ctx->sc_stats.ss_false_pos++;
+
 	/* if member is suspected, remove from suspect list */
 	TAILQ_FOREACH(item, &ctx->sc_suspects, si_link) {
 		if (item->si_id == id) {
@@ -373,6 +408,7 @@ update:
 	}
 
 	SWIM_ERROR("member %lu is DEAD\n", id);
+	ctx->sc_stats.ss_deaths++;
 	id_state.sms_incarnation = nr;
 	id_state.sms_status = SWIM_MEMBER_DEAD;
 	rc = swim_updates_notify(ctx, from, id, &id_state, 0);
@@ -380,6 +416,54 @@ out:
 	return rc;
 }
 
+/**
+ * Lifeguard local health aware suspicion timeout. It starts from
+ * SWIM_SUSPECT_TIMEOUT_MULT times the configured suspicion timeout and
+ * shrinks down to the configured value as independent confirmations of this
+ * suspicion arrive. While this member is unhealthy itself it is extended up
+ * to twice, because the own suspicions are likely false positives then.
+ */
+static uint64_t
+swim_suspect_timeout_lha(struct swim_context *ctx, uint32_t nconfirms)
+{
+	uint64_t min_timeout = swim_suspect_timeout_get();
+	uint64_t max_timeout = min_timeout * SWIM_SUSPECT_TIMEOUT_MULT;
+	uint64_t timeout;
+
+	timeout = max_timeout - (max_timeout - min_timeout) * nconfirms /
+			       SWIM_SUSPECT_CONFIRMS;
+
+	return timeout + timeout * ctx->sc_lhm / SWIM_LHM_MAX;
+}
+
+static void
+swim_member_suspect_confirm(struct swim_context *ctx, swim_id_t from, swim_id_t id)
+{
+	struct swim_item	*item;
+	uint64_t		 timeout;
+	uint32_t		 i;
+
+	TAILQ_FOREACH(item, &ctx->sc_suspects, si_link) {
+		if (item->si_id == id)
+			break;
+	}
+
+	if (item == NULL || item->si_from == from ||
+	    item->si_nconfirms >= SWIM_SUSPECT_CONFIRMS)
+		return;
+
+	for (i = 0; i < item->si_nconfirms; i++) {
+		if (item->si_confirms[i] == from)
+			return; /* not an independent confirmation */
+	}
+
+	timeout = swim_suspect_timeout_lha(ctx, item->si_nconfirms);
+	item->si_confirms[item->si_nconfirms++] = from;
+	timeout -= swim_suspect_timeout_lha(ctx, item->si_nconfirms);
+	item->u.si_deadline -= min(timeout, item->u.si_deadline);
+	ctx->sc_stats.ss_confirms++;
+}
+
 static int
 swim_member_suspect(struct swim_context *ctx, swim_id_t from, swim_id_t id, uint64_t nr)
 {
@@ -403,6 +487,12 @@ swim_member_suspect(struct swim_context *ctx, swim_id_t from, swim_id_t id, uint
 	if (nr > id_state.sms_incarnation)
 		D_GOTO(search, rc = 0);
 
+	if (id_state.sms_status == SWIM_MEMBER_SUSPECT &&
+	    id_state.sms_incarnation == nr) {
+		swim_member_suspect_confirm(ctx, from, id);
+		D_GOTO(out, rc = -DER_ALREADY);
+	}
+
 	/* ignore old updates or updates for dead members */
 	if (id_state.sms_status == SWIM_MEMBER_DEAD ||
 	    id_state.sms_status == SWIM_MEMBER_SUSPECT ||
@@ -422,8 +512,9 @@ search:
 		D_GOTO(out, rc = -DER_NOMEM);
 	item->si_id   = id;
 	item->si_from = from;
-	item->u.si_deadline = swim_now_ms() + swim_suspect_timeout_get();
+	item->u.si_deadline = swim_now_ms() + swim_suspect_timeout_lha(ctx, 0);
 	TAILQ_INSERT_TAIL(&ctx->sc_suspects, item, si_link);
+	ctx->sc_stats.ss_suspicions++;
 
 update:
 	id_state.sms_incarnation = nr;
@@ -742,8 +833,9 @@ swim_init(swim_id_t self_id, struct swim_ops *swim_ops, void *data)
 	TAILQ_INIT(&ctx->sc_updates);
 	TAILQ_INIT(&ctx->sc_ipings);
 
-	/* this can be tuned according members count */
+	/* tuned according members count by swim_members_count_set() */
 	ctx->sc_piggyback_tx_max = SWIM_PIGGYBACK_TX_COUNT;
+	ctx->sc_piggyback_max    = SWIM_PIGGYBACK_ENTRIES;
 	/* force to choose next target first */
 	ctx->sc_target = SWIM_ID_INVALID;
 
@@ -809,6 +901,38 @@ swim_fini(struct swim_context *ctx)
 	D_FREE(ctx);
 }
 
+void
+swim_members_count_set(struct swim_context *ctx, uint64_t nr)
+{
+	uint64_t log2n = 1;
+
+	/* count of rounds to spread an update across the group */
+	while (log2n < 64 && (1ULL << log2n) <= nr)
+		log2n++;
+
+	swim_ctx_lock(ctx);
+	ctx->sc_piggyback_tx_max = max(SWIM_PIGGYBACK_TX_MULT * log2n,
+				       SWIM_PIGGYBACK_TX_MIN);
+	ctx->sc_piggyback_max = min(max(SWIM_PIGGYBACK_ENTRIES * log2n / 2,
+					SWIM_PIGGYBACK_ENTRIES),
+				    SWIM_PIGGYBACK_ENTRIES_MAX);
+	swim_ctx_unlock(ctx);
+
+	D_DEBUG(DB_TRACE, "%lu members: piggyback up to %lu entries, "
+		"%lu transfers each\n", nr, ctx->sc_piggyback_max,
+		ctx->sc_piggyback_tx_max);
+}
+
+void
+swim_stats_get(struct swim_context *ctx, struct swim_stats *stats)
+{
+	swim_ctx_lock(ctx);
+	*stats = ctx->sc_stats;
+	stats->ss_lhm = ctx->sc_lhm;
+	stats->ss_piggyback_max = ctx->sc_piggyback_max;
+	swim_ctx_unlock(ctx);
+}
+
 int
 swim_net_glitch_update(struct swim_context *ctx, swim_id_t id, uint64_t delay)
 {
@@ -917,6 +1041,8 @@ swim_progress(struct swim_context *ctx, int64_t timeout_us)
 					if (delay < ping_timeout ||
 					    delay > 3 * ping_timeout)
 						delay = ping_timeout;
+					/* give more time while we are unhealthy */
+					delay = swim_lhm_scale(ctx, delay);
 
 					target_id = ctx->sc_target;
 					sendto_id = ctx->sc_target;
@@ -950,6 +1076,8 @@ swim_progress(struct swim_context *ctx, int64_t timeout_us)
 			if (now > ctx->sc_deadline) {
 				/* no response from direct ping */
 				if (target_state.sms_status != SWIM_MEMBER_INACTIVE) {
+					/* missed ack, maybe it is our fault */
+					swim_lhm_update(ctx, 1);
 					/* suspect this member */
 					swim_member_suspect(ctx, ctx->sc_self,
 							    ctx->sc_target,
@@ -1087,8 +1215,12 @@ swim_updates_parse(struct swim_context *ctx, swim_id_t from_id,
 	ctx_state = swim_state_get(ctx);
 
 	if (from_id == ctx->sc_target &&
-	    (ctx_state == SCS_BEGIN || ctx_state == SCS_PINGED))
+	    (ctx_state == SCS_BEGIN || ctx_state == SCS_PINGED)) {
+		/* the direct ping was acked in time */
+		if (ctx_state == SCS_PINGED)
+			swim_lhm_update(ctx, -1);
 		ctx_state = SCS_SELECT;
+	}
 
 	for (i = 0; i < nupds; i++) {
 		id = upds[i].smu_id;
@@ -1139,6 +1271,11 @@ swim_updates_parse(struct swim_context *ctx, swim_id_t from_id,
 					   upds[i].smu_state.sms_incarnation,
 					   from_id);
 
+				/* refute the suspicion, and count it against
+				 * our local health
+				 */
+				ctx->sc_stats.ss_refutes++;
+				swim_lhm_update(ctx, 1);
 				ctx->sc_ops->new_incarnation(ctx, self_id, &self_state);
 				rc = swim_updates_notify(ctx, self_id, self_id, &self_state, 0);
 				if (rc) {
@@ -57,6 +57,23 @@ extern "C" {
 					 * until it be removed from the list of
 					 * updates.
 					 */
+#define SWIM_PIGGYBACK_ENTRIES_MAX 64	/**< upper limit of piggybacked
+					 * entries for large groups.
+					 */
+#define SWIM_PIGGYBACK_TX_MULT	4	/**< retransmissions per log2(N) */
+#define SWIM_PIGGYBACK_TX_MIN	8	/**< min count of retransmissions */
+#define SWIM_PIGGYBACK_QUEUE_MULT 4	/**< pending updates kept, in units
+					 * of the piggyback limit.
+					 */
+#define SWIM_LHM_MAX		4	/**< saturation of local health
+					 * multiplier (Lifeguard "S").
+					 */
+#define SWIM_SUSPECT_CONFIRMS	3	/**< independent confirmations which
+					 * shrink suspicion to min timeout.
+					 */
+#define SWIM_SUSPECT_TIMEOUT_MULT 2	/**< initial suspicion timeout as
+					 * multiplier of the min timeout.
+					 */
 
 enum swim_context_state {
 	SCS_BEGIN = 0,		/**< initial state when next target was already
@@ -80,6 +97,9 @@ struct swim_item {
 		uint64_t	 si_deadline; /**< for sc_suspects/sc_ipings */
 		uint64_t	 si_count;    /**< for sc_updates */
 	} u;
+	/** for sc_suspects: senders which confirmed this suspicion */
+	swim_id_t		 si_confirms[SWIM_SUSPECT_CONFIRMS];
+	uint32_t		 si_nconfirms;
 };
 
 /** internal swim context implementation */
@@ -105,6 +125,12 @@ struct swim_context {
 	uint64_t		 sc_deadline;
 
 	uint64_t		 sc_piggyback_tx_max;
+	uint64_t		 sc_piggyback_max;
+	uint64_t		 sc_updates_nr;	/**< items in sc_updates */
+
+	/** Lifeguard local health multiplier, 0 means healthy */
+	uint32_t		 sc_lhm;
+	struct swim_stats	 sc_stats;
 
 	unsigned int		 sc_glitch:1;
 };
@@ -144,6 +170,28 @@ swim_now_ms(void)
 	return rc ? 0 : now.tv_sec * 1000 + now.tv_nsec / 1000000;
 }
 
+/**
+ * Raise (\a delta > 0) or lower (\a delta < 0) the local health multiplier.
+ * It grows when this member misses acks or has to refute a suspicion of
+ * itself, which most likely means that the problem is local (overloaded
+ * node or NIC), and drops back on each successful probe.
+ */
+static inline void
+swim_lhm_update(struct swim_context *ctx, int delta)
+{
+	if (delta > 0 && ctx->sc_lhm < SWIM_LHM_MAX)
+		ctx->sc_lhm++;
+	else if (delta < 0 && ctx->sc_lhm > 0)
+		ctx->sc_lhm--;
+}
+
+/** Scale \a timeout by local health, i.e. by (LHM + 1) */
+static inline uint64_t
+swim_lhm_scale(struct swim_context *ctx, uint64_t timeout)
+{
+	return timeout * (ctx->sc_lhm + 1);
+}
+
 static inline enum swim_context_state
 swim_state_get(struct swim_context *ctx)
 {
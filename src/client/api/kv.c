@@ -161,3 +161,12 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 
 	return dc_task_schedule(task, true);
 }
+
+int
+daos_kv_cache_query(daos_handle_t coh, struct daos_kv_cache_stats *stats)
+{
+	if (stats == NULL)
+		return -DER_INVAL;
+
+	return dc_kv_cache_query(coh, stats);
+}
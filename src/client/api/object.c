@@ -169,6 +169,21 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_obj_update_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		      unsigned int nr, daos_dkey_io_t *ios, daos_event_t *ev)
+{
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_obj_update_multi_task_create(oh, th, flags, nr, ios, ev, NULL,
+					     &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_obj_list_dkey(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 		   daos_key_desc_t *kds, d_sg_list_t *sgl,
@@ -240,6 +255,16 @@ daos_obj_layout_get(daos_handle_t coh, daos_obj_id_t oid,
 	return rc;
 }
 
+int
+daos_obj_tgt_stats_query(struct daos_obj_tgt_stats *stats)
+{
+	if (stats == NULL)
+		return -DER_INVAL;
+
+	dc_obj_tgt_stats_query(stats);
+	return 0;
+}
+
 int
 daos_obj_verify(daos_handle_t coh, daos_obj_id_t oid, daos_epoch_t epoch)
 {
@@ -131,6 +131,15 @@ daos_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch)
 	return dc_tx_hdl2epoch(th, epoch);
 }
 
+int
+daos_tx_hdl2stats(daos_handle_t th, struct daos_tx_stats *stats)
+{
+	if (stats == NULL)
+		return -DER_INVAL;
+
+	return dc_tx_hdl2stats(th, stats);
+}
+
 int
 daos_tx_local2global(daos_handle_t th, d_iov_t *glob)
 {
@@ -13,6 +13,7 @@
 #include <daos/common.h>
 #include <daos/tse.h>
 #include <daos/object.h>
+#include <daos/container.h>
 #include <daos/kv.h>
 #include <daos_api.h>
 #include <daos_kv.h>
@@ -39,6 +40,340 @@ struct io_params {
 	char			akey_val;
 };
 
+/**
+ * Client cache of small KV values, one per container handle, it is disabled
+ * unless DAOS_KV_CACHE_MB is set.
+ *
+ * Values are cached by the successful put and get done outside of a
+ * transaction, so that a client reads its own writes without a round trip.
+ * Writes of other clients are not tracked, a cached value is only served
+ * for DAOS_KV_CACHE_LEASE_MS after it has been cached, and all values are
+ * dropped when the container handle is closed. Reads in a transaction
+ * bypass the cache to be in the read set of the transaction, any write or
+ * remove of a key invalidates its cached value when it is issued.
+ */
+#define KV_CACHE_BUCKETS	256
+#define KV_CACHE_LEASE_DEF	1000	/* ms */
+#define KV_CACHE_VAL_MAX	4096
+
+struct dc_kv_cache {
+	pthread_mutex_t		 kc_lock;
+	d_list_t		 kc_buckets[KV_CACHE_BUCKETS];
+	/** LRU list, the most recently used entry at the head */
+	d_list_t		 kc_lru;
+	uint64_t		 kc_size;
+	uint64_t		 kc_max;
+	uint64_t		 kc_nr;
+	uint32_t		 kc_lease;
+	/**
+	 * Bumped by every invalidation, a fetched or written value is only
+	 * cached if no write of the cache has been issued in the meantime.
+	 */
+	uint64_t		 kc_wseq;
+	uint64_t		 kc_hits;
+	uint64_t		 kc_misses;
+};
+
+struct kv_cache_entry {
+	d_list_t		 kce_hash_link;
+	d_list_t		 kce_lru_link;
+	daos_obj_id_t		 kce_oid;
+	uint64_t		 kce_hash;
+	/** coarse monotonic time in ms the lease expires */
+	uint64_t		 kce_expire;
+	size_t			 kce_key_len;
+	daos_size_t		 kce_len;
+	/** the key followed by the value */
+	char			 kce_buf[0];
+};
+
+/** Arguments of the completion callback which caches the value */
+struct kv_cache_cb_args {
+	struct dc_kv_cache	*kc;
+	daos_obj_id_t		 oid;
+	const char		*key;
+	void			*buf;
+	daos_size_t		*buf_size;
+	daos_size_t		 len;
+	uint64_t		 wseq;
+};
+
+int
+dc_kv_cache_create(struct dc_kv_cache **cache)
+{
+	struct dc_kv_cache	*kc;
+	unsigned int		 mb = 0;
+	unsigned int		 lease = KV_CACHE_LEASE_DEF;
+	int			 i;
+	int			 rc;
+
+	*cache = NULL;
+	d_getenv_int("DAOS_KV_CACHE_MB", &mb);
+	if (mb == 0)
+		return 0;
+	d_getenv_int("DAOS_KV_CACHE_LEASE_MS", &lease);
+
+	D_ALLOC_PTR(kc);
+	if (kc == NULL)
+		return -DER_NOMEM;
+
+	rc = D_MUTEX_INIT(&kc->kc_lock, NULL);
+	if (rc) {
+		D_FREE(kc);
+		return rc;
+	}
+	for (i = 0; i < KV_CACHE_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&kc->kc_buckets[i]);
+	D_INIT_LIST_HEAD(&kc->kc_lru);
+	kc->kc_max = (uint64_t)mb << 20;
+	kc->kc_lease = lease;
+
+	*cache = kc;
+	return 0;
+}
+
+static void
+kv_cache_evict(struct dc_kv_cache *kc, struct kv_cache_entry *entry)
+{
+	d_list_del(&entry->kce_hash_link);
+	d_list_del(&entry->kce_lru_link);
+	D_ASSERT(kc->kc_size >= entry->kce_len);
+	kc->kc_size -= entry->kce_len;
+	kc->kc_nr--;
+	D_FREE(entry);
+}
+
+void
+dc_kv_cache_destroy(struct dc_kv_cache *kc)
+{
+	struct kv_cache_entry	*entry, *tmp;
+
+	if (kc == NULL)
+		return;
+
+	D_DEBUG(DB_TRACE, "KV cache "DF_U64" hits "DF_U64" misses\n",
+		kc->kc_hits, kc->kc_misses);
+	d_list_for_each_entry_safe(entry, tmp, &kc->kc_lru, kce_lru_link)
+		kv_cache_evict(kc, entry);
+	D_ASSERT(kc->kc_size == 0);
+	D_MUTEX_DESTROY(&kc->kc_lock);
+	D_FREE(kc);
+}
+
+static inline uint64_t
+kv_cache_hash(daos_obj_id_t oid, const char *key, size_t key_len)
+{
+	return d_hash_murmur64((unsigned char *)key, key_len,
+			       oid.lo ^ (oid.hi * DGOLDEN_RATIO_PRIME_64));
+}
+
+static struct kv_cache_entry *
+kv_cache_find(struct dc_kv_cache *kc, daos_obj_id_t oid, const char *key,
+	      size_t key_len, uint64_t hash)
+{
+	struct kv_cache_entry	*entry;
+
+	d_list_for_each_entry(entry, &kc->kc_buckets[hash % KV_CACHE_BUCKETS],
+			      kce_hash_link) {
+		if (entry->kce_hash == hash && entry->kce_key_len == key_len &&
+		    daos_oid_cmp(entry->kce_oid, oid) == 0 &&
+		    memcmp(entry->kce_buf, key, key_len) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/**
+ * Copy the cached value of \a key to \a buf, or only return its size if
+ * \a buf is NULL. Returns false if the value is not cached, the lease has
+ * expired or \a buf is too small.
+ */
+static bool
+kv_cache_lookup(struct dc_kv_cache *kc, daos_obj_id_t oid, const char *key,
+		void *buf, daos_size_t *buf_size)
+{
+	struct kv_cache_entry	*entry;
+	size_t			 key_len = strlen(key);
+	bool			 found = false;
+
+	D_MUTEX_LOCK(&kc->kc_lock);
+	entry = kv_cache_find(kc, oid, key, key_len,
+			      kv_cache_hash(oid, key, key_len));
+	if (entry != NULL && entry->kce_expire <= daos_getmtime_coarse()) {
+		kv_cache_evict(kc, entry);
+		entry = NULL;
+	}
+
+	if (entry != NULL && (buf == NULL || *buf_size >= entry->kce_len)) {
+		if (buf != NULL)
+			memcpy(buf, &entry->kce_buf[key_len], entry->kce_len);
+		*buf_size = entry->kce_len;
+		d_list_move(&entry->kce_lru_link, &kc->kc_lru);
+		found = true;
+		kc->kc_hits++;
+	} else {
+		kc->kc_misses++;
+	}
+	D_MUTEX_UNLOCK(&kc->kc_lock);
+
+	return found;
+}
+
+static uint64_t
+kv_cache_wseq(struct dc_kv_cache *kc)
+{
+	uint64_t	wseq;
+
+	D_MUTEX_LOCK(&kc->kc_lock);
+	wseq = kc->kc_wseq;
+	D_MUTEX_UNLOCK(&kc->kc_lock);
+
+	return wseq;
+}
+
+/** Drop the cached value of \a key, or all values of \a oid if it is NULL */
+static uint64_t
+kv_cache_invalidate(struct dc_kv_cache *kc, daos_obj_id_t oid, const char *key)
+{
+	struct kv_cache_entry	*entry, *tmp;
+	size_t			 key_len;
+	uint64_t		 wseq;
+
+	D_MUTEX_LOCK(&kc->kc_lock);
+	if (key != NULL) {
+		key_len = strlen(key);
+		entry = kv_cache_find(kc, oid, key, key_len,
+				      kv_cache_hash(oid, key, key_len));
+		if (entry != NULL)
+			kv_cache_evict(kc, entry);
+	} else {
+		d_list_for_each_entry_safe(entry, tmp, &kc->kc_lru,
+					   kce_lru_link) {
+			if (daos_oid_cmp(entry->kce_oid, oid) == 0)
+				kv_cache_evict(kc, entry);
+		}
+	}
+	wseq = ++kc->kc_wseq;
+	D_MUTEX_UNLOCK(&kc->kc_lock);
+
+	return wseq;
+}
+
+static void
+kv_cache_insert(struct dc_kv_cache *kc, daos_obj_id_t oid, const char *key,
+		const void *val, daos_size_t len, uint64_t wseq)
+{
+	struct kv_cache_entry	*entry;
+	struct kv_cache_entry	*lru;
+	size_t			 key_len = strlen(key);
+	uint64_t		 hash = kv_cache_hash(oid, key, key_len);
+
+	D_ALLOC(entry, sizeof(*entry) + key_len + len);
+	if (entry == NULL)
+		return;
+
+	entry->kce_oid = oid;
+	entry->kce_hash = hash;
+	entry->kce_key_len = key_len;
+	entry->kce_len = len;
+	memcpy(entry->kce_buf, key, key_len);
+	memcpy(&entry->kce_buf[key_len], val, len);
+
+	D_MUTEX_LOCK(&kc->kc_lock);
+	/* A write was issued after the value was fetched or written */
+	if (kc->kc_wseq != wseq) {
+		D_MUTEX_UNLOCK(&kc->kc_lock);
+		D_FREE(entry);
+		return;
+	}
+
+	lru = kv_cache_find(kc, oid, key, key_len, hash);
+	if (lru != NULL)
+		kv_cache_evict(kc, lru);
+
+	entry->kce_expire = daos_getmtime_coarse() + kc->kc_lease;
+	d_list_add(&entry->kce_hash_link,
+		   &kc->kc_buckets[hash % KV_CACHE_BUCKETS]);
+	d_list_add(&entry->kce_lru_link, &kc->kc_lru);
+	kc->kc_size += len;
+	kc->kc_nr++;
+
+	while (kc->kc_size > kc->kc_max) {
+		lru = d_list_entry(kc->kc_lru.prev, struct kv_cache_entry,
+				   kce_lru_link);
+		kv_cache_evict(kc, lru);
+	}
+	D_MUTEX_UNLOCK(&kc->kc_lock);
+}
+
+static int
+kv_cache_comp_cb(tse_task_t *task, void *data);
+
+/** Cache the value written or fetched by \a task when it completes */
+static int
+kv_cache_register(tse_task_t *task, struct dc_kv_cache *kc, struct dc_kv *kv,
+		  const char *key, void *buf, daos_size_t *buf_size,
+		  daos_size_t len, uint64_t wseq)
+{
+	struct kv_cache_cb_args	cb_args;
+
+	cb_args.kc = kc;
+	cb_args.oid = kv->oid;
+	cb_args.key = key;
+	cb_args.buf = buf;
+	cb_args.buf_size = buf_size;
+	cb_args.len = min(len, KV_CACHE_VAL_MAX);
+	cb_args.wseq = wseq;
+
+	return tse_task_register_comp_cb(task, kv_cache_comp_cb, &cb_args,
+					 sizeof(cb_args));
+}
+
+static int
+kv_cache_comp_cb(tse_task_t *task, void *data)
+{
+	struct kv_cache_cb_args	*cb_args = data;
+	daos_size_t		 len = cb_args->len;
+
+	if (task->dt_result != 0)
+		return 0;
+
+	/* fetch, cache the returned value if it has been copied out */
+	if (cb_args->buf_size != NULL) {
+		len = *cb_args->buf_size;
+		if (len == 0 || len > cb_args->len)
+			return 0;
+	}
+
+	kv_cache_insert(cb_args->kc, cb_args->oid, cb_args->key, cb_args->buf,
+			len, cb_args->wseq);
+	return 0;
+}
+
+int
+dc_kv_cache_query(daos_handle_t coh, struct daos_kv_cache_stats *stats)
+{
+	struct dc_kv_cache	*kc;
+
+	if (daos_handle_is_inval(dc_cont_hdl2pool_hdl(coh)))
+		return -DER_NO_HDL;
+
+	memset(stats, 0, sizeof(*stats));
+	kc = dc_cont_hdl2kv_cache(coh);
+	if (kc == NULL)
+		return 0;
+
+	D_MUTEX_LOCK(&kc->kc_lock);
+	stats->kcs_hits = kc->kc_hits;
+	stats->kcs_misses = kc->kc_misses;
+	stats->kcs_entries = kc->kc_nr;
+	stats->kcs_bytes = kc->kc_size;
+	D_MUTEX_UNLOCK(&kc->kc_lock);
+
+	return 0;
+}
+
 static void
 kv_free(struct d_hlink *hlink)
 {
@@ -291,6 +626,7 @@ dc_kv_destroy(tse_task_t *task)
 {
 	daos_kv_destroy_t	*args = daos_task_get_args(task);
 	struct dc_kv		*kv;
+	struct dc_kv_cache	*kc;
 	tse_task_t		*punch_task;
 	daos_obj_punch_t	*punch_args;
 	int			rc;
@@ -313,6 +649,10 @@ dc_kv_destroy(tse_task_t *task)
 	punch_args->akeys	= NULL;
 	punch_args->akey_nr	= 0;
 
+	kc = dc_cont_hdl2kv_cache(kv->coh);
+	if (kc != NULL)
+		kv_cache_invalidate(kc, kv->oid, NULL);
+
 	/** The upper task completes when the punch task completes */
 	rc = tse_task_register_deps(task, 1, &punch_task);
 	if (rc != 0) {
@@ -359,9 +699,11 @@ dc_kv_put(tse_task_t *task)
 {
 	daos_kv_put_t		*args = daos_task_get_args(task);
 	struct dc_kv		*kv = NULL;
+	struct dc_kv_cache	*kc;
 	daos_obj_update_t	*update_args;
 	tse_task_t		*update_task = NULL;
 	struct io_params	*params = NULL;
+	uint64_t		wseq;
 	int			rc;
 
 	if (args->key == NULL || args->buf_size == 0 || args->buf == NULL)
@@ -405,6 +747,20 @@ dc_kv_put(tse_task_t *task)
 	update_args->iods	= &params->iod;
 	update_args->sgls	= &params->sgl;
 
+	kc = dc_cont_hdl2kv_cache(kv->coh);
+	if (kc != NULL) {
+		wseq = kv_cache_invalidate(kc, kv->oid, args->key);
+		/* the value is not visible before the transaction commits */
+		if (daos_handle_is_inval(args->th) &&
+		    args->buf_size <= KV_CACHE_VAL_MAX) {
+			rc = kv_cache_register(task, kc, kv, args->key,
+					       (void *)args->buf, NULL,
+					       args->buf_size, wseq);
+			if (rc != 0)
+				D_GOTO(err_task, rc);
+		}
+	}
+
 	rc = tse_task_register_comp_cb(task, free_io_params_cb, &params,
 				       sizeof(params));
 	if (rc != 0)
@@ -438,11 +794,13 @@ dc_kv_get(tse_task_t *task)
 {
 	daos_kv_get_t		*args = daos_task_get_args(task);
 	struct dc_kv		*kv = NULL;
+	struct dc_kv_cache	*kc;
 	daos_obj_fetch_t	*fetch_args;
 	tse_task_t		*fetch_task = NULL;
 	struct io_params	*params = NULL;
 	void			*buf;
 	daos_size_t		*buf_size;
+	uint64_t		wseq;
 	int			rc;
 
 	if (args->key == NULL)
@@ -459,6 +817,24 @@ dc_kv_get(tse_task_t *task)
 		D_GOTO(err_task, rc = -DER_INVAL);
 	}
 
+	/* reads in a transaction must reach the server to be in its read set */
+	kc = dc_cont_hdl2kv_cache(kv->coh);
+	if (kc != NULL && daos_handle_is_inval(args->th) && args->flags == 0) {
+		wseq = kv_cache_wseq(kc);
+		if (kv_cache_lookup(kc, kv->oid, args->key, buf, buf_size)) {
+			tse_task_complete(task, 0);
+			kv_decref(kv);
+			return 0;
+		}
+
+		if (buf != NULL && *buf_size != 0) {
+			rc = kv_cache_register(task, kc, kv, args->key, buf,
+					       buf_size, *buf_size, wseq);
+			if (rc != 0)
+				D_GOTO(err_task, rc);
+		}
+	}
+
 	D_ALLOC_PTR(params);
 	if (params == NULL)
 		D_GOTO(err_task, rc = -DER_NOMEM);
@@ -535,6 +911,7 @@ dc_kv_remove(tse_task_t *task)
 {
 	daos_kv_remove_t	*args = daos_task_get_args(task);
 	struct dc_kv		*kv = NULL;
+	struct dc_kv_cache	*kc;
 	daos_obj_punch_t	*punch_args;
 	tse_task_t		*punch_task = NULL;
 	struct io_params	*params = NULL;
@@ -567,6 +944,10 @@ dc_kv_remove(tse_task_t *task)
 	punch_args->akeys	= NULL;
 	punch_args->akey_nr	= 0;
 
+	kc = dc_cont_hdl2kv_cache(kv->coh);
+	if (kc != NULL)
+		kv_cache_invalidate(kc, kv->oid, args->key);
+
 	rc = tse_task_register_comp_cb(task, free_io_params_cb, &params,
 				       sizeof(params));
 	if (rc != 0)
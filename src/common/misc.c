@@ -633,6 +633,17 @@ daos_hhash_link_delete(struct d_hlink *hlink)
 	return d_hhash_link_delete(daos_ht.dht_hhash, hlink);
 }
 
+static bool daos_crt_server;
+
+/**
+ * Whether the caller runs in the engine, where the client stack is driven by
+ * Argobots ULTs that cannot block on pthread primitives.
+ */
+bool
+daos_is_server(void)
+{
+	return daos_crt_server;
+}
 
 #define CRT_SOCKET_PROV		"ofi+sockets"
 /**
@@ -654,6 +665,10 @@ daos_crt_init_opt_get(bool server, int ctx_nr)
 	crt_phy_addr_t	addr_env;
 	bool		sep = false;
 
+	/** the client stack initialized by the engine also calls it with false */
+	if (server)
+		daos_crt_server = true;
+
 	/** enable statistics on the server side */
 	daos_crt_init_opt.cio_use_sensors = server;
 
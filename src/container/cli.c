@@ -18,6 +18,7 @@
 #include <daos/mgmt.h>
 #include <daos/pool.h>
 #include <daos/object.h>
+#include <daos/kv.h>
 #include <daos/rsvc.h>
 #include <daos_types.h>
 #include "cli_internal.h"
@@ -504,6 +505,9 @@ void
 dc_cont_free(struct dc_cont *dc)
 {
 	D_ASSERT(daos_hhash_link_empty(&dc->dc_hlink));
+	obj_ec_rcache_destroy(dc->dc_ec_rcache);
+	obj_layout_cache_destroy(dc->dc_layout_cache);
+	dc_kv_cache_destroy(dc->dc_kv_cache);
 	D_RWLOCK_DESTROY(&dc->dc_obj_list_lock);
 	D_ASSERT(d_list_empty(&dc->dc_po_list));
 	D_ASSERT(d_list_empty(&dc->dc_obj_list));
@@ -523,8 +527,19 @@ dc_cont_alloc(const uuid_t uuid)
 	uuid_copy(dc->dc_uuid, uuid);
 	D_INIT_LIST_HEAD(&dc->dc_obj_list);
 	D_INIT_LIST_HEAD(&dc->dc_po_list);
-	if (D_RWLOCK_INIT(&dc->dc_obj_list_lock, NULL) != 0)
+	if (D_RWLOCK_INIT(&dc->dc_obj_list_lock, NULL) != 0) {
 		D_FREE(dc);
+		return NULL;
+	}
+
+	/* The recovery cache is optional, degraded fetch works without it */
+	if (obj_ec_rcache_create(&dc->dc_ec_rcache) != 0)
+		dc->dc_ec_rcache = NULL;
+	/* Neither is the layout cache, objects then place their own layout */
+	if (obj_layout_cache_create(&dc->dc_layout_cache) != 0)
+		dc->dc_layout_cache = NULL;
+	if (dc_kv_cache_create(&dc->dc_kv_cache) != 0)
+		dc->dc_kv_cache = NULL;
 
 	return dc;
 }
@@ -3149,6 +3164,54 @@ dc_cont_hdl2csummer(daos_handle_t coh)
 	return csum;
 }
 
+struct obj_ec_rcache *
+dc_cont_hdl2ec_rcache(daos_handle_t coh)
+{
+	struct dc_cont		*dc;
+	struct obj_ec_rcache	*cache;
+
+	dc = dc_hdl2cont(coh);
+	if (dc == NULL)
+		return NULL;
+
+	cache = dc->dc_ec_rcache;
+	dc_cont_put(dc);
+
+	return cache;
+}
+
+struct obj_layout_cache *
+dc_cont_hdl2layout_cache(daos_handle_t coh)
+{
+	struct dc_cont		*dc;
+	struct obj_layout_cache	*cache;
+
+	dc = dc_hdl2cont(coh);
+	if (dc == NULL)
+		return NULL;
+
+	cache = dc->dc_layout_cache;
+	dc_cont_put(dc);
+
+	return cache;
+}
+
+struct dc_kv_cache *
+dc_cont_hdl2kv_cache(daos_handle_t coh)
+{
+	struct dc_cont		*dc;
+	struct dc_kv_cache	*cache;
+
+	dc = dc_hdl2cont(coh);
+	if (dc == NULL)
+		return NULL;
+
+	cache = dc->dc_kv_cache;
+	dc_cont_put(dc);
+
+	return cache;
+}
+
 struct cont_props
 dc_cont_hdl2props(daos_handle_t coh)
 {
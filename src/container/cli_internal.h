@@ -30,6 +30,12 @@ struct dc_cont {
 	struct cont_props	dc_props;
 	/* minimal pmap version */
 	uint32_t		dc_min_ver;
+	/* cache of EC stripes recovered by degraded fetch */
+	struct obj_ec_rcache	*dc_ec_rcache;
+	/* cache of object layouts */
+	struct obj_layout_cache	*dc_layout_cache;
+	/* cache of small KV values */
+	struct dc_kv_cache	*dc_kv_cache;
 	uint32_t		dc_closing:1,
 				dc_slave:1; /* generated via g2l */
 };
@@ -639,6 +639,7 @@ cont_child_alloc_ref(void *co_uuid, unsigned int ksize, void *po_uuid,
 	cont->sc_snapshots_nr = 0;
 	cont->sc_snapshots = NULL;
 	cont->sc_dtx_cos_hdl = DAOS_HDL_INVAL;
+	cont->sc_dtx_cos_obj_hdl = DAOS_HDL_INVAL;
 	D_INIT_LIST_HEAD(&cont->sc_link);
 	D_INIT_LIST_HEAD(&cont->sc_open_hdls);
 
@@ -22,6 +22,8 @@ uint32_t dtx_agg_thd_cnt_up;
 uint32_t dtx_agg_thd_cnt_lo;
 uint32_t dtx_agg_thd_age_up;
 uint32_t dtx_agg_thd_age_lo;
+uint32_t dtx_piggyback_max;
+bool dtx_hlc_tracked;
 
 struct dtx_batched_pool_args {
 	/* Link to dss_module_info::dmi_dtx_batched_pool_list. */
@@ -48,6 +50,11 @@ struct dtx_batched_cont_args {
 	struct dtx_batched_pool_args	*dbca_pool;
 	int				 dbca_refs;
 	uint32_t			 dbca_reg_gen;
+	/* Batched commit thresholds, see dtx_cmt_thd_adjust(). */
+	uint32_t			 dbca_cmt_cnt_thd;
+	uint32_t			 dbca_cmt_age_thd;
+	/* Average batched commit latency in microsecond. */
+	uint64_t			 dbca_cmt_lat;
 	uint32_t			 dbca_deregister:1,
 					 dbca_cleanup_done:1,
 					 dbca_commit_done:1,
@@ -96,6 +103,12 @@ dtx_free_dbca(struct dtx_batched_cont_args *dbca)
 		cont->sc_dtx_cos_hdl = DAOS_HDL_INVAL;
 	}
 
+	/* Destroy the object index after the CoS btree that refers to it. */
+	if (daos_handle_is_valid(cont->sc_dtx_cos_obj_hdl)) {
+		dbtree_destroy(cont->sc_dtx_cos_obj_hdl, NULL);
+		cont->sc_dtx_cos_obj_hdl = DAOS_HDL_INVAL;
+	}
+
 	D_ASSERT(cont->sc_dtx_committable_count == 0);
 	D_ASSERT(d_list_empty(&cont->sc_dtx_cos_list));
 
@@ -466,6 +479,67 @@ dtx_aggregation_main(void *arg)
 	dmi->dmi_dtx_agg_req = NULL;
 }
 
+static inline bool
+dtx_cmt_thd_hit(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	return stat->dtx_committable_count > dbca->dbca_cmt_cnt_thd ||
+	       (stat->dtx_oldest_committable_time != 0 &&
+		dtx_hlc_age2sec(stat->dtx_oldest_committable_time) >= dbca->dbca_cmt_age_thd) ||
+	       (stat->dtx_committable_count > 0 &&
+		stat->dtx_cont_act_count >= DTX_ACT_QUOTA_HI(stat->dtx_cont_act_quota));
+}
+
+/*
+ * Adjust the container's batched commit thresholds after one batched commit
+ * round that committed @cnt DTXs in @lat microseconds.
+ *
+ * The active DTX entries and the committable DTXs (CoS) piling up means that
+ * current batched commit cannot catch up with the modifications, then halve
+ * both thresholds to drain them sooner. Otherwise, a full batch means that the
+ * commit was triggered by count (busy), enlarge the batch if the commit is not
+ * slow to save commit RPCs; a partial batch means that the commit was triggered
+ * by age (idle), then shorten the age threshold to not hold the DTXs too long.
+ */
+static void
+dtx_cmt_thd_adjust(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat,
+		   int cnt, uint64_t lat)
+{
+	struct dtx_pool_metrics	*dpm = dtx_cont2metrics(dbca->dbca_cont);
+	uint32_t		 cnt_thd = dbca->dbca_cmt_cnt_thd;
+	uint32_t		 age_thd = dbca->dbca_cmt_age_thd;
+
+	if (dbca->dbca_cmt_lat == 0)
+		dbca->dbca_cmt_lat = lat;
+	else
+		dbca->dbca_cmt_lat = (dbca->dbca_cmt_lat * 7 + lat) >> 3;
+
+	if (stat->dtx_cont_act_count >= DTX_CMT_ACT_HI ||
+	    stat->dtx_committable_count >= (uint64_t)cnt_thd << 1) {
+		cnt_thd = max(cnt_thd >> 1, DTX_CMT_THD_CNT_MIN);
+		age_thd = max(age_thd >> 1, DTX_CMT_THD_AGE_MIN);
+	} else if (cnt >= cnt_thd) {
+		if (dbca->dbca_cmt_lat < DTX_CMT_LAT_HI)
+			cnt_thd = min(cnt_thd + DTX_CMT_THD_CNT_MIN, DTX_CMT_THD_CNT_MAX);
+		age_thd = min(age_thd + 1, DTX_CMT_THD_AGE_MAX);
+	} else if (age_thd > DTX_CMT_THD_AGE_MIN) {
+		age_thd--;
+	}
+
+	if (cnt_thd != dbca->dbca_cmt_cnt_thd || age_thd != dbca->dbca_cmt_age_thd)
+		D_DEBUG(DB_TRACE, "Adjust DTX batched commit thresholds for "DF_UUID
+			" from %u/%u to %u/%u, lat "DF_U64", act %u, committable "DF_U64"\n",
+			DP_UUID(dbca->dbca_cont->sc_uuid), dbca->dbca_cmt_cnt_thd,
+			dbca->dbca_cmt_age_thd, cnt_thd, age_thd, dbca->dbca_cmt_lat,
+			stat->dtx_cont_act_count, stat->dtx_committable_count);
+
+	dbca->dbca_cmt_cnt_thd = cnt_thd;
+	dbca->dbca_cmt_age_thd = age_thd;
+
+	d_tm_set_gauge(dpm->dpm_cmt_cnt_thd, cnt_thd);
+	d_tm_set_gauge(dpm->dpm_cmt_age_thd, age_thd);
+	d_tm_set_gauge(dpm->dpm_cmt_lat, dbca->dbca_cmt_lat);
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
@@ -482,10 +556,11 @@ dtx_batched_commit_one(void *arg)
 		struct dtx_entry	**dtes = NULL;
 		struct dtx_cos_key	 *dcks = NULL;
 		struct dtx_stat		  stat = { 0 };
+		uint64_t		  start;
 		int			  cnt;
 		int			  rc;
 
-		cnt = dtx_fetch_committable(cont, DTX_THRESHOLD_COUNT, NULL,
+		cnt = dtx_fetch_committable(cont, dbca->dbca_cmt_cnt_thd, NULL,
 					    DAOS_EPOCH_MAX, &dtes, &dcks);
 		if (cnt == 0)
 			break;
@@ -496,6 +571,7 @@ dtx_batched_commit_one(void *arg)
 			break;
 		}
 
+		start = daos_getutime();
 		rc = dtx_commit(cont, dtes, dcks, cnt);
 		dtx_free_committable(dtes, dcks, cnt);
 		if (rc != 0) {
@@ -505,15 +581,13 @@ dtx_batched_commit_one(void *arg)
 		}
 
 		dtx_stat(cont, &stat);
+		dtx_cmt_thd_adjust(dbca, &stat, cnt, daos_getutime() - start);
 
 		if (stat.dtx_pool_cmt_count >= dtx_agg_thd_cnt_up &&
 		    dbca->dbca_pool->dbpa_aggregating == 0)
 			sched_req_wakeup(dmi->dmi_dtx_agg_req);
 
-		if ((stat.dtx_committable_count <= DTX_THRESHOLD_COUNT) &&
-		    (stat.dtx_oldest_committable_time == 0 ||
-		     dtx_hlc_age2sec(stat.dtx_oldest_committable_time) <
-		     DTX_COMMIT_THRESHOLD_AGE))
+		if (!dtx_cmt_thd_hit(dbca, &stat))
 			break;
 	}
 
@@ -564,6 +638,8 @@ dtx_batched_commit(void *arg)
 		d_list_move_tail(&dbca->dbca_sys_link,
 				 &dmi->dmi_dtx_batched_cont_open_list);
 		dtx_stat(cont, &stat);
+		d_tm_set_gauge(dtx_cont2metrics(cont)->dpm_act_bytes,
+			       stat.dtx_pool_act_bytes);
 
 		if (dbca->dbca_commit_req != NULL && dbca->dbca_commit_done) {
 			sched_req_put(dbca->dbca_commit_req);
@@ -572,10 +648,7 @@ dtx_batched_commit(void *arg)
 		}
 
 		if (dtx_cont_opened(cont) && dbca->dbca_commit_req == NULL &&
-		    ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
-		     (stat.dtx_oldest_committable_time != 0 &&
-		      dtx_hlc_age2sec(stat.dtx_oldest_committable_time) >=
-		      DTX_COMMIT_THRESHOLD_AGE))) {
+		    dtx_cmt_thd_hit(dbca, &stat)) {
 			D_ASSERT(!dbca->dbca_commit_done);
 			sleep_time = 0;
 			dtx_get_dbca(dbca);
@@ -644,7 +717,11 @@ dtx_epoch_bound(struct dtx_epoch *epoch)
 		 */
 		return epoch->oe_value;
 
-	limit = crt_hlc_epsilon_get_bound(epoch->oe_first);
+	if (dtx_hlc_tracked)
+		/* The window tracked from the HLC offsets to other engines. */
+		limit = crt_hlc_uncertainty_get_bound(epoch->oe_first);
+	else
+		limit = crt_hlc_epsilon_get_bound(epoch->oe_first);
 	if (epoch->oe_value >= limit)
 		/*
 		 * The epoch is already out of the potential uncertainty
@@ -1257,6 +1334,8 @@ sync:
 		}
 	}
 
+	d_tm_inc_counter(dtx_cont2metrics(cont)->dpm_leader_total, 1);
+
 abort:
 	/* Some remote replica(s) ask retry. We do not make such replica
 	 * to locally retry for avoiding RPC timeout. The leader replica
@@ -1298,6 +1377,8 @@ out:
 		for (i = 0; i < dth->dth_dti_cos_count; i++)
 			dtx_del_cos(cont, &dth->dth_dti_cos[i],
 				    &dth->dth_leader_oid, dth->dth_dkey_hash);
+		d_tm_inc_counter(dtx_cont2metrics(cont)->dpm_piggyback_total,
+				 dth->dth_dti_cos_count);
 	}
 
 	D_FREE(dth->dth_oid_array);
@@ -1306,6 +1387,40 @@ out:
 	return result;
 }
 
+/**
+ * Throttle the new leader DTX against the container that has too many active
+ * DTX entries: kick the batched commit and wait for it to release some active
+ * entries, for a bounded time. Then the clients of one busy container are slowed
+ * down before VOS refuses their new DTXs for exceeding the per-container quota.
+ *
+ * \param cont		[IN]	Per-thread container cache.
+ */
+void
+dtx_act_throttle(struct ds_cont_child *cont)
+{
+	struct dss_module_info	*dmi;
+	int			 i;
+
+	for (i = 0; i < DTX_ACT_THROTTLE_MAX; i++) {
+		if (!vos_dtx_act_busy(cont->sc_hdl))
+			break;
+
+		/* Nothing can be committed, waiting does not help. */
+		if (cont->sc_dtx_committable_count == 0)
+			break;
+
+		if (i == 0) {
+			d_tm_inc_counter(dtx_cont2metrics(cont)->dpm_act_throttled, 1);
+			D_DEBUG(DB_IO, "Throttle DTX for "DF_UUID", committable "DF_U64"\n",
+				DP_UUID(cont->sc_uuid), cont->sc_dtx_committable_count);
+		}
+
+		dmi = dss_get_module_info();
+		sched_req_wakeup(dmi->dmi_dtx_cmt_req);
+		dss_sleep(DTX_ACT_THROTTLE_INTV);
+	}
+}
+
 /**
  * Prepare the DTX handle in DRAM.
  *
@@ -1580,6 +1695,9 @@ dtx_cont_register(struct ds_cont_child *cont)
 	if (dbca == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
+	dbca->dbca_cmt_cnt_thd = DTX_THRESHOLD_COUNT;
+	dbca->dbca_cmt_age_thd = DTX_COMMIT_THRESHOLD_AGE;
+
 	memset(&uma, 0, sizeof(uma));
 	uma.uma_id = UMEM_CLASS_VMEM;
 	rc = dbtree_create_inplace_ex(DBTREE_CLASS_DTX_COS, 0,
@@ -1593,6 +1711,19 @@ dtx_cont_register(struct ds_cont_child *cont)
 		D_GOTO(out, rc = -DER_NOMEM);
 	}
 
+	rc = dbtree_create_inplace_ex(DBTREE_CLASS_DTX_COS_OBJ, 0,
+				      DTX_COS_BTREE_ORDER, &uma,
+				      &cont->sc_dtx_cos_obj_btr,
+				      DAOS_HDL_INVAL, cont,
+				      &cont->sc_dtx_cos_obj_hdl);
+	if (rc != 0) {
+		D_ERROR("Failed to create DTX CoS object btree: "DF_RC"\n",
+			DP_RC(rc));
+		dbtree_destroy(cont->sc_dtx_cos_hdl, NULL);
+		cont->sc_dtx_cos_hdl = DAOS_HDL_INVAL;
+		D_GOTO(out, rc = -DER_NOMEM);
+	}
+
 	cont->sc_dtx_committable_count = 0;
 	D_INIT_LIST_HEAD(&cont->sc_dtx_cos_list);
 	cont->sc_dtx_resync_ver = cont->sc_pool->spc_map_version;
@@ -14,6 +14,19 @@
 #include <daos_srv/vos.h>
 #include "dtx_internal.h"
 
+/* The record for the DTX CoS object B+tree in DRAM. Each record tracks the
+ * committable DTXs against the same object (regardless of the dkey), then
+ * fetching the committable DTXs for the given object does not need to scan
+ * the whole CoS cache.
+ */
+struct dtx_cos_obj {
+	daos_unit_oid_t		 dco_oid;
+	/* The dtx_cos_rec_child list ordered by epoch, via dcrc_obj_link. */
+	d_list_t		 dco_list;
+	/* The number of the DTXs in the dco_list. */
+	uint32_t		 dco_count;
+};
+
 /* The record for the DTX CoS B+tree in DRAM. Each record contains current
  * committable DTXs that modify (update or punch) something under the same
  * object and the same dkey.
@@ -21,6 +34,8 @@
 struct dtx_cos_rec {
 	daos_unit_oid_t		 dcr_oid;
 	uint64_t		 dcr_dkey_hash;
+	/* Pointer to the dtx_cos_obj for the same object. */
+	struct dtx_cos_obj	*dcr_obj;
 	/* The DTXs in the list only modify some SVT value or EVT value
 	 * (neither obj nor dkey/akey) that will not be shared by other
 	 * modifications.
@@ -50,10 +65,12 @@ struct dtx_cos_rec {
  * related object and dkey (that attached to the dtx_cos_rec).
  */
 struct dtx_cos_rec_child {
-	/* Link into the container::sc_dtx_cos_list. */
+	/* Link into the container::sc_dtx_cos_list, ordered by epoch. */
 	d_list_t		 dcrc_gl_committable;
-	/* Link into related dcr_{reg,prio}_list. */
+	/* Link into related dcr_{reg,prio,expcmt}_list. */
 	d_list_t		 dcrc_lo_link;
+	/* Link into related dco_list, ordered by epoch. */
+	d_list_t		 dcrc_obj_link;
 	/* The DTX identifier. */
 	struct dtx_entry	*dcrc_dte;
 	/* The DTX epoch. */
@@ -64,10 +81,106 @@ struct dtx_cos_rec_child {
 
 struct dtx_cos_rec_bundle {
 	struct dtx_entry	*dte;
+	struct dtx_cos_obj	*dco;
 	daos_epoch_t		 epoch;
 	uint32_t		 flags;
 };
 
+static int
+dtx_cos_obj_hkey_size(void)
+{
+	return sizeof(daos_unit_oid_t);
+}
+
+static void
+dtx_cos_obj_hkey_gen(struct btr_instance *tins, d_iov_t *key_iov, void *hkey)
+{
+	D_ASSERT(key_iov->iov_len == sizeof(daos_unit_oid_t));
+
+	memcpy(hkey, key_iov->iov_buf, key_iov->iov_len);
+}
+
+static int
+dtx_cos_obj_hkey_cmp(struct btr_instance *tins, struct btr_record *rec, void *hkey)
+{
+	int	rc;
+
+	rc = memcmp(&rec->rec_hkey[0], hkey, sizeof(daos_unit_oid_t));
+
+	return dbtree_key_cmp_rc(rc);
+}
+
+static int
+dtx_cos_obj_alloc(struct btr_instance *tins, d_iov_t *key_iov,
+		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
+{
+	struct dtx_cos_obj	*dco;
+
+	D_ASSERT(tins->ti_umm.umm_id == UMEM_CLASS_VMEM);
+
+	D_ALLOC_PTR(dco);
+	if (dco == NULL)
+		return -DER_NOMEM;
+
+	dco->dco_oid = *(daos_unit_oid_t *)key_iov->iov_buf;
+	D_INIT_LIST_HEAD(&dco->dco_list);
+
+	rec->rec_off = umem_ptr2off(&tins->ti_umm, dco);
+	if (val_out != NULL)
+		d_iov_set(val_out, dco, sizeof(*dco));
+
+	return 0;
+}
+
+static int
+dtx_cos_obj_free(struct btr_instance *tins, struct btr_record *rec, void *args)
+{
+	struct dtx_cos_obj	*dco;
+
+	D_ASSERT(tins->ti_umm.umm_id == UMEM_CLASS_VMEM);
+
+	dco = (struct dtx_cos_obj *)umem_off2ptr(&tins->ti_umm, rec->rec_off);
+	D_ASSERT(d_list_empty(&dco->dco_list));
+	D_FREE_PTR(dco);
+
+	return 0;
+}
+
+static int
+dtx_cos_obj_fetch(struct btr_instance *tins, struct btr_record *rec,
+		  d_iov_t *key_iov, d_iov_t *val_iov)
+{
+	struct dtx_cos_obj	*dco;
+
+	D_ASSERT(val_iov != NULL);
+
+	dco = (struct dtx_cos_obj *)umem_off2ptr(&tins->ti_umm, rec->rec_off);
+	d_iov_set(val_iov, dco, sizeof(struct dtx_cos_obj));
+
+	return 0;
+}
+
+static int
+dtx_cos_obj_update(struct btr_instance *tins, struct btr_record *rec,
+		   d_iov_t *key, d_iov_t *val, d_iov_t *val_out)
+{
+	if (val_out != NULL)
+		d_iov_set(val_out, umem_off2ptr(&tins->ti_umm, rec->rec_off),
+			  sizeof(struct dtx_cos_obj));
+
+	return 0;
+}
+
+btr_ops_t dtx_btr_cos_obj_ops = {
+	.to_hkey_size	= dtx_cos_obj_hkey_size,
+	.to_hkey_gen	= dtx_cos_obj_hkey_gen,
+	.to_hkey_cmp	= dtx_cos_obj_hkey_cmp,
+	.to_rec_alloc	= dtx_cos_obj_alloc,
+	.to_rec_free	= dtx_cos_obj_free,
+	.to_rec_fetch	= dtx_cos_obj_fetch,
+	.to_rec_update	= dtx_cos_obj_update,
+};
+
 static int
 dtx_cos_hkey_size(void)
 {
@@ -94,6 +207,67 @@ dtx_cos_hkey_cmp(struct btr_instance *tins, struct btr_record *rec, void *hkey)
 	return dbtree_key_cmp_rc(rc);
 }
 
+/* Add the DTX into the container's and the object's committable lists. Both
+ * lists are ordered by epoch, that makes dtx_cos_oldest() O(1) and allows the
+ * epoch based dtx_fetch_committable() to stop at the first newer DTX. Most of
+ * the DTXs arrive in epoch order, so the reverse scan stops very quickly.
+ */
+static void
+dtx_cos_rec_child_add(struct ds_cont_child *cont, struct dtx_cos_rec *dcr,
+		      struct dtx_cos_rec_child *dcrc, uint32_t flags)
+{
+	struct dtx_cos_obj		*dco = dcr->dcr_obj;
+	struct dtx_cos_rec_child	*tmp;
+	struct dtx_tls			*tls = dtx_tls_get();
+
+	d_list_for_each_entry_reverse(tmp, &cont->sc_dtx_cos_list, dcrc_gl_committable) {
+		if (tmp->dcrc_epoch <= dcrc->dcrc_epoch)
+			break;
+	}
+	d_list_add(&dcrc->dcrc_gl_committable, &tmp->dcrc_gl_committable);
+
+	d_list_for_each_entry_reverse(tmp, &dco->dco_list, dcrc_obj_link) {
+		if (tmp->dcrc_epoch <= dcrc->dcrc_epoch)
+			break;
+	}
+	d_list_add(&dcrc->dcrc_obj_link, &tmp->dcrc_obj_link);
+	dco->dco_count++;
+
+	cont->sc_dtx_committable_count++;
+	d_tm_inc_gauge(tls->dt_committable, 1);
+
+	if (flags & DCF_EXP_CMT) {
+		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_expcmt_list);
+		dcr->dcr_expcmt_count++;
+	} else if (flags & DCF_SHARED) {
+		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_prio_list);
+		dcr->dcr_prio_count++;
+	} else {
+		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_reg_list);
+		dcr->dcr_reg_count++;
+	}
+}
+
+/* Remove the DTX from all the CoS lists, the caller adjusts the dcr counter. */
+static void
+dtx_cos_rec_child_del(struct ds_cont_child *cont, struct dtx_cos_rec_child *dcrc)
+{
+	struct dtx_cos_obj	*dco = dcrc->dcrc_ptr->dcr_obj;
+	struct dtx_tls		*tls = dtx_tls_get();
+
+	d_list_del(&dcrc->dcrc_gl_committable);
+	d_list_del(&dcrc->dcrc_lo_link);
+	d_list_del(&dcrc->dcrc_obj_link);
+	dtx_entry_put(dcrc->dcrc_dte);
+	D_FREE_PTR(dcrc);
+
+	D_ASSERT(dco->dco_count > 0);
+	dco->dco_count--;
+
+	cont->sc_dtx_committable_count--;
+	d_tm_dec_gauge(tls->dt_committable, 1);
+}
+
 static int
 dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
@@ -103,7 +277,6 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	struct dtx_cos_rec_bundle	*rbund;
 	struct dtx_cos_rec		*dcr;
 	struct dtx_cos_rec_child	*dcrc;
-	struct dtx_tls			*tls = dtx_tls_get();
 
 	D_ASSERT(tins->ti_umm.umm_id == UMEM_CLASS_VMEM);
 
@@ -116,6 +289,7 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 
 	dcr->dcr_oid = key->oid;
 	dcr->dcr_dkey_hash = key->dkey_hash;
+	dcr->dcr_obj = rbund->dco;
 	D_INIT_LIST_HEAD(&dcr->dcr_reg_list);
 	D_INIT_LIST_HEAD(&dcr->dcr_prio_list);
 	D_INIT_LIST_HEAD(&dcr->dcr_expcmt_list);
@@ -129,22 +303,7 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	dcrc->dcrc_dte = dtx_entry_get(rbund->dte);
 	dcrc->dcrc_epoch = rbund->epoch;
 	dcrc->dcrc_ptr = dcr;
-
-	d_list_add_tail(&dcrc->dcrc_gl_committable,
-			&cont->sc_dtx_cos_list);
-	cont->sc_dtx_committable_count++;
-	d_tm_inc_gauge(tls->dt_committable, 1);
-
-	if (rbund->flags & DCF_EXP_CMT) {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_expcmt_list);
-		dcr->dcr_expcmt_count = 1;
-	} else if (rbund->flags & DCF_SHARED) {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_prio_list);
-		dcr->dcr_prio_count = 1;
-	} else {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_reg_list);
-		dcr->dcr_reg_count = 1;
-	}
+	dtx_cos_rec_child_add(cont, dcr, dcrc, rbund->flags);
 
 	rec->rec_off = umem_ptr2off(&tins->ti_umm, dcr);
 
@@ -158,43 +317,21 @@ dtx_cos_rec_free(struct btr_instance *tins, struct btr_record *rec, void *args)
 	struct dtx_cos_rec		*dcr;
 	struct dtx_cos_rec_child	*dcrc;
 	struct dtx_cos_rec_child	*next;
-	int				 dec = 0;
-	struct dtx_tls			*tls = dtx_tls_get();
 
 	D_ASSERT(tins->ti_umm.umm_id == UMEM_CLASS_VMEM);
 
 	dcr = (struct dtx_cos_rec *)umem_off2ptr(&tins->ti_umm, rec->rec_off);
 	d_list_for_each_entry_safe(dcrc, next, &dcr->dcr_reg_list,
-				   dcrc_lo_link) {
-		d_list_del(&dcrc->dcrc_lo_link);
-		d_list_del(&dcrc->dcrc_gl_committable);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-		dec++;
-	}
+				   dcrc_lo_link)
+		dtx_cos_rec_child_del(cont, dcrc);
 	d_list_for_each_entry_safe(dcrc, next, &dcr->dcr_prio_list,
-				   dcrc_lo_link) {
-		d_list_del(&dcrc->dcrc_lo_link);
-		d_list_del(&dcrc->dcrc_gl_committable);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-		dec++;
-	}
+				   dcrc_lo_link)
+		dtx_cos_rec_child_del(cont, dcrc);
 	d_list_for_each_entry_safe(dcrc, next, &dcr->dcr_expcmt_list,
-				   dcrc_lo_link) {
-		d_list_del(&dcrc->dcrc_lo_link);
-		d_list_del(&dcrc->dcrc_gl_committable);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-		dec++;
-	}
+				   dcrc_lo_link)
+		dtx_cos_rec_child_del(cont, dcrc);
 	D_FREE_PTR(dcr);
 
-	cont->sc_dtx_committable_count -= dec;
-
-	/** adjust per-pool counter */
-	d_tm_dec_gauge(tls->dt_committable, dec);
-
 	return 0;
 }
 
@@ -220,12 +357,12 @@ dtx_cos_rec_update(struct btr_instance *tins, struct btr_record *rec,
 	struct dtx_cos_rec_bundle	*rbund;
 	struct dtx_cos_rec		*dcr;
 	struct dtx_cos_rec_child	*dcrc;
-	struct dtx_tls			*tls = dtx_tls_get();
 
 	D_ASSERT(tins->ti_umm.umm_id == UMEM_CLASS_VMEM);
 
 	dcr = (struct dtx_cos_rec *)umem_off2ptr(&tins->ti_umm, rec->rec_off);
 	rbund = (struct dtx_cos_rec_bundle *)val->iov_buf;
+	D_ASSERT(dcr->dcr_obj == rbund->dco);
 
 	D_ALLOC_PTR(dcrc);
 	if (dcrc == NULL)
@@ -234,22 +371,7 @@ dtx_cos_rec_update(struct btr_instance *tins, struct btr_record *rec,
 	dcrc->dcrc_dte = dtx_entry_get(rbund->dte);
 	dcrc->dcrc_epoch = rbund->epoch;
 	dcrc->dcrc_ptr = dcr;
-
-	d_list_add_tail(&dcrc->dcrc_gl_committable,
-			&cont->sc_dtx_cos_list);
-	cont->sc_dtx_committable_count++;
-	d_tm_inc_gauge(tls->dt_committable, 1);
-
-	if (rbund->flags & DCF_EXP_CMT) {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_expcmt_list);
-		dcr->dcr_expcmt_count++;
-	} else if (rbund->flags & DCF_SHARED) {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_prio_list);
-		dcr->dcr_prio_count++;
-	} else {
-		d_list_add_tail(&dcrc->dcrc_lo_link, &dcr->dcr_reg_list);
-		dcr->dcr_reg_count++;
-	}
+	dtx_cos_rec_child_add(cont, dcr, dcrc, rbund->flags);
 
 	return 0;
 }
@@ -264,6 +386,22 @@ btr_ops_t dtx_btr_cos_ops = {
 	.to_rec_update	= dtx_cos_rec_update,
 };
 
+static void
+dtx_cos_obj_release(struct ds_cont_child *cont, struct dtx_cos_obj *dco)
+{
+	d_iov_t	kiov;
+	int	rc;
+
+	if (dco->dco_count != 0)
+		return;
+
+	d_iov_set(&kiov, &dco->dco_oid, sizeof(dco->dco_oid));
+	rc = dbtree_delete(cont->sc_dtx_cos_obj_hdl, BTR_PROBE_EQ, &kiov, NULL);
+	if (rc != 0)
+		D_ERROR("Failed to remove "DF_UOID" from CoS cache: "DF_RC"\n",
+			DP_UOID(dco->dco_oid), DP_RC(rc));
+}
+
 int
 dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 		      daos_unit_oid_t *oid, daos_epoch_t epoch,
@@ -272,10 +410,29 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 	struct dtx_entry		**dte_buf = NULL;
 	struct dtx_cos_key		 *dck_buf = NULL;
 	struct dtx_cos_rec_child	 *dcrc;
+	struct dtx_cos_obj		 *dco = NULL;
 	uint32_t			  count;
 	uint32_t			  i = 0;
 
-	count = min(cont->sc_dtx_committable_count, max_cnt);
+	if (oid != NULL) {
+		d_iov_t	kiov;
+		d_iov_t	riov;
+		int	rc;
+
+		d_iov_set(&kiov, oid, sizeof(*oid));
+		d_iov_set(&riov, NULL, 0);
+		rc = dbtree_lookup(cont->sc_dtx_cos_obj_hdl, &kiov, &riov);
+		if (rc != 0) {
+			*dtes = NULL;
+			return rc == -DER_NONEXIST ? 0 : rc;
+		}
+
+		dco = (struct dtx_cos_obj *)riov.iov_buf;
+		count = min(dco->dco_count, max_cnt);
+	} else {
+		count = min(cont->sc_dtx_committable_count, max_cnt);
+	}
+
 	if (count == 0) {
 		*dtes = NULL;
 		return 0;
@@ -291,20 +448,30 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 		return -DER_NOMEM;
 	}
 
-	d_list_for_each_entry(dcrc, &cont->sc_dtx_cos_list,
-			      dcrc_gl_committable) {
-		if (oid != NULL &&
-		    daos_unit_oid_compare(dcrc->dcrc_ptr->dcr_oid, *oid) != 0)
-			continue;
-
-		if (epoch < dcrc->dcrc_epoch)
-			continue;
-
-		dte_buf[i] = dtx_entry_get(dcrc->dcrc_dte);
-		dck_buf[i].oid = dcrc->dcrc_ptr->dcr_oid;
-		dck_buf[i].dkey_hash = dcrc->dcrc_ptr->dcr_dkey_hash;
-		if (++i >= count)
-			break;
+	/* Both lists are ordered by epoch, stop at the first newer one. */
+	if (dco != NULL) {
+		d_list_for_each_entry(dcrc, &dco->dco_list, dcrc_obj_link) {
+			if (epoch < dcrc->dcrc_epoch)
+				break;
+
+			dte_buf[i] = dtx_entry_get(dcrc->dcrc_dte);
+			dck_buf[i].oid = dco->dco_oid;
+			dck_buf[i].dkey_hash = dcrc->dcrc_ptr->dcr_dkey_hash;
+			if (++i >= count)
+				break;
+		}
+	} else {
+		d_list_for_each_entry(dcrc, &cont->sc_dtx_cos_list,
+				      dcrc_gl_committable) {
+			if (epoch < dcrc->dcrc_epoch)
+				break;
+
+			dte_buf[i] = dtx_entry_get(dcrc->dcrc_dte);
+			dck_buf[i].oid = dcrc->dcrc_ptr->dcr_oid;
+			dck_buf[i].dkey_hash = dcrc->dcrc_ptr->dcr_dkey_hash;
+			if (++i >= count)
+				break;
+		}
 	}
 
 	if (i == 0) {
@@ -319,9 +486,34 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 	return i;
 }
 
+/* Whether all the participants of the DTX are the targets of @mbs. */
+static bool
+dtx_cos_mbs_covered(struct dtx_memberships *dte_mbs, struct dtx_memberships *mbs)
+{
+	struct dtx_daos_target	*dte_tgts = (struct dtx_daos_target *)dte_mbs->dm_data;
+	struct dtx_daos_target	*tgts = (struct dtx_daos_target *)mbs->dm_data;
+	int			 i;
+	int			 j;
+
+	if (dte_mbs->dm_grp_cnt > 1 || dte_mbs->dm_tgt_cnt > mbs->dm_tgt_cnt)
+		return false;
+
+	for (i = 0; i < dte_mbs->dm_tgt_cnt; i++) {
+		for (j = 0; j < mbs->dm_tgt_cnt; j++) {
+			if (dte_tgts[i].ddt_id == tgts[j].ddt_id)
+				break;
+		}
+		if (j == mbs->dm_tgt_cnt)
+			return false;
+	}
+
+	return true;
+}
+
 int
 dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
-	     uint64_t dkey_hash, int max, struct dtx_id **dtis)
+	     uint64_t dkey_hash, uint32_t pm_ver, struct dtx_memberships *mbs,
+	     int max, struct dtx_id **dtis)
 {
 	struct dtx_cos_key		 key;
 	d_iov_t				 kiov;
@@ -330,6 +522,7 @@ dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 	struct dtx_cos_rec		*dcr = NULL;
 	struct dtx_cos_rec_child	*dcrc;
 	int				 count;
+	int				 reg;
 	int				 rc;
 	int				 i = 0;
 
@@ -343,30 +536,53 @@ dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 		return rc == -DER_NONEXIST ? 0 : rc;
 
 	dcr = (struct dtx_cos_rec *)riov.iov_buf;
-	if (dcr->dcr_prio_count == 0)
-		return 0;
 
 	/* There are too many priority DTXs to be committed, as to cannot be
 	 * piggybacked via normal dispatched RPC. Return the specified @max
 	 * DTXs. If some DTX in the left part caused current modification
 	 * failure (conflict), related RPC will be retried sometime later.
 	 */
-	if (dcr->dcr_prio_count > max)
-		count = max;
-	else
-		count = dcr->dcr_prio_count;
+	count = min(dcr->dcr_prio_count, max);
+
+	/* The regular DTXs under the same object/dkey whose participants are
+	 * all covered by current modification (@mbs) can be committed by the
+	 * dispatched RPC instead of the explicit DTX commit RPC. That is not
+	 * true for all of them, such as the distributed transaction against
+	 * multiple objects, so check each of them. They are limited to keep
+	 * the dispatched RPC small, the left ones will be committed next time
+	 * or by batched commit.
+	 */
+	reg = mbs != NULL ? min(dcr->dcr_reg_count, max - count) : 0;
+	reg = min(reg, (int)dtx_piggyback_max);
+	if (count + reg == 0)
+		return 0;
 
-	D_ALLOC_ARRAY(dti, count);
+	D_ALLOC_ARRAY(dti, count + reg);
 	if (dti == NULL)
 		return -DER_NOMEM;
 
-	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link)
+	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
+		if (i >= count)
+			break;
 		dti[i++] = dcrc->dcrc_dte->dte_xid;
+	}
+
+	d_list_for_each_entry(dcrc, &dcr->dcr_reg_list, dcrc_lo_link) {
+		if (i >= count + reg)
+			break;
+		if (dcrc->dcrc_dte->dte_ver == pm_ver &&
+		    dtx_cos_mbs_covered(dcrc->dcrc_dte->dte_mbs, mbs))
+			dti[i++] = dcrc->dcrc_dte->dte_xid;
+	}
+
+	if (i == 0) {
+		D_FREE(dti);
+		return 0;
+	}
 
-	D_ASSERT(i == count);
 	*dtis = dti;
 
-	return count;
+	return i;
 }
 
 int
@@ -376,6 +592,7 @@ dtx_add_cos(struct ds_cont_child *cont, struct dtx_entry *dte,
 {
 	struct dtx_cos_key		key;
 	struct dtx_cos_rec_bundle	rbund;
+	struct dtx_cos_obj		*dco;
 	d_iov_t				kiov;
 	d_iov_t				riov;
 	int				rc;
@@ -386,18 +603,31 @@ dtx_add_cos(struct ds_cont_child *cont, struct dtx_entry *dte,
 	D_ASSERT(dte->dte_mbs != NULL);
 	D_ASSERT(epoch != DAOS_EPOCH_MAX);
 
+	d_iov_set(&kiov, oid, sizeof(*oid));
+	d_iov_set(&riov, NULL, 0);
+	rc = dbtree_upsert(cont->sc_dtx_cos_obj_hdl, BTR_PROBE_EQ,
+			   DAOS_INTENT_UPDATE, &kiov, &riov, &riov);
+	if (rc != 0)
+		goto out;
+
+	dco = (struct dtx_cos_obj *)riov.iov_buf;
+
 	key.oid = *oid;
 	key.dkey_hash = dkey_hash;
 	d_iov_set(&kiov, &key, sizeof(key));
 
 	rbund.dte = dte;
+	rbund.dco = dco;
 	rbund.epoch = epoch;
 	rbund.flags = flags;
 	d_iov_set(&riov, &rbund, sizeof(rbund));
 
 	rc = dbtree_upsert(cont->sc_dtx_cos_hdl, BTR_PROBE_EQ,
 			   DAOS_INTENT_UPDATE, &kiov, &riov, NULL);
+	if (rc != 0)
+		dtx_cos_obj_release(cont, dco);
 
+out:
 	D_CDEBUG(rc != 0, DLOG_ERR, DB_IO, "Insert DTX "DF_DTI" to CoS "
 		 "cache, "DF_UOID", key %lu, flags %x: rc = "DF_RC"\n",
 		 DP_DTI(&dte->dte_xid), DP_UOID(*oid), (unsigned long)dkey_hash,
@@ -410,12 +640,12 @@ int
 dtx_del_cos(struct ds_cont_child *cont, struct dtx_id *xid,
 	    daos_unit_oid_t *oid, uint64_t dkey_hash)
 {
-	struct dtx_tls			*tls = dtx_tls_get();
 	struct dtx_cos_key		 key;
 	d_iov_t				 kiov;
 	d_iov_t				 riov;
 	struct dtx_cos_rec		*dcr;
 	struct dtx_cos_rec_child	*dcrc;
+	struct dtx_cos_obj		*dco = NULL;
 	int				 found = 0;
 	int				 rc;
 
@@ -429,19 +659,14 @@ dtx_del_cos(struct ds_cont_child *cont, struct dtx_id *xid,
 		goto out;
 
 	dcr = (struct dtx_cos_rec *)riov.iov_buf;
+	dco = dcr->dcr_obj;
 
 	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
 		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) != 0)
 			continue;
 
-		d_list_del(&dcrc->dcrc_gl_committable);
-		d_list_del(&dcrc->dcrc_lo_link);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-
-		cont->sc_dtx_committable_count--;
+		dtx_cos_rec_child_del(cont, dcrc);
 		dcr->dcr_prio_count--;
-		d_tm_dec_gauge(tls->dt_committable, 1);
 
 		D_GOTO(out, found = 1);
 	}
@@ -450,14 +675,8 @@ dtx_del_cos(struct ds_cont_child *cont, struct dtx_id *xid,
 		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) != 0)
 			continue;
 
-		d_list_del(&dcrc->dcrc_gl_committable);
-		d_list_del(&dcrc->dcrc_lo_link);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-
-		cont->sc_dtx_committable_count--;
+		dtx_cos_rec_child_del(cont, dcrc);
 		dcr->dcr_reg_count--;
-		d_tm_dec_gauge(tls->dt_committable, 1);
 
 		D_GOTO(out, found = 2);
 	}
@@ -466,14 +685,8 @@ dtx_del_cos(struct ds_cont_child *cont, struct dtx_id *xid,
 		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) != 0)
 			continue;
 
-		d_list_del(&dcrc->dcrc_gl_committable);
-		d_list_del(&dcrc->dcrc_lo_link);
-		dtx_entry_put(dcrc->dcrc_dte);
-		D_FREE_PTR(dcrc);
-
-		cont->sc_dtx_committable_count--;
+		dtx_cos_rec_child_del(cont, dcrc);
 		dcr->dcr_expcmt_count--;
-		d_tm_dec_gauge(tls->dt_committable, 1);
 
 		D_GOTO(out, found = 3);
 	}
@@ -484,6 +697,9 @@ out:
 		rc = dbtree_delete(cont->sc_dtx_cos_hdl, BTR_PROBE_EQ,
 				   &kiov, NULL);
 
+	if (found > 0)
+		dtx_cos_obj_release(cont, dco);
+
 	if (rc == 0 && found == 0)
 		rc = -DER_NONEXIST;
 
@@ -28,10 +28,14 @@
  * OPCODE, flags, FMT, handler, corpc_hdlr,
  */
 #define DTX_PROTO_SRV_RPC_LIST						\
-	X(DTX_COMMIT, 0, &CQF_dtx, dtx_handler, NULL, "dtx_commit")	\
-	X(DTX_ABORT, 0, &CQF_dtx, dtx_handler, NULL, "dtx_abort")	\
-	X(DTX_CHECK, 0, &CQF_dtx, dtx_handler, NULL, "dtx_check")	\
-	X(DTX_REFRESH, 0, &CQF_dtx, dtx_handler, NULL, "dtx_refresh")
+	X(DTX_COMMIT, DAOS_RPC_HIGH_PRIO, &CQF_dtx,			\
+	  dtx_handler, NULL, "dtx_commit")				\
+	X(DTX_ABORT, DAOS_RPC_HIGH_PRIO, &CQF_dtx,			\
+	  dtx_handler, NULL, "dtx_abort")				\
+	X(DTX_CHECK, DAOS_RPC_HIGH_PRIO, &CQF_dtx,			\
+	  dtx_handler, NULL, "dtx_check")				\
+	X(DTX_REFRESH, DAOS_RPC_HIGH_PRIO, &CQF_dtx,			\
+	  dtx_handler, NULL, "dtx_refresh")
 
 #define X(a, b, c, d, e, f) a,
 enum dtx_operation {
@@ -127,6 +131,41 @@ extern uint32_t dtx_agg_thd_age_up;
  */
 extern uint32_t dtx_agg_thd_age_lo;
 
+/* The bounds for the per-container batched commit thresholds that are adjusted
+ * by dtx_cmt_thd_adjust() according to the observed load:
+ *
+ * - Count: the committable DTXs count that triggers batched commit, also the
+ *	    max DTXs to be committed via one batched commit round. It grows when
+ *	    the container is busy and the commit is cheap (to save commit RPCs),
+ *	    and shrinks when the committable or active DTXs pile up.
+ *
+ * - Age:   the age (in second) of the oldest committable DTX that triggers
+ *	    batched commit. It shrinks when the commit is triggered by age (the
+ *	    container is idle), then the DTXs will not stay in active table for
+ *	    too long time, and grows back when the container is busy.
+ */
+#define DTX_CMT_THD_CNT_MIN	(DTX_THRESHOLD_COUNT >> 3)
+#define DTX_CMT_THD_CNT_MAX	(DTX_THRESHOLD_COUNT << 1)
+#define DTX_CMT_THD_AGE_MIN	1
+#define DTX_CMT_THD_AGE_MAX	DTX_COMMIT_THRESHOLD_AGE
+
+/* If the average latency (in microsecond) of batched commit exceeds such
+ * threshold, then do not enlarge the count threshold any more.
+ */
+#define DTX_CMT_LAT_HI		20000
+
+/* If the active DTX entries count for the container exceeds such threshold,
+ * then commit the DTXs more eagerly to release the active table.
+ */
+#define DTX_CMT_ACT_HI		(DTX_THRESHOLD_COUNT << 4)
+
+/* New leader DTXs against the container with too many active DTX entries
+ * (see DTX_ACT_QUOTA_HI) will wait for the batched commit in such interval
+ * (ms), for at most DTX_ACT_THROTTLE_MAX times.
+ */
+#define DTX_ACT_THROTTLE_INTV	10
+#define DTX_ACT_THROTTLE_MAX	20
+
 /* The threshold for using helper ULT when handle DTX RPC. */
 #define DTX_RPC_HELPER_THD_MAX	(~0U)
 #define DTX_RPC_HELPER_THD_MIN	18
@@ -134,10 +173,65 @@ extern uint32_t dtx_agg_thd_age_lo;
 
 extern uint32_t dtx_rpc_helper_thd;
 
+/* The max count of the regular committable DTXs that are piggybacked via one
+ * dispatched modification RPC, see dtx_list_cos().
+ *
+ * XXX: It is controlled via the environment "DTX_PIGGYBACK_MAX", 0 means
+ *	to commit regular DTXs only via (batched) DTX commit RPC.
+ */
+#define DTX_PIGGYBACK_MAX_DEF	32
+
+extern uint32_t dtx_piggyback_max;
+
+/* The max count of DTXs to be checked via one DTX_CHECK RPC during DTX resync. */
+#define DTX_CHECK_BATCH_MAX	64
+
+/* The max count of containers to be resynced concurrently on one target.
+ *
+ * XXX: It is controlled via the environment "DTX_RESYNC_PARALLEL".
+ */
+#define DTX_RESYNC_PARALLEL_MIN	1
+#define DTX_RESYNC_PARALLEL_MAX	64
+#define DTX_RESYNC_PARALLEL_DEF	8
+
+extern uint32_t dtx_resync_parallel;
+
+/* Whether to use the HLC uncertainty window tracked from the HLC offsets to
+ * other engines, instead of the maximum system clock offset, for the epoch
+ * uncertainty check.
+ *
+ * XXX: It is controlled via the environment "DTX_HLC_TRACKED".
+ */
+extern bool dtx_hlc_tracked;
+
 struct dtx_pool_metrics {
 	struct d_tm_node_t	*dpm_batched_degree;
 	struct d_tm_node_t	*dpm_batched_total;
 	struct d_tm_node_t	*dpm_total[DTX_PROTO_SRV_RPC_COUNT];
+	/* DTXs handled as leader, and the DTX commit RPCs sent for them */
+	struct d_tm_node_t	*dpm_leader_total;
+	struct d_tm_node_t	*dpm_commit_sent;
+	struct d_tm_node_t	*dpm_commit_ratio;
+	/* DTXs committed via dispatched modification RPC */
+	struct d_tm_node_t	*dpm_piggyback_total;
+	/* The latest batched commit thresholds and latency */
+	struct d_tm_node_t	*dpm_cmt_cnt_thd;
+	struct d_tm_node_t	*dpm_cmt_age_thd;
+	struct d_tm_node_t	*dpm_cmt_lat;
+	/* DTX resync progress: containers to be resynced, resynced, in resyncing,
+	 * and the estimated remaining time.
+	 */
+	struct d_tm_node_t	*dpm_resync_total;
+	struct d_tm_node_t	*dpm_resync_done;
+	struct d_tm_node_t	*dpm_resync_inflight;
+	struct d_tm_node_t	*dpm_resync_eta;
+	/* Operations that had to refresh the status of conflicting DTXs */
+	struct d_tm_node_t	*dpm_refresh;
+	/* The estimated size of the active DTX table, and the leader DTXs that
+	 * were throttled because of too many active DTX entries.
+	 */
+	struct d_tm_node_t	*dpm_act_bytes;
+	struct d_tm_node_t	*dpm_act_throttled;
 };
 
 /*
@@ -156,6 +250,12 @@ dtx_tls_get(void)
 	return dss_module_key_get(dss_tls_get(), &dtx_module_key);
 }
 
+static inline struct dtx_pool_metrics *
+dtx_cont2metrics(struct ds_cont_child *cont)
+{
+	return cont->sc_pool->spc_metrics[DAOS_DTX_MODULE];
+}
+
 static inline bool
 dtx_cont_opened(struct ds_cont_child *cont)
 {
@@ -165,6 +265,7 @@ dtx_cont_opened(struct ds_cont_child *cont)
 extern struct crt_proto_format dtx_proto_fmt;
 extern btr_ops_t dbtree_dtx_cf_ops;
 extern btr_ops_t dtx_btr_cos_ops;
+extern btr_ops_t dtx_btr_cos_obj_ops;
 
 /* dtx_common.c */
 int dtx_handle_reinit(struct dtx_handle *dth);
@@ -187,6 +288,8 @@ int dtx_commit(struct ds_cont_child *cont, struct dtx_entry **dtes,
 	       struct dtx_cos_key *dcks, int count);
 int dtx_check(struct ds_cont_child *cont, struct dtx_entry *dte,
 	      daos_epoch_t epoch);
+int dtx_check_batch(struct ds_cont_child *cont, struct dtx_entry **dtes,
+		    int count, int *rets);
 
 int dtx_refresh_internal(struct ds_cont_child *cont, int *check_count,
 			 d_list_t *check_list, d_list_t *cmt_list,
@@ -42,6 +42,8 @@ struct dtx_resync_args {
 				 for_discard:1;
 };
 
+uint32_t dtx_resync_parallel;
+
 static inline void
 dtx_dre_release(struct dtx_resync_head *drh, struct dtx_resync_entry *dre)
 {
@@ -51,6 +53,25 @@ dtx_dre_release(struct dtx_resync_head *drh, struct dtx_resync_entry *dre)
 		D_FREE(dre);
 }
 
+static inline void
+dtx_dre_move(struct dtx_resync_head *src, struct dtx_resync_head *dst,
+	     struct dtx_resync_entry *dre)
+{
+	src->drh_count--;
+	d_list_move_tail(&dre->dre_link, &dst->drh_list);
+	dst->drh_count++;
+}
+
+static inline void
+dtx_drh_release(struct dtx_resync_head *drh)
+{
+	struct dtx_resync_entry	*dre;
+
+	while ((dre = d_list_pop_entry(&drh->drh_list, struct dtx_resync_entry,
+				       dre_link)) != NULL)
+		dtx_dre_release(drh, dre);
+}
+
 static int
 dtx_resync_commit(struct ds_cont_child *cont,
 		  struct dtx_resync_head *drh, int count)
@@ -255,13 +276,13 @@ dtx_verify_groups(struct ds_pool *pool, struct dtx_memberships *mbs,
 	return 1;
 }
 
-int
-dtx_status_handle_one(struct ds_cont_child *cont, struct dtx_entry *dte,
-		      daos_epoch_t epoch, int *tgt_array, int *err)
+/* Decide how to handle the DTX based on its global status from dtx_check(). */
+static int
+dtx_status_decide(struct ds_cont_child *cont, struct dtx_entry *dte,
+		  daos_epoch_t epoch, int status, int *tgt_array, int *err)
 {
-	int	rc = 0;
+	int	rc = status;
 
-	rc = dtx_check(cont, dte, epoch);
 	switch (rc) {
 	case DTX_ST_COMMITTED:
 	case DTX_ST_COMMITTABLE:
@@ -366,6 +387,14 @@ out:
 	return rc;
 }
 
+int
+dtx_status_handle_one(struct ds_cont_child *cont, struct dtx_entry *dte,
+		      daos_epoch_t epoch, int *tgt_array, int *err)
+{
+	return dtx_status_decide(cont, dte, epoch, dtx_check(cont, dte, epoch),
+				 tgt_array, err);
+}
+
 static int
 dtx_status_handle(struct dtx_resync_args *dra)
 {
@@ -374,11 +403,21 @@ dtx_status_handle(struct dtx_resync_args *dra)
 	struct dtx_resync_entry		*dre;
 	struct dtx_resync_entry		*next;
 	struct ds_pool			*pool = cont->sc_pool->spc_pool;
+	struct dtx_entry		*dtes[DTX_CHECK_BATCH_MAX];
+	int				 rets[DTX_CHECK_BATCH_MAX];
+	struct dtx_resync_head		 chk;
+	struct dtx_resync_head		 cmt;
 	int				*tgt_array = NULL;
 	int				 tgt_cnt;
 	int				 count = 0;
 	int				 err = 0;
 	int				 rc;
+	int				 i;
+
+	D_INIT_LIST_HEAD(&chk.drh_list);
+	chk.drh_count = 0;
+	D_INIT_LIST_HEAD(&cmt.drh_list);
+	cmt.drh_count = 0;
 
 	if (drh->drh_count == 0)
 		goto out;
@@ -409,58 +448,90 @@ dtx_status_handle(struct dtx_resync_args *dra)
 	if (tgt_array == NULL)
 		D_GOTO(out, err = -DER_NOMEM);
 
-	d_list_for_each_entry_safe(dre, next, &drh->drh_list, dre_link) {
+	/* The DTXs to be checked are collected and sent to each related server via
+	 * single DTX_CHECK RPC, then the new leader will not wait for the remote
+	 * replies one by one. The DTXs to be committed are moved to the @cmt list
+	 * and committed in batch.
+	 */
+	while (!d_list_empty(&drh->drh_list)) {
 		if (!dtx_cont_opened(cont))
 			goto out;
 
-		if (dre->dre_dte.dte_mbs->dm_dte_flags & DTE_LEADER)
-			goto commit;
+		while (chk.drh_count < DTX_CHECK_BATCH_MAX &&
+		       cmt.drh_count < DTX_THRESHOLD_COUNT && !d_list_empty(&drh->drh_list)) {
+			dre = d_list_entry(drh->drh_list.next, struct dtx_resync_entry,
+					   dre_link);
+
+			if (dre->dre_dte.dte_mbs->dm_dte_flags & DTE_LEADER)
+				goto commit;
+
+			rc = dtx_is_leader(pool, dra, dre);
+			if (rc <= 0) {
+				if (rc < 0)
+					D_WARN("Not sure about the leader for the DTX "
+					       DF_DTI" (ver = %u): rc = %d, skip it.\n",
+					       DP_DTI(&dre->dre_xid), dra->version, rc);
+				else
+					D_DEBUG(DB_TRACE, "Not the leader for the DTX "
+						DF_DTI" (ver = %u) skip it.\n",
+						DP_DTI(&dre->dre_xid), dra->version);
+				dtx_dre_release(drh, dre);
+				continue;
+			}
 
-		rc = dtx_is_leader(pool, dra, dre);
-		if (rc <= 0) {
-			if (rc < 0)
-				D_WARN("Not sure about the leader for the DTX "
-				       DF_DTI" (ver = %u): rc = %d, skip it.\n",
-				       DP_DTI(&dre->dre_xid), dra->version, rc);
-			else
-				D_DEBUG(DB_TRACE, "Not the leader for the DTX "
-					DF_DTI" (ver = %u) skip it.\n",
-					DP_DTI(&dre->dre_xid), dra->version);
-			dtx_dre_release(drh, dre);
+			dtes[chk.drh_count] = &dre->dre_dte;
+			dtx_dre_move(drh, &chk, dre);
 			continue;
-		}
 
-		rc = dtx_status_handle_one(cont, &dre->dre_dte, dre->dre_epoch,
-					   tgt_array, &err);
-		switch (rc) {
-		case DSHR_NEED_COMMIT:
-			goto commit;
-		case DSHR_NEED_RETRY:
-			d_list_del(&dre->dre_link);
-			d_list_add_tail(&dre->dre_link, &drh->drh_list);
-			continue;
-		case DSHR_IGNORE:
-		case DSHR_ABORT_FAILED:
-		case DSHR_CORRUPT:
-		default:
-			dtx_dre_release(drh, dre);
-			continue;
+commit:
+			D_DEBUG(DB_TRACE, "As the new leader for TX "
+				DF_DTI", try to commit it.\n", DP_DTI(&dre->dre_xid));
+			dtx_dre_move(drh, &cmt, dre);
 		}
 
-commit:
-		D_DEBUG(DB_TRACE, "As the new leader for TX "
-			DF_DTI", try to commit it.\n", DP_DTI(&dre->dre_xid));
+		if (chk.drh_count > 0) {
+			dtx_check_batch(cont, dtes, chk.drh_count, rets);
+
+			i = 0;
+			d_list_for_each_entry_safe(dre, next, &chk.drh_list, dre_link) {
+				rc = rets[i++];
+				/* The remote server does not support batched check. */
+				if (rc == -DER_PROTO)
+					rc = dtx_check(cont, &dre->dre_dte, dre->dre_epoch);
+
+				rc = dtx_status_decide(cont, &dre->dre_dte, dre->dre_epoch, rc,
+						       tgt_array, &err);
+				switch (rc) {
+				case DSHR_NEED_COMMIT:
+					D_DEBUG(DB_TRACE, "As the new leader for TX "
+						DF_DTI", try to commit it.\n",
+						DP_DTI(&dre->dre_xid));
+					dtx_dre_move(&chk, &cmt, dre);
+					break;
+				case DSHR_NEED_RETRY:
+					dtx_dre_move(&chk, drh, dre);
+					break;
+				case DSHR_IGNORE:
+				case DSHR_ABORT_FAILED:
+				case DSHR_CORRUPT:
+				default:
+					dtx_dre_release(&chk, dre);
+					break;
+				}
+			}
 
-		if (++count >= DTX_THRESHOLD_COUNT) {
-			rc = dtx_resync_commit(cont, drh, count);
+			D_ASSERT(chk.drh_count == 0);
+		}
+
+		if (cmt.drh_count >= DTX_THRESHOLD_COUNT) {
+			rc = dtx_resync_commit(cont, &cmt, cmt.drh_count);
 			if (rc < 0)
 				err = rc;
-			count = 0;
 		}
 	}
 
-	if (count > 0) {
-		rc = dtx_resync_commit(cont, drh, count);
+	if (cmt.drh_count > 0) {
+		rc = dtx_resync_commit(cont, &cmt, cmt.drh_count);
 		if (rc < 0)
 			err = rc;
 	}
@@ -468,9 +539,9 @@ commit:
 out:
 	D_FREE(tgt_array);
 
-	while ((dre = d_list_pop_entry(&drh->drh_list, struct dtx_resync_entry,
-				       dre_link)) != NULL)
-		dtx_dre_release(drh, dre);
+	dtx_drh_release(drh);
+	dtx_drh_release(&chk);
+	dtx_drh_release(&cmt);
 
 	if (err >= 0 && dtx_cont_opened(cont) && !dra->for_discard)
 		/* Drain old committable DTX to help subsequent rebuild. */
@@ -697,17 +768,91 @@ out:
 }
 
 struct dtx_container_scan_arg {
-	uuid_t			co_uuid;
-	struct dtx_scan_args	arg;
+	uuid_t			 co_uuid;
+	struct dtx_scan_args	 arg;
+	/* For resyncing the containers concurrently. */
+	ABT_mutex		 mutex;
+	ABT_cond		 cond;
+	struct dtx_pool_metrics	*dpm;
+	uint64_t		 start;
+	uint32_t		 total;
+	uint32_t		 done;
+	uint32_t		 inflight;
+	int			 result;
 };
 
+struct dtx_cont_resync_arg {
+	struct dtx_container_scan_arg	*scan_arg;
+	daos_handle_t			 po_hdl;
+	uuid_t				 co_uuid;
+};
+
+/* Publish the resync progress, the remaining time is estimated via the average
+ * time of the containers that have been resynced.
+ */
+static void
+dtx_resync_progress(struct dtx_container_scan_arg *scan_arg)
+{
+	struct dtx_pool_metrics	*dpm = scan_arg->dpm;
+	uint64_t		 eta = 0;
+
+	if (dpm == NULL)
+		return;
+
+	if (scan_arg->done > 0 && scan_arg->total > scan_arg->done)
+		eta = (daos_gettime_coarse() - scan_arg->start) *
+		      (scan_arg->total - scan_arg->done) / scan_arg->done;
+
+	d_tm_set_gauge(dpm->dpm_resync_total, scan_arg->total);
+	d_tm_set_gauge(dpm->dpm_resync_done, scan_arg->done);
+	d_tm_set_gauge(dpm->dpm_resync_inflight, scan_arg->inflight);
+	d_tm_set_gauge(dpm->dpm_resync_eta, eta);
+}
+
+static void
+dtx_resync_cont_ult(void *data)
+{
+	struct dtx_cont_resync_arg	*dcra = data;
+	struct dtx_container_scan_arg	*scan_arg = dcra->scan_arg;
+	int				 rc;
+
+	rc = dtx_resync(dcra->po_hdl, scan_arg->arg.pool_uuid, dcra->co_uuid,
+			scan_arg->arg.version, true, false);
+	if (rc)
+		D_ERROR(DF_UUID"/"DF_UUID" dtx resync failed: rc %d\n",
+			DP_UUID(scan_arg->arg.pool_uuid), DP_UUID(dcra->co_uuid), rc);
+
+	ABT_mutex_lock(scan_arg->mutex);
+	if (rc != 0 && scan_arg->result == 0)
+		scan_arg->result = rc;
+	scan_arg->inflight--;
+	scan_arg->done++;
+	dtx_resync_progress(scan_arg);
+	ABT_cond_broadcast(scan_arg->cond);
+	ABT_mutex_unlock(scan_arg->mutex);
+
+	D_FREE(dcra);
+}
+
+static int
+container_count_cb(daos_handle_t ih, vos_iter_entry_t *entry,
+		   vos_iter_type_t type, vos_iter_param_t *iter_param,
+		   void *data, unsigned *acts)
+{
+	struct dtx_container_scan_arg	*scan_arg = data;
+
+	scan_arg->total++;
+
+	return 0;
+}
+
 static int
 container_scan_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 		  vos_iter_type_t type, vos_iter_param_t *iter_param,
 		  void *data, unsigned *acts)
 {
 	struct dtx_container_scan_arg	*scan_arg = data;
-	struct dtx_scan_args		*arg = &scan_arg->arg;
+	struct dtx_cont_resync_arg	*dcra;
 	int				rc;
 
 	if (uuid_compare(scan_arg->co_uuid, entry->ie_couuid) == 0) {
@@ -717,16 +862,46 @@ container_scan_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 	}
 
 	uuid_copy(scan_arg->co_uuid, entry->ie_couuid);
-	rc = dtx_resync(iter_param->ip_hdl, arg->pool_uuid, entry->ie_couuid,
-			arg->version, true, false);
-	if (rc)
-		D_ERROR(DF_UUID" dtx resync failed: rc %d\n",
-			DP_UUID(arg->pool_uuid), rc);
+
+	D_ALLOC_PTR(dcra);
+	if (dcra == NULL)
+		return -DER_NOMEM;
+
+	dcra->scan_arg = scan_arg;
+	dcra->po_hdl = iter_param->ip_hdl;
+	uuid_copy(dcra->co_uuid, entry->ie_couuid);
+
+	/* Resync the containers concurrently, at most dtx_resync_parallel ones. */
+	ABT_mutex_lock(scan_arg->mutex);
+	while (scan_arg->inflight >= dtx_resync_parallel)
+		ABT_cond_wait(scan_arg->cond, scan_arg->mutex);
+
+	rc = scan_arg->result;
+	if (rc == 0)
+		scan_arg->inflight++;
+	ABT_mutex_unlock(scan_arg->mutex);
+
+	if (rc != 0) {
+		D_FREE(dcra);
+		return rc;
+	}
+
+	rc = dss_ult_create(dtx_resync_cont_ult, dcra, DSS_XS_SELF, 0,
+			    DSS_DEEP_STACK_SZ, NULL);
+	if (rc != 0) {
+		D_ERROR(DF_UUID"/"DF_UUID" failed to create dtx resync ULT: rc %d\n",
+			DP_UUID(scan_arg->arg.pool_uuid), DP_UUID(entry->ie_couuid), rc);
+		ABT_mutex_lock(scan_arg->mutex);
+		scan_arg->inflight--;
+		ABT_mutex_unlock(scan_arg->mutex);
+		D_FREE(dcra);
+		return rc;
+	}
 
 	/* Since dtx_resync might yield, let's reprobe anyway */
 	*acts |= VOS_ITER_CB_YIELD;
 
-	return rc;
+	return 0;
 }
 
 static int
@@ -743,12 +918,43 @@ dtx_resync_one(void *data)
 	if (child == NULL)
 		D_GOTO(out, rc = -DER_NONEXIST);
 
+	rc = ABT_mutex_create(&cb_arg.mutex);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(put, rc = dss_abterr2der(rc));
+
+	rc = ABT_cond_create(&cb_arg.cond);
+	if (rc != ABT_SUCCESS) {
+		ABT_mutex_free(&cb_arg.mutex);
+		D_GOTO(put, rc = dss_abterr2der(rc));
+	}
+
 	cb_arg.arg = *arg;
+	cb_arg.dpm = child->spc_metrics[DAOS_DTX_MODULE];
+	cb_arg.start = daos_gettime_coarse();
 	param.ip_hdl = child->spc_hdl;
 	param.ip_flags = VOS_IT_FOR_MIGRATION;
+
+	/* Count the containers firstly for estimating the resync progress. */
+	vos_iterate(&param, VOS_ITER_COUUID, false, &anchor, container_count_cb, NULL,
+		    &cb_arg, NULL);
+	dtx_resync_progress(&cb_arg);
+
+	memset(&anchor, 0, sizeof(anchor));
 	rc = vos_iterate(&param, VOS_ITER_COUUID, false, &anchor,
 			 container_scan_cb, NULL, &cb_arg, NULL);
 
+	/* Wait for all the in-flight containers resync. */
+	ABT_mutex_lock(cb_arg.mutex);
+	while (cb_arg.inflight > 0)
+		ABT_cond_wait(cb_arg.cond, cb_arg.mutex);
+	ABT_mutex_unlock(cb_arg.mutex);
+
+	if (rc == 0)
+		rc = cb_arg.result;
+
+	ABT_cond_free(&cb_arg.cond);
+	ABT_mutex_free(&cb_arg.mutex);
+put:
 	ds_pool_child_put(child);
 out:
 	D_DEBUG(DB_TRACE, DF_UUID" iterate pool done: rc %d\n",
@@ -13,6 +13,7 @@
 #include <daos/btree.h>
 #include <daos/pool_map.h>
 #include <daos/btree_class.h>
+#include <gurt/telemetry_consumer.h>
 #include <daos_srv/vos.h>
 #include <daos_srv/dtx_srv.h>
 #include <daos_srv/container.h>
@@ -64,6 +65,8 @@ struct dtx_req_args {
 	d_list_t			*dra_abt_list;
 	/* Pointer to the active DTX list, used for DTX_REFRESH case. */
 	d_list_t			*dra_act_list;
+	/* The per-DTX status array, used for batched DTX_CHECK case. */
+	int				*dra_check_rets;
 };
 
 /* The record for the DTX classify-tree in DRAM.
@@ -82,6 +85,7 @@ struct dtx_req_rec {
 	uint32_t			 drr_comp:1;
 	struct dtx_id			*drr_dti; /* The DTX array */
 	struct dtx_share_peer		**drr_cb_args; /* Used by dtx_req_cb. */
+	int				*drr_idx; /* DTX index for batched DTX_CHECK. */
 };
 
 struct dtx_cf_rec_bundle {
@@ -102,6 +106,8 @@ struct dtx_cf_rec_bundle {
 	 * the dtx_req_rec::drr_dti array size when allocating it.
 	 */
 	int				 dcrb_count;
+	/* The index of current DTX in the classified array, -1 if not required. */
+	int				 dcrb_idx;
 };
 
 /* Make sure that the "dcrb_key" is consisted of "dcrb_rank" + "dcrb_tag". */
@@ -111,6 +117,38 @@ D_CASSERT(sizeof(((struct dtx_cf_rec_bundle *)0)->dcrb_rank) +
 
 uint32_t dtx_rpc_helper_thd;
 
+/* Merge the DTX_CHECK result from one target into the DTX status. */
+static void
+dtx_check_merge(int *status, int ret)
+{
+	switch (ret) {
+	case DTX_ST_COMMITTED:
+	case DTX_ST_COMMITTABLE:
+		/* As long as one target has committed the DTX,
+		 * then the DTX is committable on all targets.
+		 */
+		*status = DTX_ST_COMMITTED;
+		break;
+	case -DER_EXCLUDED:
+		/* If non-leader is excluded, handle it
+		 * as 'prepared'. If other non-leaders
+		 * also 'prepared' then related DTX is
+		 * committable. Fall through.
+		 */
+	case DTX_ST_PREPARED:
+		if (*status == 0 || *status == DTX_ST_CORRUPTED)
+			*status = ret;
+		break;
+	case DTX_ST_CORRUPTED:
+		if (*status == 0)
+			*status = ret;
+		break;
+	default:
+		*status = ret >= 0 ? -DER_IO : ret;
+		break;
+	}
+}
+
 static void
 dtx_req_cb(const struct crt_cb_info *cb_info)
 {
@@ -128,9 +166,26 @@ dtx_req_cb(const struct crt_cb_info *cb_info)
 		goto out;
 
 	dout = crt_reply_get(req);
-	if (dout->do_status != 0 || dra->dra_opc != DTX_REFRESH)
+	if (dout->do_status != 0)
 		D_GOTO(out, rc = dout->do_status);
 
+	if (dra->dra_opc == DTX_CHECK && dra->dra_check_rets != NULL) {
+		if (din->di_dtx_array.ca_count != dout->do_sub_rets.ca_count)
+			D_GOTO(out, rc = -DER_PROTO);
+
+		for (i = 0; i < dout->do_sub_rets.ca_count; i++) {
+			int	*status = &dra->dra_check_rets[drr->drr_idx[i]];
+
+			if (*status != DTX_ST_COMMITTED)
+				dtx_check_merge(status, *((int *)dout->do_sub_rets.ca_arrays + i));
+		}
+
+		goto out;
+	}
+
+	if (dra->dra_opc != DTX_REFRESH)
+		goto out;
+
 	if (din->di_dtx_array.ca_count != dout->do_sub_rets.ca_count)
 		D_GOTO(out, rc = -DER_PROTO);
 
@@ -273,40 +328,37 @@ dtx_req_list_cb(void **args)
 	struct dtx_req_args	*dra = drr->drr_parent;
 	int			 i;
 
-	if (dra->dra_opc == DTX_CHECK) {
+	if (dra->dra_opc == DTX_CHECK && dra->dra_check_rets != NULL) {
+		/* The per-DTX status has been merged via dtx_req_cb, only the failed
+		 * sub-requests need to be merged into all the related DTXs here.
+		 */
 		for (i = 0; i < dra->dra_length; i++) {
+			int	j;
+
 			drr = args[i];
-			switch (drr->drr_result) {
-			case DTX_ST_COMMITTED:
-			case DTX_ST_COMMITTABLE:
-				dra->dra_result = DTX_ST_COMMITTED;
-				/* As long as one target has committed the DTX,
-				 * then the DTX is committable on all targets.
-				 */
+			if (drr->drr_result == 0)
+				continue;
+
+			for (j = 0; j < drr->drr_count; j++) {
+				if (dra->dra_check_rets[drr->drr_idx[j]] != DTX_ST_COMMITTED)
+					dtx_check_merge(&dra->dra_check_rets[drr->drr_idx[j]],
+							drr->drr_result);
+			}
+
+			D_DEBUG(DB_TRACE, "The batched DTX check RPC to %d/%d for %d DTXs "
+				"failed: %d.\n", drr->drr_rank, drr->drr_tag, drr->drr_count,
+				drr->drr_result);
+		}
+	} else if (dra->dra_opc == DTX_CHECK) {
+		for (i = 0; i < dra->dra_length; i++) {
+			drr = args[i];
+			dtx_check_merge(&dra->dra_result, drr->drr_result);
+			if (dra->dra_result == DTX_ST_COMMITTED) {
 				D_DEBUG(DB_TRACE,
 					"The DTX "DF_DTI" has been committed "
 					"on %d/%d.\n", DP_DTI(drr->drr_dti),
 					drr->drr_rank, drr->drr_tag);
 				return;
-			case -DER_EXCLUDED:
-				/* If non-leader is excluded, handle it
-				 * as 'prepared'. If other non-leaders
-				 * also 'prepared' then related DTX is
-				 * committable. Fall through.
-				 */
-			case DTX_ST_PREPARED:
-				if (dra->dra_result == 0 ||
-				    dra->dra_result == DTX_ST_CORRUPTED)
-					dra->dra_result = drr->drr_result;
-				break;
-			case DTX_ST_CORRUPTED:
-				if (dra->dra_result == 0)
-					dra->dra_result = drr->drr_result;
-				break;
-			default:
-				dra->dra_result = drr->drr_result >= 0 ?
-					-DER_IO : drr->drr_result;
-				break;
 			}
 
 			D_DEBUG(DB_TRACE, "The DTX "DF_DTI" RPC req result %d, "
@@ -424,6 +476,17 @@ dtx_cf_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		return -DER_NOMEM;
 	}
 
+	if (dcrb->dcrb_idx >= 0) {
+		D_ALLOC_ARRAY(drr->drr_idx, dcrb->dcrb_count);
+		if (drr->drr_idx == NULL) {
+			D_FREE(drr->drr_dti);
+			D_FREE(drr);
+			return -DER_NOMEM;
+		}
+
+		drr->drr_idx[0] = dcrb->dcrb_idx;
+	}
+
 	drr->drr_rank = dcrb->dcrb_rank;
 	drr->drr_tag = dcrb->dcrb_tag;
 	drr->drr_count = 1;
@@ -446,6 +509,7 @@ dtx_cf_rec_free(struct btr_instance *tins, struct btr_record *rec, void *args)
 	drr = (struct dtx_req_rec *)umem_off2ptr(&tins->ti_umm, rec->rec_off);
 	d_list_del(&drr->drr_link);
 	D_FREE(drr->drr_cb_args);
+	D_FREE(drr->drr_idx);
 	D_FREE(drr->drr_dti);
 	D_FREE(drr);
 
@@ -475,6 +539,8 @@ dtx_cf_rec_update(struct btr_instance *tins, struct btr_record *rec,
 			    dcrb->dcrb_dti)) {
 		D_ASSERT(drr->drr_count < dcrb->dcrb_count);
 
+		if (drr->drr_idx != NULL)
+			drr->drr_idx[drr->drr_count] = dcrb->dcrb_idx;
 		drr->drr_dti[drr->drr_count++] = *dcrb->dcrb_dti;
 	}
 
@@ -492,7 +558,8 @@ btr_ops_t dbtree_dtx_cf_ops = {
 
 static int
 dtx_classify_one(struct ds_pool *pool, daos_handle_t tree, d_list_t *head,
-		 int *length, struct dtx_entry *dte, int count, d_rank_t my_rank, uint32_t my_tgtid)
+		 int *length, struct dtx_entry *dte, int count, int idx, d_rank_t my_rank,
+		 uint32_t my_tgtid)
 {
 	struct dtx_memberships		*mbs = dte->dte_mbs;
 	struct dtx_cf_rec_bundle	 dcrb;
@@ -504,6 +571,7 @@ dtx_classify_one(struct ds_pool *pool, daos_handle_t tree, d_list_t *head,
 
 	if (daos_handle_is_valid(tree)) {
 		dcrb.dcrb_count = count;
+		dcrb.dcrb_idx = idx;
 		dcrb.dcrb_dti = &dte->dte_xid;
 		dcrb.dcrb_head = head;
 		dcrb.dcrb_length = length;
@@ -569,6 +637,25 @@ dtx_classify_one(struct ds_pool *pool, daos_handle_t tree, d_list_t *head,
 	return rc > 0 ? 0 : rc;
 }
 
+/* Account the DTX commit RPCs against the DTXs handled as leader, the ratio shows
+ * how many explicit commit RPCs are still needed after the CoS piggyback.
+ */
+static void
+dtx_commit_sent_stat(struct ds_cont_child *cont, int length)
+{
+	struct dtx_pool_metrics	*dpm = dtx_cont2metrics(cont);
+	uint64_t		 sent = 0;
+	uint64_t		 total = 0;
+
+	d_tm_inc_counter(dpm->dpm_commit_sent, length);
+	if (d_tm_get_counter(NULL, &sent, dpm->dpm_commit_sent) != DER_SUCCESS ||
+	    d_tm_get_counter(NULL, &total, dpm->dpm_leader_total) != DER_SUCCESS ||
+	    total == 0)
+		return;
+
+	d_tm_set_gauge(dpm->dpm_commit_ratio, sent * 100 / total);
+}
+
 static int
 dtx_rpc_internal(struct ds_cont_child *cont, d_list_t *head, struct btr_root *tree_root,
 		 daos_handle_t *tree_hdl, struct dtx_req_args *dra, struct dtx_id dtis[],
@@ -597,6 +684,7 @@ dtx_rpc_internal(struct ds_cont_child *cont, d_list_t *head, struct btr_root *tr
 	ABT_rwlock_rdlock(pool->sp_lock);
 	for (i = 0; i < count; i++) {
 		rc = dtx_classify_one(pool, *tree_hdl, head, &length, dtes[i], count,
+				      opc == DTX_CHECK && dra->dra_check_rets != NULL ? i : -1,
 				      my_rank, my_tgtid);
 		if (rc < 0) {
 			ABT_rwlock_unlock(pool->sp_lock);
@@ -616,6 +704,9 @@ dtx_rpc_internal(struct ds_cont_child *cont, d_list_t *head, struct btr_root *tr
 
 	D_ASSERT(length > 0);
 
+	if (opc == DTX_COMMIT)
+		dtx_commit_sent_stat(cont, length);
+
 	return dtx_req_list_send(dra, opc, head, length, pool->sp_uuid,
 				 cont->sc_uuid, epoch, NULL, NULL, NULL, NULL);
 }
@@ -866,6 +957,7 @@ dtx_check(struct ds_cont_child *cont, struct dtx_entry *dte, daos_epoch_t epoch)
 	if (dte->dte_mbs->dm_tgt_cnt == 1)
 		return DTX_ST_PREPARED;
 
+	dra.dra_check_rets = NULL;
 	rc = dtx_rpc_prep(cont, &head, &tree_root, &tree_hdl, &dra, &helper, NULL,
 			  &dte, epoch, 1, DTX_CHECK);
 
@@ -877,6 +969,60 @@ dtx_check(struct ds_cont_child *cont, struct dtx_entry *dte, daos_epoch_t epoch)
 	return rc1;
 }
 
+/**
+ * Check the given DTX array globally, used by DTX resync.
+ *
+ * Similar as dtx_check(), but the DTXs to be checked on the same server (rank + tag)
+ * are sent via single DTX_CHECK RPC. The status of each DTX is returned via \a rets.
+ * If the remote server does not support batched check, related DTX status will be
+ * -DER_PROTO, then the caller needs to check it via dtx_check() again.
+ */
+int
+dtx_check_batch(struct ds_cont_child *cont, struct dtx_entry **dtes, int count, int *rets)
+{
+	d_list_t		head;
+	struct btr_root		tree_root = { 0 };
+	daos_handle_t		tree_hdl = DAOS_HDL_INVAL;
+	struct dtx_req_args	dra;
+	ABT_thread		helper = ABT_THREAD_NULL;
+	int			rc;
+	int			i;
+
+	D_ASSERT(count > 0 && count <= DTX_CHECK_BATCH_MAX);
+
+	if (count == 1) {
+		rets[0] = dtx_check(cont, dtes[0], 0);
+		return 0;
+	}
+
+	for (i = 0; i < count; i++)
+		rets[i] = 0;
+
+	dra.dra_check_rets = rets;
+	/* The epoch is not used by DTX_CHECK. */
+	rc = dtx_rpc_prep(cont, &head, &tree_root, &tree_hdl, &dra, &helper, NULL,
+			  dtes, 0, count, DTX_CHECK);
+
+	rc = dtx_rpc_post(&head, tree_hdl, &dra, &helper, rc);
+	if (rc < 0) {
+		D_ERROR("Check %d DTXs from "DF_DTI": "DF_RC"\n",
+			count, DP_DTI(&dtes[0]->dte_xid), DP_RC(rc));
+		for (i = 0; i < count; i++)
+			rets[i] = rc;
+		return rc;
+	}
+
+	/* No other available target for the DTX, then current target is the unique
+	 * valid one (and also 'prepared'), then related DTX can be committed.
+	 */
+	for (i = 0; i < count; i++) {
+		if (rets[i] == 0)
+			rets[i] = DTX_ST_PREPARED;
+	}
+
+	return 0;
+}
+
 int
 dtx_refresh_internal(struct ds_cont_child *cont, int *check_count,
 		     d_list_t *check_list, d_list_t *cmt_list,
@@ -1091,6 +1237,8 @@ dtx_refresh(struct dtx_handle *dth, struct ds_cont_child *cont)
 	if (DAOS_FAIL_CHECK(DAOS_DTX_NO_RETRY))
 		return -DER_IO;
 
+	d_tm_inc_counter(dtx_cont2metrics(cont)->dpm_refresh, 1);
+
 	rc = dtx_refresh_internal(cont, &dth->dth_share_tbd_count,
 				  &dth->dth_share_tbd_list,
 				  &dth->dth_share_cmt_list,
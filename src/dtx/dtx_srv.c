@@ -95,6 +95,106 @@ dtx_metrics_alloc(const char *path, int tgt_id)
 		D_WARN("Failed to create DTX batched total metric: "DF_RC"\n",
 		       DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->dpm_leader_total, D_TM_COUNTER,
+			     "total DTXs handled as leader", "entries",
+			     "%s/entries/dtx_leader_total/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX leader total metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_commit_sent, D_TM_COUNTER,
+			     "total DTX commit RPCs sent as leader", "ops",
+			     "%s/entries/dtx_commit_sent/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit sent metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_commit_ratio, D_TM_GAUGE,
+			     "DTX commit RPCs per 100 DTXs handled as leader",
+			     "%", "%s/entries/dtx_commit_ratio/tgt_%u", path,
+			     tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit ratio metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_piggyback_total, D_TM_COUNTER,
+			     "total DTX entries committed via dispatched RPC",
+			     "entries", "%s/entries/dtx_piggyback_total/tgt_%u",
+			     path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX piggyback total metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_cmt_cnt_thd, D_TM_GAUGE,
+			     "count threshold for DTX batched commit", "entries",
+			     "%s/entries/dtx_cmt_cnt_thd/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit count threshold metric: "
+		       DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_cmt_age_thd, D_TM_GAUGE,
+			     "age threshold for DTX batched commit", "s",
+			     "%s/entries/dtx_cmt_age_thd/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit age threshold metric: "
+		       DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_cmt_lat, D_TM_GAUGE,
+			     "average latency of DTX batched commit", "us",
+			     "%s/entries/dtx_cmt_lat/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit latency metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_resync_total, D_TM_GAUGE,
+			     "containers to be handled by current DTX resync", "conts",
+			     "%s/entries/dtx_resync_total/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync total metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_resync_done, D_TM_GAUGE,
+			     "containers done by current DTX resync", "conts",
+			     "%s/entries/dtx_resync_done/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync done metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_resync_inflight, D_TM_GAUGE,
+			     "containers in DTX resyncing concurrently", "conts",
+			     "%s/entries/dtx_resync_inflight/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync inflight metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_resync_eta, D_TM_GAUGE,
+			     "estimated remaining time of current DTX resync", "s",
+			     "%s/entries/dtx_resync_eta/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX resync ETA metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_refresh, D_TM_COUNTER,
+			     "operations conflicting with in-progress DTXs",
+			     "ops", "%s/entries/dtx_refresh/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX refresh metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_act_bytes, D_TM_GAUGE,
+			     "estimated size of the active DTX table", "bytes",
+			     "%s/entries/dtx_act_bytes/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX active bytes metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_act_throttled, D_TM_COUNTER,
+			     "DTXs throttled by the active DTX quota", "ops",
+			     "%s/entries/dtx_act_throttled/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX throttled metric: "DF_RC"\n",
+		       DP_RC(rc));
+
 	/** Register different per-opcode counters */
 	for (opc = 0; opc < DTX_PROTO_SRV_RPC_COUNT; opc++) {
 		rc = d_tm_add_metric(&metrics->dpm_total[opc], D_TM_COUNTER,
@@ -128,6 +228,24 @@ struct dss_module_metrics dtx_metrics = {
 	.dmm_nr_metrics = dtx_metrics_count,
 };
 
+static int
+dtx_check_local(struct ds_cont_child *cont, struct dtx_id *dti)
+{
+	int	rc;
+
+	rc = vos_dtx_check(cont->sc_hdl, dti, NULL, NULL, NULL, NULL);
+	if (rc == -DER_NONEXIST && cont->sc_dtx_reindex)
+		rc = -DER_INPROGRESS;
+	else if (rc == DTX_ST_INITED)
+		/* For DTX_CHECK, non-ready one is equal to non-exist. Do not directly
+		 * return 'DTX_ST_INITED' to avoid interoperability trouble if related
+		 * request is from old server.
+		 */
+		rc = -DER_NONEXIST;
+
+	return rc;
+}
+
 static void
 dtx_handler(crt_rpc_t *rpc)
 {
@@ -207,20 +325,28 @@ dtx_handler(crt_rpc_t *rpc)
 					       DTE_CORRUPTED);
 		break;
 	case DTX_CHECK:
-		/* Currently, only support to check single DTX state. */
-		if (din->di_dtx_array.ca_count != 1)
+		count = din->di_dtx_array.ca_count;
+		if (count == 1) {
+			rc = dtx_check_local(cont, din->di_dtx_array.ca_arrays);
+			break;
+		}
+
+		/* Batched DTX_CHECK (from DTX resync), the status of each DTX is returned
+		 * via do_sub_rets. The old server only supports single DTX check and will
+		 * reply -DER_PROTO, then the sender will fall back to check them one by one.
+		 */
+		if (count == 0 || count > DTX_CHECK_BATCH_MAX)
 			D_GOTO(out, rc = -DER_PROTO);
 
-		rc = vos_dtx_check(cont->sc_hdl, din->di_dtx_array.ca_arrays,
-				   NULL, NULL, NULL, NULL);
-		if (rc == -DER_NONEXIST && cont->sc_dtx_reindex)
-			rc = -DER_INPROGRESS;
-		else if (rc == DTX_ST_INITED)
-			/* For DTX_CHECK, non-ready one is equal to non-exist. Do not directly
-			 * return 'DTX_ST_INITED' to avoid interoperability trouble if related
-			 * request is from old server.
-			 */
-			rc = -DER_NONEXIST;
+		D_ALLOC(dout->do_sub_rets.ca_arrays, sizeof(int32_t) * count);
+		if (dout->do_sub_rets.ca_arrays == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		dout->do_sub_rets.ca_count = count;
+		for (i = 0; i < count; i++) {
+			ptr = (int *)dout->do_sub_rets.ca_arrays + i;
+			*ptr = dtx_check_local(cont, (struct dtx_id *)din->di_dtx_array.ca_arrays + i);
+		}
 
 		break;
 	case DTX_REFRESH:
@@ -412,12 +538,53 @@ dtx_init(void)
 
 	D_INFO("Set DTX RPC helper threshold as %u\n", dtx_rpc_helper_thd);
 
+	str = getenv("DTX_PIGGYBACK_MAX");
+	if (str != NULL) {
+		dtx_piggyback_max = atoi(str);
+		if (dtx_piggyback_max > DTX_THRESHOLD_COUNT) {
+			D_WARN("Invalid DTX piggyback count %u, the valid range is "
+			       "[0, %u], use the default value %u\n",
+			       dtx_piggyback_max, DTX_THRESHOLD_COUNT,
+			       DTX_PIGGYBACK_MAX_DEF);
+			dtx_piggyback_max = DTX_PIGGYBACK_MAX_DEF;
+		}
+	} else {
+		dtx_piggyback_max = DTX_PIGGYBACK_MAX_DEF;
+	}
+
+	D_INFO("Set DTX piggyback count as %u\n", dtx_piggyback_max);
+
+	str = getenv("DTX_RESYNC_PARALLEL");
+	if (str != NULL) {
+		dtx_resync_parallel = atoi(str);
+		if (dtx_resync_parallel < DTX_RESYNC_PARALLEL_MIN ||
+		    dtx_resync_parallel > DTX_RESYNC_PARALLEL_MAX) {
+			D_WARN("Invalid DTX resync parallel %u, the valid range is "
+			       "[%u, %u], use the default value %u\n",
+			       dtx_resync_parallel, DTX_RESYNC_PARALLEL_MIN,
+			       DTX_RESYNC_PARALLEL_MAX, DTX_RESYNC_PARALLEL_DEF);
+			dtx_resync_parallel = DTX_RESYNC_PARALLEL_DEF;
+		}
+	} else {
+		dtx_resync_parallel = DTX_RESYNC_PARALLEL_DEF;
+	}
+
+	D_INFO("Set DTX resync parallel as %u\n", dtx_resync_parallel);
+
+	dtx_hlc_tracked = false;
+	d_getenv_bool("DTX_HLC_TRACKED", &dtx_hlc_tracked);
+	D_INFO("%s tracked HLC uncertainty window\n",
+	       dtx_hlc_tracked ? "Use" : "Do not use");
+
 	rc = dbtree_class_register(DBTREE_CLASS_DTX_CF,
 				   BTR_FEAT_UINT_KEY | BTR_FEAT_DYNAMIC_ROOT,
 				   &dbtree_dtx_cf_ops);
 	if (rc == 0)
 		rc = dbtree_class_register(DBTREE_CLASS_DTX_COS, 0,
 					   &dtx_btr_cos_ops);
+	if (rc == 0)
+		rc = dbtree_class_register(DBTREE_CLASS_DTX_COS_OBJ, 0,
+					   &dtx_btr_cos_obj_ops);
 
 	return rc;
 }
@@ -0,0 +1,366 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Measure the DTX CoS (commit-on-share) cache operations with many
+ * concurrent writers against distinct objects and dkeys. The CoS cache
+ * code is built into this program directly, the server side module
+ * environment is stubbed.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <daos/common.h>
+#include <daos/btree_class.h>
+#include <daos_srv/container.h>
+#include <daos_srv/dtx_srv.h>
+#include "../dtx_internal.h"
+
+/* Stubs for the server module environment used by dtx_cos.c */
+pthread_key_t		 dss_tls_key;
+struct dss_module_key	*dss_module_keys[DAOS_MODULE_KEYS_NR];
+struct dss_module_key	 dtx_module_key = {
+	.dmk_tags	= DAOS_TGT_TAG,
+	.dmk_index	= 0,
+};
+uint32_t		 dtx_piggyback_max = DTX_PIGGYBACK_MAX_DEF;
+
+struct cos_perf_args {
+	struct ds_cont_child	 cont;
+	daos_unit_oid_t		*oids;
+	uint32_t		 obj_nr;
+	uint32_t		 dkey_nr;
+	uint32_t		 iterations;
+	/* Shared by all the DTXs, must be the last member. */
+	struct dtx_memberships	 mbs;
+};
+
+static int
+timebox(int (*cb)(struct cos_perf_args *), struct cos_perf_args *args,
+	uint64_t *nsec)
+{
+	struct timespec	start, end;
+	int		rc;
+
+	d_gettime(&start);
+	rc = cb(args);
+	d_gettime(&end);
+
+	*nsec = d_timediff_ns(&start, &end);
+
+	return rc;
+}
+
+static inline uint64_t
+cos_perf_dkey(uint32_t obj_idx, uint32_t dkey_idx)
+{
+	return ((uint64_t)obj_idx << 32) | dkey_idx;
+}
+
+/* The writers against different objects and dkeys interleave. */
+static int
+cos_perf_add(struct cos_perf_args *args)
+{
+	struct dtx_entry	*dte;
+	daos_epoch_t		 epoch = 1;
+	uint32_t		 i;
+	uint32_t		 j;
+	int			 rc;
+
+	for (j = 0; j < args->dkey_nr; j++) {
+		for (i = 0; i < args->obj_nr; i++) {
+			D_ALLOC_PTR(dte);
+			if (dte == NULL)
+				return -DER_NOMEM;
+
+			daos_dti_gen_unique(&dte->dte_xid);
+			dte->dte_ver = 1;
+			dte->dte_refs = 1;
+			dte->dte_mbs = &args->mbs;
+
+			rc = dtx_add_cos(&args->cont, dte, &args->oids[i],
+					 cos_perf_dkey(i, j), epoch++, 0);
+			dtx_entry_put(dte);
+			if (rc != 0)
+				return rc;
+		}
+	}
+
+	return 0;
+}
+
+static void
+cos_perf_free(struct dtx_entry **dtes, struct dtx_cos_key *dcks, int count)
+{
+	int	i;
+
+	for (i = 0; i < count; i++)
+		dtx_entry_put(dtes[i]);
+	D_FREE(dtes);
+	D_FREE(dcks);
+}
+
+static int
+cos_perf_fetch_internal(struct cos_perf_args *args, daos_unit_oid_t *oid,
+			daos_epoch_t epoch)
+{
+	struct dtx_entry	**dtes = NULL;
+	struct dtx_cos_key	 *dcks = NULL;
+	uint32_t		  i;
+	int			  cnt;
+
+	for (i = 0; i < args->iterations; i++) {
+		cnt = dtx_fetch_committable(&args->cont, DTX_THRESHOLD_COUNT,
+					    oid, epoch, &dtes, &dcks);
+		if (cnt < 0)
+			return cnt;
+
+		if (cnt > 0)
+			cos_perf_free(dtes, dcks, cnt);
+	}
+
+	return 0;
+}
+
+/* Batched commit: fetch the oldest committable DTXs. */
+static int
+cos_perf_fetch_all(struct cos_perf_args *args)
+{
+	return cos_perf_fetch_internal(args, NULL, DAOS_EPOCH_MAX);
+}
+
+/* Object sync: fetch the committable DTXs against the last object. */
+static int
+cos_perf_fetch_obj(struct cos_perf_args *args)
+{
+	return cos_perf_fetch_internal(args, &args->oids[args->obj_nr - 1],
+				       DAOS_EPOCH_MAX);
+}
+
+/* Epoch bound sync: only the first object's first DTX is old enough. */
+static int
+cos_perf_fetch_epoch(struct cos_perf_args *args)
+{
+	return cos_perf_fetch_internal(args, NULL, 1);
+}
+
+static int
+cos_perf_oldest(struct cos_perf_args *args)
+{
+	uint32_t	i;
+
+	for (i = 0; i < args->iterations; i++) {
+		if (dtx_cos_oldest(&args->cont) == 0)
+			return -DER_NONEXIST;
+	}
+
+	return 0;
+}
+
+/* Drain the CoS cache as the batched commit does. */
+static int
+cos_perf_del(struct cos_perf_args *args)
+{
+	struct dtx_entry	**dtes = NULL;
+	struct dtx_cos_key	 *dcks = NULL;
+	int			  cnt;
+	int			  rc = 0;
+	int			  i;
+
+	while (rc == 0) {
+		cnt = dtx_fetch_committable(&args->cont, DTX_THRESHOLD_COUNT,
+					    NULL, DAOS_EPOCH_MAX, &dtes, &dcks);
+		if (cnt <= 0)
+			return cnt;
+
+		for (i = 0; i < cnt && rc == 0; i++)
+			rc = dtx_del_cos(&args->cont, &dtes[i]->dte_xid,
+					 &dcks[i].oid, dcks[i].dkey_hash);
+		cos_perf_free(dtes, dcks, cnt);
+	}
+
+	return rc;
+}
+
+/** Convert nanosec to human readable time */
+static void
+nsec_hr(double nsec, char *buf)
+{
+	int			 i = 0;
+	static const char	*const units[] = {"nsec", "usec", "sec",
+						    "min", "hr"};
+	uint32_t divisor[] = {
+		1e3 /** nsec->usec */,
+		1e6 /** usec->sec */,
+		60 /** sec->min */,
+		60 /** min->hr */};
+
+	while (nsec >= divisor[i]) {
+		nsec /= divisor[i];
+		i++;
+	}
+	sprintf(buf, "%.*f %s", i, nsec, units[i]);
+}
+
+static int
+cos_perf_run(struct cos_perf_args *args, const char *name,
+	     int (*cb)(struct cos_perf_args *), uint64_t ops)
+{
+	char		hr_str[20];
+	uint64_t	nsec;
+	int		rc;
+
+	rc = timebox(cb, args, &nsec);
+	if (rc != 0) {
+		printf("%s failed: "DF_RC"\n", name, DP_RC(rc));
+		return rc;
+	}
+
+	nsec_hr((double)nsec / ops, hr_str);
+	printf("\t%-16s %s/op\n", name, hr_str);
+
+	return 0;
+}
+
+static void
+print_usage(char *name)
+{
+	printf("usage: %s [OPTIONS] ...\n\n", name);
+	printf("\t-o NUM, --objects=NUM\t\tObjects count. Default: 1000\n");
+	printf("\t-d NUM, --dkeys=NUM\t\tDkeys per object. Default: 100\n");
+	printf("\t-i NUM, --iterations=NUM\tFetch iterations. Default: 1000\n");
+	printf("\t-h, --help\t\t\tShow this message\n");
+}
+
+static struct option l_opts[] = {
+	{"objects",	required_argument,	NULL, 'o'},
+	{"dkeys",	required_argument,	NULL, 'd'},
+	{"iterations",	required_argument,	NULL, 'i'},
+	{"help",	no_argument,		NULL, 'h'},
+	{NULL,		0,			NULL, 0}
+};
+
+int
+main(int argc, char *argv[])
+{
+	struct cos_perf_args			args = { 0 };
+	struct dss_thread_local_storage		dtls = { 0 };
+	struct dtx_tls				tls = { 0 };
+	void					*values[DAOS_MODULE_KEYS_NR] = { 0 };
+	struct umem_attr			uma = { 0 };
+	uint64_t				total;
+	uint32_t				i;
+	int					opt;
+	int					rc;
+
+	args.obj_nr = 1000;
+	args.dkey_nr = 100;
+	args.iterations = 1000;
+
+	while ((opt = getopt_long(argc, argv, "o:d:i:h", l_opts, NULL)) != -1) {
+		switch (opt) {
+		case 'o':
+			args.obj_nr = atoi(optarg);
+			break;
+		case 'd':
+			args.dkey_nr = atoi(optarg);
+			break;
+		case 'i':
+			args.iterations = atoi(optarg);
+			break;
+		case 'h':
+		default:
+			print_usage(argv[0]);
+			return 0;
+		}
+	}
+	if (args.obj_nr == 0 || args.dkey_nr == 0 || args.iterations == 0) {
+		print_usage(argv[0]);
+		return -1;
+	}
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc)
+		return rc;
+
+	rc = pthread_key_create(&dss_tls_key, NULL);
+	if (rc != 0)
+		D_GOTO(out_debug, rc = daos_errno2der(rc));
+
+	values[dtx_module_key.dmk_index] = &tls;
+	dss_module_keys[dtx_module_key.dmk_index] = &dtx_module_key;
+	dtls.dtls_tag = DAOS_TGT_TAG;
+	dtls.dtls_values = values;
+	pthread_setspecific(dss_tls_key, &dtls);
+
+	rc = dbtree_class_register(DBTREE_CLASS_DTX_COS, 0, &dtx_btr_cos_ops);
+	if (rc == 0)
+		rc = dbtree_class_register(DBTREE_CLASS_DTX_COS_OBJ, 0,
+					   &dtx_btr_cos_obj_ops);
+	if (rc != 0)
+		goto out_key;
+
+	D_ALLOC_ARRAY(args.oids, args.obj_nr);
+	if (args.oids == NULL)
+		D_GOTO(out_key, rc = -DER_NOMEM);
+
+	for (i = 0; i < args.obj_nr; i++) {
+		args.oids[i].id_pub.lo = i + 1;
+		args.oids[i].id_pub.hi = 1;
+	}
+
+	args.mbs.dm_tgt_cnt = 1;
+	args.mbs.dm_grp_cnt = 1;
+
+	args.cont.sc_open = 1;
+	D_INIT_LIST_HEAD(&args.cont.sc_dtx_cos_list);
+	uma.uma_id = UMEM_CLASS_VMEM;
+	rc = dbtree_create_inplace_ex(DBTREE_CLASS_DTX_COS, 0, 23, &uma,
+				      &args.cont.sc_dtx_cos_btr, DAOS_HDL_INVAL,
+				      &args.cont, &args.cont.sc_dtx_cos_hdl);
+	if (rc != 0)
+		goto out_oids;
+
+	rc = dbtree_create_inplace_ex(DBTREE_CLASS_DTX_COS_OBJ, 0, 23, &uma,
+				      &args.cont.sc_dtx_cos_obj_btr,
+				      DAOS_HDL_INVAL, &args.cont,
+				      &args.cont.sc_dtx_cos_obj_hdl);
+	if (rc != 0)
+		goto out_cos;
+
+	total = (uint64_t)args.obj_nr * args.dkey_nr;
+	printf("DTX CoS cache with %u objects x %u dkeys, %lu entries\n",
+	       args.obj_nr, args.dkey_nr, (unsigned long)total);
+
+	rc = cos_perf_run(&args, "add", cos_perf_add, total);
+	if (rc == 0)
+		rc = cos_perf_run(&args, "fetch", cos_perf_fetch_all,
+				  args.iterations);
+	if (rc == 0)
+		rc = cos_perf_run(&args, "fetch (oid)", cos_perf_fetch_obj,
+				  args.iterations);
+	if (rc == 0)
+		rc = cos_perf_run(&args, "fetch (epoch)", cos_perf_fetch_epoch,
+				  args.iterations);
+	if (rc == 0)
+		rc = cos_perf_run(&args, "oldest", cos_perf_oldest,
+				  args.iterations);
+	if (rc == 0)
+		rc = cos_perf_run(&args, "fetch + del", cos_perf_del, total);
+
+	dbtree_destroy(args.cont.sc_dtx_cos_obj_hdl, NULL);
+out_cos:
+	dbtree_destroy(args.cont.sc_dtx_cos_hdl, NULL);
+out_oids:
+	D_FREE(args.oids);
+out_key:
+	pthread_key_delete(dss_tls_key);
+out_debug:
+	daos_debug_fini();
+	return rc;
+}
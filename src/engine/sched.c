@@ -164,6 +164,7 @@ struct sched_request {
 bool		sched_prio_disabled;
 unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
+unsigned int	sched_spin_max = SCHED_SPIN_WIN_DEFAULT; /* us */
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
 
@@ -528,6 +529,30 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+	if (sched_relax_mode != SCHED_RELAX_MODE_ADAPTIVE || !dx->dx_comm)
+		return;
+
+	rc = d_tm_add_metric(&stats->ss_spin_time, D_TM_COUNTER, "Total net poll spinning time",
+			     "us", "sched/spin_time/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create spin_time telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_spin_win, D_TM_GAUGE, "Adaptive spin window", "us",
+			     "sched/spin_window/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create spin_window telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_wakeups, D_TM_COUNTER, "Blocking net waits woken up",
+			     "wakeup", "sched/wakeups/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create wakeups telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_empty_polls, D_TM_COUNTER, "Net polls w/o completion",
+			     "poll", "sched/empty_polls/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create empty_polls telemetry: "DF_RC"\n", DP_RC(rc));
+
+	d_tm_set_gauge(stats->ss_spin_win, info->si_spin_win);
 }
 
 static int
@@ -545,6 +570,9 @@ sched_info_init(struct dss_xstream *dx)
 	info->si_req_cnt = 0;
 	info->si_sleep_cnt = 0;
 	info->si_wait_cnt = 0;
+	info->si_prog_cnt = 0;
+	info->si_spin_ts = 0;
+	info->si_spin_win = sched_spin_max;
 	info->si_stop = 0;
 	sched_metrics_init(dx);
 
@@ -660,12 +688,18 @@ static inline int
 req_kickoff_internal(struct dss_xstream *dx, struct sched_req_attr *attr,
 		     void (*func)(void *), void *arg)
 {
+	unsigned int	flags = 0;
+
 	D_ASSERT(attr && func && arg);
 	D_ASSERT(attr->sra_type < SCHED_REQ_TYPE_MAX);
 
+	if (attr->sra_flags & SCHED_REQ_FL_PERIODIC)
+		flags |= DSS_ULT_FL_PERIODIC;
+	if (attr->sra_type == SCHED_REQ_HIGH_PRIO)
+		flags |= DSS_ULT_FL_HIGH_PRIO;
+
 	return sched_create_thread(dx, func, arg, ABT_THREAD_ATTR_NULL, NULL,
-				   attr->sra_flags & SCHED_REQ_FL_PERIODIC ?
-					DSS_ULT_FL_PERIODIC : 0);
+				   flags);
 }
 
 static int
@@ -1140,7 +1174,8 @@ should_enqueue_req(struct dss_xstream *dx, struct sched_req_attr *attr)
 		return false;
 
 	D_ASSERT(attr->sra_type < SCHED_REQ_TYPE_MAX);
-	if (attr->sra_type == SCHED_REQ_ANONYM)
+	if (attr->sra_type == SCHED_REQ_ANONYM ||
+	    attr->sra_type == SCHED_REQ_HIGH_PRIO)
 		return false;
 
 	/* For VOS xstream only */
@@ -1468,6 +1503,21 @@ sched_cur_seq(void)
 	return info->si_cur_seq;
 }
 
+uint32_t
+sched_queue_depth(void)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_info	*info = &dx->dx_sched_info;
+	size_t			 ult_cnt = 0;
+	int			 rc;
+
+	rc = ABT_pool_get_size(dx->dx_pools[DSS_POOL_GENERIC], &ult_cnt);
+	if (rc != ABT_SUCCESS)
+		ult_cnt = 0;
+
+	return info->si_req_cnt + ult_cnt;
+}
+
 struct sched_request *
 sched_create_ult(struct sched_req_attr *attr, void (*func)(void *), void *arg, size_t stack_size)
 {
@@ -1512,7 +1562,8 @@ struct sched_cycle {
 	uint32_t	sc_age_net;
 	uint32_t	sc_age_nvme;
 	unsigned int	sc_new_cycle:1,
-			sc_cycle_started:1;
+			sc_cycle_started:1,
+			sc_prio_refresh:1;
 };
 
 struct sched_data {
@@ -1600,6 +1651,9 @@ sched_pop_net_poll(struct sched_data *data, ABT_pool pool)
 	if (cycle->sc_ults_tot == 0) {
 		D_ASSERT(!cycle->sc_cycle_started);
 		cycle->sc_new_cycle = 1;
+	} else {
+		/* Extra net poll could bring in new high priority ULTs */
+		cycle->sc_prio_refresh = 1;
 	}
 
 	/*
@@ -1715,6 +1769,38 @@ sched_pop_one(struct sched_data *data, ABT_pool pool, int pool_idx)
 	return unit;
 }
 
+/*
+ * High priority ULTs created by the extra net poll in the middle of a cycle
+ * are accounted into the current cycle, so that they can run ahead of the
+ * remaining generic ULTs. The refresh is done at most once per net poll, so
+ * the generic ULTs won't be starved.
+ */
+static void
+sched_refresh_prio(struct sched_data *data, ABT_pool pool)
+{
+	struct sched_cycle	*cycle = &data->sd_cycle;
+	size_t			 cnt;
+	int			 ret;
+
+	if (!cycle->sc_prio_refresh)
+		return;
+	cycle->sc_prio_refresh = 0;
+
+	ret = ABT_pool_get_size(pool, &cnt);
+	if (ret != ABT_SUCCESS) {
+		D_ERROR("Get ABT pool(%d) size error: %d\n",
+			DSS_POOL_HIGH_PRIO, ret);
+		return;
+	}
+
+	if (cnt <= cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO])
+		return;
+
+	cnt -= cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO];
+	cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO] += cnt;
+	cycle->sc_ults_tot += cnt;
+}
+
 #define SCHED_IDLE_THRESH	8000UL	/* msecs */
 
 /*
@@ -1732,7 +1818,7 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	unsigned int		 sleep_time = sched_relax_intvl;
-	size_t			 blocked;
+	size_t			 blocked, prio_blocked;
 	int			 ret;
 
 	dx->dx_timeout = 0;
@@ -1761,6 +1847,15 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 		return;
 	}
 
+	/* High priority handler ULTs could be sleeping or waiting as well */
+	ret = ABT_pool_get_total_size(pools[DSS_POOL_HIGH_PRIO], &prio_blocked);
+	if (ret != ABT_SUCCESS) {
+		D_ERROR("Get ABT pool(%d) total size error: %d\n",
+			DSS_POOL_HIGH_PRIO, ret);
+		return;
+	}
+	blocked += prio_blocked;
+
 	/*
 	 * Unlike sleeping ULTs, the ULTs blocked on sched_cond_wait() could
 	 * be woken up by other xstream (or even main thread), so that the
@@ -1778,13 +1873,32 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	if (blocked > info->si_sleep_cnt + info->si_wait_cnt)
 		return;
 
-	/*
-	 * System is currently idle, but we only start relaxing when there is
-	 * no external events for a short period of SCHED_IDLE_THRESH.
-	 */
-	D_ASSERT(info->si_cur_ts >= info->si_stats.ss_busy_ts);
-	if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH)
-		return;
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE && dx->dx_progress_started) {
+		uint64_t	now;
+
+		/*
+		 * Keep spinning on net poll as long as completions arrived
+		 * within the adaptive spin window.
+		 */
+		if (info->si_spin_ts == 0)
+			return;
+		now = daos_getutime();
+		if (now - info->si_spin_ts < info->si_spin_win)
+			return;
+
+		/* Spinning is over, back off to a blocking net wait */
+		d_tm_inc_counter(info->si_stats.ss_spin_time, now - info->si_spin_ts);
+		info->si_spin_ts = 0;
+	} else {
+		/*
+		 * System is currently idle, but we only start relaxing when
+		 * there is no external events for a short period of
+		 * SCHED_IDLE_THRESH.
+		 */
+		D_ASSERT(info->si_cur_ts >= info->si_stats.ss_busy_ts);
+		if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH)
+			return;
+	}
 
 	/* Adjust sleep time according to the first sleeping ULT */
 	if (info->si_sleep_cnt > 0) {
@@ -1818,6 +1932,52 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	d_tm_inc_counter(info->si_stats.ss_relax_time, sleep_time);
 }
 
+/*
+ * Account one network progress call for the adaptive CPU relax mode, called by
+ * the network poll ULT with the completion count reported by the Cart context.
+ *
+ * A blocking wait woken up by completions means traffic is still flowing, so
+ * the spin window is widened; a blocking wait which timed out without any
+ * completion means the xstream is really idle, so the spin window is shrunk.
+ */
+void
+sched_progress_account(struct dss_xstream *dx, uint64_t prog_cnt)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_stats	*stats = &info->si_stats;
+	bool			 blocked = dx->dx_timeout != 0;
+	bool			 productive;
+	uint32_t		 win = info->si_spin_win;
+
+	if (sched_relax_mode != SCHED_RELAX_MODE_ADAPTIVE)
+		return;
+
+	productive = (prog_cnt != info->si_prog_cnt);
+	info->si_prog_cnt = prog_cnt;
+
+	if (productive) {
+		if (blocked) {
+			d_tm_inc_counter(stats->ss_wakeups, 1);
+			win = min(win * 2, sched_spin_max);
+		} else if (info->si_spin_ts != 0) {
+			d_tm_inc_counter(stats->ss_spin_time,
+					 daos_getutime() - info->si_spin_ts);
+		}
+		info->si_spin_ts = 0;
+	} else {
+		d_tm_inc_counter(stats->ss_empty_polls, 1);
+		if (blocked)
+			win = max(win / 2, SCHED_SPIN_WIN_MIN);
+		if (info->si_spin_ts == 0)
+			info->si_spin_ts = daos_getutime();
+	}
+
+	if (win != info->si_spin_win) {
+		info->si_spin_win = win;
+		d_tm_set_gauge(stats->ss_spin_win, win);
+	}
+}
+
 static void
 sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 {
@@ -1859,6 +2019,18 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 	cycle->sc_ults_cnt[DSS_POOL_GENERIC] = cnt;
 	cycle->sc_ults_tot += cycle->sc_ults_cnt[DSS_POOL_GENERIC];
 
+	/* Get number of ULTS in high priority ABT pool */
+	D_ASSERT(cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO] == 0);
+	ret = ABT_pool_get_size(pools[DSS_POOL_HIGH_PRIO], &cnt);
+	if (ret != ABT_SUCCESS) {
+		D_ERROR("Get ABT pool(%d) size error: %d\n",
+			DSS_POOL_HIGH_PRIO, ret);
+		cnt = 0;
+	}
+	cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO] = cnt;
+	cycle->sc_ults_tot += cycle->sc_ults_cnt[DSS_POOL_HIGH_PRIO];
+	cycle->sc_prio_refresh = 0;
+
 	if (sched_relax_mode != SCHED_RELAX_MODE_DISABLED)
 		sched_try_relax(dx, pools, cycle->sc_ults_tot);
 
@@ -2004,6 +2176,13 @@ sched_run(ABT_sched sched)
 		if (cycle->sc_ults_tot == 0)
 			goto start_cycle;
 
+		/* Try to pick a ULT from high priority ABT pool first */
+		pool = pools[DSS_POOL_HIGH_PRIO];
+		sched_refresh_prio(data, pool);
+		unit = sched_pop_one(data, pool, DSS_POOL_HIGH_PRIO);
+		if (unit != ABT_UNIT_NULL)
+			goto execute;
+
 		/* Try to pick a ULT from generic ABT pool */
 		pool = pools[DSS_POOL_GENERIC];
 		unit = sched_pop_one(data, pool, DSS_POOL_GENERIC);
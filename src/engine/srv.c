@@ -271,6 +271,7 @@ dss_rpc_hdlr(crt_context_t *ctx, void *hdlr_arg,
 	unsigned int		 mod_id = opc_get_mod_id(rpc->cr_opc);
 	struct dss_module	*module = dss_module_get(mod_id);
 	struct sched_req_attr	 attr = { 0 };
+	int			 prio = CRT_RPC_PRIO_NORMAL;
 	int			 rc;
 
 	if (DAOS_FAIL_CHECK(DAOS_FAIL_LOST_REQ))
@@ -288,6 +289,11 @@ dss_rpc_hdlr(crt_context_t *ctx, void *hdlr_arg,
 		attr.sra_type = SCHED_REQ_ANONYM;
 	}
 
+	/* Control RPCs bypass the per-pool request queues */
+	rc = crt_req_prio_get(rpc, &prio);
+	if (rc == 0 && prio == CRT_RPC_PRIO_HIGH)
+		attr.sra_type = SCHED_REQ_HIGH_PRIO;
+
 	return sched_req_enqueue(dx, &attr, real_rpc_hdlr, rpc);
 }
 
@@ -353,6 +359,7 @@ dss_srv_handler(void *arg)
 	struct dss_thread_local_storage	*dtc;
 	struct dss_module_info		*dmi;
 	int				 rc;
+	uint64_t			 prog_cnt;
 	bool				 signal_caller = true;
 
 	rc = dss_xstream_set_affinity(dx);
@@ -512,6 +519,10 @@ dss_srv_handler(void *arg)
 				 * temporary, Let's keep progressing for now.
 				 */
 			}
+
+			if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE &&
+			    crt_context_progress_cnt(dmi->dmi_ctx, &prog_cnt) == 0)
+				sched_progress_account(dx, prog_cnt);
 		}
 
 		if (dss_xstream_exiting(dx))
@@ -948,6 +959,18 @@ dss_xstreams_init(void)
 	D_INFO("CPU relax mode is set to [%s]\n",
 	       sched_relax_mode2str(sched_relax_mode));
 
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE) {
+		d_getenv_int("DAOS_SCHED_SPIN_MAX", &sched_spin_max);
+		if (sched_spin_max < SCHED_SPIN_WIN_MIN ||
+		    sched_spin_max > SCHED_SPIN_WIN_MAX) {
+			D_WARN("Invalid spin window %u, set to default %u usecs.\n",
+			       sched_spin_max, SCHED_SPIN_WIN_DEFAULT);
+			sched_spin_max = SCHED_SPIN_WIN_DEFAULT;
+		}
+		D_INFO("Max net poll spin window is set to %u usecs\n",
+		       sched_spin_max);
+	}
+
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
 
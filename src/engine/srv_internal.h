@@ -16,11 +16,13 @@
  * DSS_POOL_NET_POLL	Network poll ULT
  * DSS_POOL_NVME_POLL	NVMe poll ULT
  * DSS_POOL_GENERIC	All other ULTS
+ * DSS_POOL_HIGH_PRIO	High priority (control) RPC handler ULTs
  */
 enum {
 	DSS_POOL_NET_POLL	= 0,
 	DSS_POOL_NVME_POLL,
 	DSS_POOL_GENERIC,
+	DSS_POOL_HIGH_PRIO,
 	DSS_POOL_CNT,
 };
 
@@ -31,6 +33,10 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_sq_len;		/* Sleep queue length */
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
+	struct d_tm_node_t	*ss_spin_time;		/* Empty net poll spin time (us) */
+	struct d_tm_node_t	*ss_spin_win;		/* Adaptive spin window (us) */
+	struct d_tm_node_t	*ss_wakeups;		/* Blocking net waits woken up */
+	struct d_tm_node_t	*ss_empty_polls;	/* Net polls w/o completion */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -50,6 +56,9 @@ struct sched_info {
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
 	int			 si_sleep_cnt;	/* Sleeping request count */
 	int			 si_wait_cnt;	/* Long wait request count */
+	uint64_t		 si_prog_cnt;	/* Last seen net completion count */
+	uint64_t		 si_spin_ts;	/* Start of empty net polls (us) */
+	uint32_t		 si_spin_win;	/* Adaptive spin window (us) */
 	unsigned int		 si_stop:1;
 };
 
@@ -153,11 +162,15 @@ int dss_engine_metrics_fini(void);
 /* sched.c */
 #define SCHED_RELAX_INTVL_MAX		100 /* msec */
 #define SCHED_RELAX_INTVL_DEFAULT	1 /* msec */
+#define SCHED_SPIN_WIN_MIN		50	/* usec */
+#define SCHED_SPIN_WIN_MAX		1000000	/* usec */
+#define SCHED_SPIN_WIN_DEFAULT		2000	/* usec */
 
 enum sched_cpu_relax_mode {
 	SCHED_RELAX_MODE_NET		= 0,
 	SCHED_RELAX_MODE_SLEEP,
 	SCHED_RELAX_MODE_DISABLED,
+	SCHED_RELAX_MODE_ADAPTIVE,
 	SCHED_RELAX_MODE_INVALID,
 };
 
@@ -171,6 +184,8 @@ sched_relax_mode2str(enum sched_cpu_relax_mode mode)
 		return "sleep";
 	case SCHED_RELAX_MODE_DISABLED:
 		return "disabled";
+	case SCHED_RELAX_MODE_ADAPTIVE:
+		return "adaptive";
 	default:
 		return "invalid";
 	}
@@ -185,6 +200,8 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_NET;
 	else if (strcasecmp(str, "disabled") == 0)
 		return SCHED_RELAX_MODE_DISABLED;
+	else if (strcasecmp(str, "adaptive") == 0)
+		return SCHED_RELAX_MODE_ADAPTIVE;
 	else
 		return SCHED_RELAX_MODE_INVALID;
 }
@@ -193,6 +210,7 @@ extern bool sched_prio_disabled;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
+extern unsigned int sched_spin_max;
 extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
 
@@ -201,6 +219,7 @@ int dss_sched_init(struct dss_xstream *dx);
 int sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		      void (*func)(void *), void *arg);
 void sched_stop(struct dss_xstream *dx);
+void sched_progress_account(struct dss_xstream *dx, uint64_t prog_cnt);
 
 
 static inline bool
@@ -230,6 +249,9 @@ sched_create_task(struct dss_xstream *dx, void (*func)(void *), void *arg,
 	if (sched_xstream_stopping())
 		return -DER_SHUTDOWN;
 
+	if (flags & DSS_ULT_FL_HIGH_PRIO)
+		abt_pool = dx->dx_pools[DSS_POOL_HIGH_PRIO];
+
 	/* Avoid bumping busy ts for internal periodically created tasks */
 	if (!(flags & DSS_ULT_FL_PERIODIC))
 		/* Atomic integer assignment from different xstream */
@@ -251,6 +273,9 @@ sched_create_thread(struct dss_xstream *dx, void (*func)(void *), void *arg,
 	if (sched_xstream_stopping())
 		return -DER_SHUTDOWN;
 
+	if (flags & DSS_ULT_FL_HIGH_PRIO)
+		abt_pool = dx->dx_pools[DSS_POOL_HIGH_PRIO];
+
 	/* Avoid bumping busy ts for internal periodically created ULTs */
 	if (!(flags & DSS_ULT_FL_PERIODIC))
 		/* Atomic integer assignment from different xstream */
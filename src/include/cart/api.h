@@ -164,6 +164,19 @@ crt_context_flush(crt_context_t crt_ctx, uint64_t timeout);
 int
 crt_context_idx(crt_context_t crt_ctx, int *ctx_idx);
 
+/**
+ * Query the number of network completion callbacks triggered so far by
+ * progressing the transport context. Comparing the value across calls of
+ * crt_progress() tells a productive progress call from an empty poll.
+ *
+ * \param[in] crt_ctx          CRT transport context
+ * \param[out] cnt             pointer to the returned count
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_context_progress_cnt(crt_context_t crt_ctx, uint64_t *cnt);
+
 /**
  * Query the total number of the transport contexts.
  *
@@ -418,6 +431,19 @@ crt_req_dst_rank_get(crt_rpc_t *req, d_rank_t *rank);
 int
 crt_req_dst_tag_get(crt_rpc_t *req, uint32_t *tag);
 
+/**
+ * Return priority class of the RPC, it is set per opcode on registration by
+ * \ref CRT_RPC_FEAT_HIGH_PRIO.
+ *
+ * \param[in] req              Pointer to RPC request
+ * \param[out] prio            Returned priority, see enum crt_rpc_prio
+ *
+ * \return                     DER_SUCCESS on success or error
+ *                             on failure
+ */
+int
+crt_req_prio_get(crt_rpc_t *req, int *prio);
+
 /**
  * Return reply buffer
  *
@@ -587,6 +613,32 @@ crt_hlc_epsilon_get(void);
 uint64_t
 crt_hlc_epsilon_get_bound(uint64_t hlc);
 
+/**
+ * Get the HLC uncertainty window of the engine.
+ *
+ * The engine tracks the HLC offsets to the other engines of the primary group
+ * via its RPCs (including the SWIM pings) and their replies. If every engine
+ * has been sampled recently, the window is the max offset observable between
+ * any two engines' HLCs derived from these samples, which usually is far less
+ * than the maximum system clock offset. Otherwise, the window is the maximum
+ * system clock offset, see crt_hlc_epsilon_set's API doc.
+ *
+ * \return                     Nonnegative HLC duration
+ */
+uint64_t
+crt_hlc_uncertainty_get(void);
+
+/**
+ * Same as crt_hlc_epsilon_get_bound, but with the HLC uncertainty window
+ * instead of the maximum system clock offset.
+ *
+ * \param[in] hlc              HLC timestamp
+ *
+ * \return                     Upper bound HLC timestamp
+ */
+uint64_t
+crt_hlc_uncertainty_get_bound(uint64_t hlc);
+
 /**
  * Abort an RPC request.
  *
@@ -47,6 +47,17 @@ struct swim_member_update {
 	struct swim_member_state smu_state;
 };
 
+/** SWIM failure detector statistics, monotonic since swim_init() */
+struct swim_stats {
+	uint64_t	 ss_suspicions;	/**< members newly put under suspicion */
+	uint64_t	 ss_confirms;	/**< independent suspicion confirmations */
+	uint64_t	 ss_refutes;	/**< suspicions of self refuted by us */
+	uint64_t	 ss_false_pos;	/**< suspected members seen ALIVE again */
+	uint64_t	 ss_deaths;	/**< members declared DEAD */
+	uint32_t	 ss_lhm;	/**< current local health multiplier */
+	uint32_t	 ss_piggyback_max; /**< current piggyback entries limit */
+};
+
 /** opaque SWIM context type */
 struct swim_context;
 
@@ -275,6 +286,23 @@ int swim_net_glitch_update(struct swim_context *ctx, swim_id_t id,
  */
 int swim_member_new_remote(struct swim_context *ctx, swim_id_t id);
 
+/**
+ * Notify SWIM about the current count of group members. It is used to size
+ * the piggyback buffer and the count of retransmissions of each update.
+ *
+ * @param[in]  ctx	SWIM context pointer from swim_init()
+ * @param[in]  nr	count of group members including self
+ */
+void swim_members_count_set(struct swim_context *ctx, uint64_t nr);
+
+/**
+ * Get the statistics of failure detector.
+ *
+ * @param[in]  ctx	SWIM context pointer from swim_init()
+ * @param[out] stats	Pointer to statistics to fill
+ */
+void swim_stats_get(struct swim_context *ctx, struct swim_stats *stats);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -295,6 +295,21 @@ typedef enum {
  */
 #define CRT_RPC_FEAT_QUEUE_FRONT	(1U << 3)
 
+/**
+ * High priority RPC. On target side it is dispatched ahead of normal
+ * priority RPCs by the custom RPC handler (see crt_context_register_rpc_task),
+ * so that small latency sensitive control RPCs (membership, IV, DTX commit)
+ * don't queue behind bulk data RPCs.
+ */
+#define CRT_RPC_FEAT_HIGH_PRIO		(1U << 4)
+
+/** RPC priority classes, see \ref CRT_RPC_FEAT_HIGH_PRIO */
+enum crt_rpc_prio {
+	CRT_RPC_PRIO_NORMAL	= 0,
+	CRT_RPC_PRIO_HIGH,
+	CRT_RPC_PRIO_MAX,
+};
+
 typedef void *crt_bulk_opid_t;
 
 /** Bulk transfer permissions */
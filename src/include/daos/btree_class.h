@@ -98,4 +98,9 @@ extern btr_ops_t dbtree_recx_ops;
  */
 #define DBTREE_CLASS_DTX_COS (DBTREE_DSM_BEGIN + 7)
 
+/**
+ * The key is daos_unit_oid_t, per-object index for the DTX CoS cache.
+ */
+#define DBTREE_CLASS_DTX_COS_OBJ (DBTREE_DSM_BEGIN + 8)
+
 #endif /* __DAOS_SRV_BTREE_CLASS_H__ */
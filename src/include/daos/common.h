@@ -759,6 +759,7 @@ enum {
 #define DAOS_DTX_STALE_PM		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x39)
 #define DAOS_DTX_FAIL_IO		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3a)
 #define DAOS_DTX_START_EPOCH		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3b)
+#define DAOS_DTX_CPD_BATCH		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3c)
 #define DAOS_DTX_NO_BATCHED_CMT		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3d)
 #define DAOS_DTX_NO_COMMITTABLE		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3e)
 #define DAOS_DTX_MISS_COMMIT		(DAOS_FAIL_UNIT_TEST_GROUP_LOC | 0x3f)
@@ -893,6 +894,7 @@ daos_recx_merge(daos_recx_t *src, daos_recx_t *dst)
 #define DAOS_BULK_LIMIT	(DAOS_RPC_SIZE - 1024) /* Reserve 1KiB for headers */
 
 crt_init_options_t *daos_crt_init_opt_get(bool server, int crt_nr);
+bool daos_is_server(void);
 
 int crt_proc_struct_dtx_id(crt_proc_t proc, crt_proc_op_t proc_op,
 			   struct dtx_id *dti);
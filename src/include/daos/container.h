@@ -26,6 +26,9 @@ int dc_cont_node_id2ptr(daos_handle_t coh, uint32_t node_id,
 int dc_cont_hdl2uuid(daos_handle_t coh, uuid_t *hdl_uuid, uuid_t *con_uuid);
 daos_handle_t dc_cont_hdl2pool_hdl(daos_handle_t coh);
 struct daos_csummer *dc_cont_hdl2csummer(daos_handle_t coh);
+struct obj_ec_rcache *dc_cont_hdl2ec_rcache(daos_handle_t coh);
+struct obj_layout_cache *dc_cont_hdl2layout_cache(daos_handle_t coh);
+struct dc_kv_cache *dc_cont_hdl2kv_cache(daos_handle_t coh);
 struct cont_props dc_cont_hdl2props(daos_handle_t coh);
 int dc_cont_hdl2redunfac(daos_handle_t coh);
 int dc_cont_get_redunc(daos_handle_t poh, daos_prop_t *prop);
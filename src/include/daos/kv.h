@@ -20,4 +20,11 @@ int dc_kv_remove(tse_task_t *task);
 int dc_kv_list(tse_task_t *task);
 daos_handle_t daos_kv2objhandle(daos_handle_t oh);
 
+/** Client cache of small KV values of a container handle */
+struct dc_kv_cache;
+struct daos_kv_cache_stats;
+int dc_kv_cache_create(struct dc_kv_cache **cache);
+void dc_kv_cache_destroy(struct dc_kv_cache *cache);
+int dc_kv_cache_query(daos_handle_t coh, struct daos_kv_cache_stats *stats);
+
 #endif /* __DAOS_KVX_H__ */
@@ -426,6 +426,7 @@ int daos_obj_layout_get(daos_handle_t coh, daos_obj_id_t oid,
 
 int daos_iod_copy(daos_iod_t *dst, daos_iod_t *src);
 void daos_iods_free(daos_iod_t *iods, int nr, bool free);
+daos_size_t daos_iod_len(daos_iod_t *iod);
 daos_size_t daos_iods_len(daos_iod_t *iods, int nr);
 
 int daos_obj_generate_oid_by_rf(daos_handle_t poh, uint64_t rf_factor,
@@ -436,6 +437,16 @@ int daos_obj_generate_oid_by_rf(daos_handle_t poh, uint64_t rf_factor,
 int dc_obj_init(void);
 void dc_obj_fini(void);
 
+/** Client cache of EC stripes recovered by degraded fetch */
+struct obj_ec_rcache;
+int obj_ec_rcache_create(struct obj_ec_rcache **cache);
+void obj_ec_rcache_destroy(struct obj_ec_rcache *cache);
+
+/** Client cache of object layouts shared by the open handles */
+struct obj_layout_cache;
+int obj_layout_cache_create(struct obj_layout_cache **cache);
+void obj_layout_cache_destroy(struct obj_layout_cache *cache);
+
 int dc_obj_register_class(tse_task_t *task);
 int dc_obj_query_class(tse_task_t *task);
 int dc_obj_list_class(tse_task_t *task);
@@ -449,6 +460,7 @@ int dc_obj_query_key(tse_task_t *task);
 int dc_obj_sync(tse_task_t *task);
 int dc_obj_fetch_task(tse_task_t *task);
 int dc_obj_update_task(tse_task_t *task);
+int dc_obj_update_multi_task(tse_task_t *task);
 int dc_obj_list_dkey(tse_task_t *task);
 int dc_obj_list_akey(tse_task_t *task);
 int dc_obj_list_rec(tse_task_t *task);
@@ -460,6 +472,11 @@ int dc_obj_verify(daos_handle_t oh, daos_epoch_t *epochs, unsigned int nr);
 daos_handle_t dc_obj_hdl2cont_hdl(daos_handle_t oh);
 int dc_obj_get_grp_size(daos_handle_t oh, int *grp_size);
 
+struct daos_tx_stats;
+struct daos_obj_tgt_stats;
+
+void dc_obj_tgt_stats_query(struct daos_obj_tgt_stats *stats);
+
 int dc_tx_open(tse_task_t *task);
 int dc_tx_commit(tse_task_t *task);
 int dc_tx_abort(tse_task_t *task);
@@ -470,6 +487,7 @@ int dc_tx_local_open(daos_handle_t coh, daos_epoch_t epoch,
 		     uint32_t flags, daos_handle_t *th);
 int dc_tx_local_close(daos_handle_t th);
 int dc_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch);
+int dc_tx_hdl2stats(daos_handle_t th, struct daos_tx_stats *stats);
 
 /** Decode shard number from enumeration anchor */
 static inline uint32_t
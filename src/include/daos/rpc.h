@@ -33,6 +33,7 @@
 #define MOD_ID_BITS	7
 #define opc_get_mod_id(opcode)	((opcode >> MODID_OFFSET) & MODID_MASK)
 #define opc_get(opcode)		(opcode & OPCODE_MASK)
+#define opc_get_rpc_ver(opcode)	((opcode >> RPC_VERSION_OFFSET) & RPC_VERSION_MASK)
 
 #define DAOS_RPC_OPCODE(opc, mod_id, rpc_ver)			\
 	((opc & OPCODE_MASK) << OPCODE_OFFSET |			\
@@ -59,6 +60,8 @@ enum daos_module_id {
 enum daos_rpc_flags {
 	/** flag of reply disabled */
 	DAOS_RPC_NO_REPLY	= CRT_RPC_FEAT_NO_REPLY,
+	/** flag of high priority (control) RPC, dispatched ahead of I/O */
+	DAOS_RPC_HIGH_PRIO	= CRT_RPC_FEAT_HIGH_PRIO,
 };
 
 struct daos_rpc_handler {
@@ -216,6 +216,12 @@ dc_obj_update_task_create(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 			  daos_event_t *ev, tse_sched_t *tse,
 			  tse_task_t **task);
 
+int
+dc_obj_update_multi_task_create(daos_handle_t oh, daos_handle_t th,
+				uint64_t flags, uint32_t nr,
+				daos_dkey_io_t *ios, daos_event_t *ev,
+				tse_sched_t *tse, tse_task_t **task);
+
 int
 dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 			     daos_key_desc_t *kds, d_sg_list_t *sgl,
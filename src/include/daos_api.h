@@ -165,6 +165,33 @@ daos_tx_restart(daos_handle_t th, daos_event_t *ev);
 int
 daos_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch);
 
+/** Conflict statistics of a transaction handle. */
+struct daos_tx_stats {
+	/** Times the transaction has been restarted. */
+	uint32_t	ts_restarts;
+	/** Fetches, enumerations or queries that got -DER_TX_RESTART. */
+	uint32_t	ts_io_conflicts;
+	/** Commits that got -DER_TX_RESTART because of conflicts. */
+	uint32_t	ts_commit_conflicts;
+	/** -DER_TX_RESTART because of pool map changes. */
+	uint32_t	ts_pm_changes;
+};
+
+/**
+ * Return the conflict statistics of the transaction handle. The statistics
+ * are accumulated since the handle is opened, and are not reset when the
+ * transaction restarts. So the application can check them before closing
+ * the handle to know how contended its transactions are, and tune its
+ * batching accordingly.
+ *
+ * \param[in]	th	Transaction handle.
+ * \param[out]	stats	Returned statistics.
+ *
+ * \return		0 if Success, negative if failed.
+ */
+int
+daos_tx_hdl2stats(daos_handle_t th, struct daos_tx_stats *stats);
+
 /**
  * Initialize an iteratror anchor.
  *
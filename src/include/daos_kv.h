@@ -197,6 +197,33 @@ daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	     daos_key_desc_t *kds, d_sg_list_t *sgl, daos_anchor_t *anchor,
 	     daos_event_t *ev);
 
+/** Statistics of the client KV cache of a container handle */
+struct daos_kv_cache_stats {
+	/** gets served from the cache */
+	uint64_t	kcs_hits;
+	/** gets sent to the server while the cache is enabled */
+	uint64_t	kcs_misses;
+	/** number of cached values */
+	uint64_t	kcs_entries;
+	/** bytes of cached values */
+	uint64_t	kcs_bytes;
+};
+
+/**
+ * Query the statistics of the client KV cache of a container handle. The
+ * cache is disabled unless the DAOS_KV_CACHE_MB environment variable is set,
+ * all statistics are zero in that case. This is a local operation.
+ *
+ * \param[in]	coh	Container open handle.
+ * \param[out]	stats	Returned cache statistics.
+ *
+ * \return		0		Success
+ *			-DER_NO_HDL	Invalid container handle
+ *			-DER_INVAL	Invalid parameter
+ */
+int
+daos_kv_cache_query(daos_handle_t coh, struct daos_kv_cache_stats *stats);
+
 #if defined(__cplusplus)
 }
 #endif
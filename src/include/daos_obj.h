@@ -433,6 +433,18 @@ typedef struct {
 	daos_recx_t		*iom_recxs;
 } daos_iom_t;
 
+/** I/O of one distribution key in a multi-dkey update */
+typedef struct {
+	/** Distribution key */
+	daos_key_t		*dio_dkey;
+	/** Number of I/O descriptors and scatter/gather lists */
+	unsigned int		 dio_nr;
+	/** Array of I/O descriptors */
+	daos_iod_t		*dio_iods;
+	/** Scatter/gather lists, one per I/O descriptor */
+	d_sg_list_t		*dio_sgls;
+} daos_dkey_io_t;
+
 /** record status */
 enum {
 	/** Any record size, it is used by fetch */
@@ -787,7 +799,7 @@ daos_obj_fetch(daos_handle_t oh, daos_handle_t th, uint64_t flags,
  *			Function will run in blocking mode if \a ev is NULL.
  *
  * \return		These values will be returned by \a ev::ev_error in
- *			non-blocking mode:
+ *			non-blocking mode, it is the first error of the dkeys:
  *			0		Success
  *			-DER_NO_HDL	Invalid object open handle
  *			-DER_INVAL	Invalid parameter
@@ -805,6 +817,47 @@ daos_obj_update(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 		daos_key_t *dkey, unsigned int nr, daos_iod_t *iods,
 		d_sg_list_t *sgls, daos_event_t *ev);
 
+/**
+ * Insert or update object records of multiple distribution keys, it is the
+ * same as calling daos_obj_update() for each dkey of \a ios, but all of them
+ * are completed by one event. Each dkey can only appear once in \a ios.
+ *
+ * Without a transaction handle, the dkeys are updated independently, they are
+ * not applied atomically and one of them may fail while the others succeed.
+ * The updates of the dkeys that share the same leader target are packed into
+ * one RPC instead of being sent one RPC per dkey. With a transaction handle,
+ * the updates are part of the transaction as daos_obj_update() ones.
+ *
+ * \param[in]	oh	Object open handle.
+ *
+ * \param[in]	th	Optional transaction handle to update with.
+ *			Use DAOS_TX_NONE for an independent transaction.
+ *
+ * \param[in]	flags	Update flags (conditional ops), applied to all dkeys.
+ *			Conditional updates are done per dkey, not packed.
+ *
+ * \param[in]	nr	Number of dkeys in \a ios.
+ *
+ * \param[in]	ios	Array of per dkey I/O, see daos_obj_update().
+ *
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode, it is the first error of the dkeys:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_REC2BIG	Record is larger than the buffer in
+ *					input \a sgls buffer.
+ *			-DER_NO_PERM	Permission denied
+ *			-DER_UNREACH	Network is unreachable
+ *			-DER_EP_RO	Epoch is read-only
+ */
+int
+daos_obj_update_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags,
+		      unsigned int nr, daos_dkey_io_t *ios, daos_event_t *ev);
+
 /**
  * Distribution key enumeration.
  *
@@ -1025,6 +1078,28 @@ daos_obj_query_key(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 int
 daos_obj_verify(daos_handle_t coh, daos_obj_id_t oid, daos_epoch_t epoch);
 
+/** Statistics of the client inflight window per engine target */
+struct daos_obj_tgt_stats {
+	/** shard tasks delayed because the window of the target was full */
+	uint64_t	ots_throttled;
+	/** times a window was halved because the engine was congested */
+	uint64_t	ots_congested;
+};
+
+/**
+ * Query the statistics of the client inflight window per engine target,
+ * accumulated since the library is initialized. The window is disabled unless
+ * the DAOS_OBJ_TGT_INFLIGHT environment variable is set, all statistics are
+ * zero in that case. This is a local operation.
+ *
+ * \param[out]	stats	Returned statistics.
+ *
+ * \return		0		Success
+ *			-DER_INVAL	Invalid parameter
+ */
+int
+daos_obj_tgt_stats_query(struct daos_obj_tgt_stats *stats);
+
 /**
  * Provide a function for objects to split an anchor to be able to execute a
  * parallel listing/enumeration. This routine suggests the optimal number of
@@ -120,7 +120,11 @@ struct ds_cont_child {
 	daos_handle_t		 sc_dtx_cos_hdl;
 	/* The DTX COS-btree. */
 	struct btr_root		 sc_dtx_cos_btr;
-	/* The global list for committable DTXs. */
+	/* The objects with committable DTXs in DRAM, indexed by oid. */
+	daos_handle_t		 sc_dtx_cos_obj_hdl;
+	/* The DTX COS object btree. */
+	struct btr_root		 sc_dtx_cos_obj_btr;
+	/* The global list for committable DTXs, ordered by epoch. */
 	d_list_t		 sc_dtx_cos_list;
 	/* The pool map version for the latest DTX resync on the container. */
 	uint32_t		 sc_dtx_resync_ver;
@@ -222,6 +222,8 @@ enum {
 	SCHED_REQ_MAX,
 	/* Anonymous request which doesn't associate to a DAOS pool */
 	SCHED_REQ_ANONYM = SCHED_REQ_MAX,
+	/* Anonymous high priority (control) request, dispatched first */
+	SCHED_REQ_HIGH_PRIO,
 	SCHED_REQ_TYPE_MAX,
 };
 
@@ -349,6 +351,13 @@ uint64_t sched_cur_msec(void);
  */
 uint64_t sched_cur_seq(void);
 
+/**
+ * Get the number of requests queued by the scheduler plus the number of
+ * ready ULTs of current xstream, it is returned to the client as the hint
+ * of congestion.
+ */
+uint32_t sched_queue_depth(void);
+
 /**
  * Get current ULT/Task execution time. The execution time is the elapsed
  * time since current ULT/Task was scheduled last time.
@@ -505,6 +514,8 @@ enum dss_ult_flags {
 	DSS_ULT_FL_PERIODIC	= (1 << 0),
 	/* Use DSS_DEEP_STACK_SZ as the stack size */
 	DSS_ULT_DEEP_STACK	= (1 << 1),
+	/* Schedule the ULT from the high priority pool */
+	DSS_ULT_FL_HIGH_PRIO	= (1 << 2),
 };
 
 int dss_ult_create(void (*func)(void *), void *arg, int xs_type, int tgt_id,
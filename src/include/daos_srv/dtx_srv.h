@@ -171,14 +171,25 @@ struct dtx_stat {
 	uint64_t	dtx_first_cmt_blob_time_up;
 	/* The epoch for the newest entry in the 1st committed blob. */
 	uint64_t	dtx_first_cmt_blob_time_lo;
+	/* container-based active DTX entries count. */
+	uint32_t	dtx_cont_act_count;
+	/* container-based active DTX entries quota. */
+	uint32_t	dtx_cont_act_quota;
 	/* container-based committed DTX entries count. */
 	uint32_t	dtx_cont_cmt_count;
 	/* pool-based committed DTX entries count. */
 	uint32_t	dtx_pool_cmt_count;
+	/* pool-based active DTX table size (bytes), estimated. */
+	uint64_t	dtx_pool_act_bytes;
 	/* The epoch for the most new DTX entry that is aggregated. */
 	uint64_t	dtx_newest_aggregated;
 };
 
+/* New DTXs against the container will be throttled if its active DTX entries
+ * exceed such high watermark of the per-container quota.
+ */
+#define DTX_ACT_QUOTA_HI(quota)	((quota) - ((quota) >> 3))
+
 enum dtx_flags {
 	/** Single operand. */
 	DTX_SOLO		= (1 << 0),
@@ -225,7 +236,8 @@ int
 dtx_end(struct dtx_handle *dth, struct ds_cont_child *cont, int result);
 int
 dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
-	     uint64_t dkey_hash, int max, struct dtx_id **dtis);
+	     uint64_t dkey_hash, uint32_t pm_ver, struct dtx_memberships *mbs,
+	     int max, struct dtx_id **dtis);
 int
 dtx_leader_exec_ops(struct dtx_leader_handle *dlh, dtx_sub_func_t func,
 		    dtx_agg_cb_t agg_cb, void *agg_cb_arg, void *func_arg);
@@ -245,6 +257,8 @@ int dtx_abort(struct ds_cont_child *cont, struct dtx_entry *dte, daos_epoch_t ep
 
 int dtx_refresh(struct dtx_handle *dth, struct ds_cont_child *cont);
 
+void dtx_act_throttle(struct ds_cont_child *cont);
+
 /**
  * Check whether the given DTX is resent one or not.
  *
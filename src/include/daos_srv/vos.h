@@ -154,6 +154,17 @@ vos_dtx_aggregate(daos_handle_t coh);
 void
 vos_dtx_stat(daos_handle_t coh, struct dtx_stat *stat, uint32_t flags);
 
+/**
+ * Check whether the container's active DTX entries are close to the quota.
+ *
+ * \param coh	[IN]	Container open handle.
+ *
+ * \return		True if new DTXs against the container should be
+ *			throttled, otherwise false.
+ */
+bool
+vos_dtx_act_busy(daos_handle_t coh);
+
 /**
  * Set the DTX committable as committable.
  *
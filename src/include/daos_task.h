@@ -681,6 +681,20 @@ typedef daos_obj_rw_t		daos_obj_fetch_t;
 /** update args struct */
 typedef daos_obj_rw_t		daos_obj_update_t;
 
+/** multi-dkey update args struct */
+typedef struct {
+	/** Object open handle */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** API flags. */
+	uint64_t		flags;
+	/** Number of dkeys in \a ios. */
+	uint32_t		nr;
+	/** Per dkey I/O. */
+	daos_dkey_io_t		*ios;
+} daos_obj_multi_rw_t;
+
 /** Object sync args */
 struct daos_obj_sync_args {
 	/** Object open handle */
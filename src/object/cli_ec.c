@@ -29,6 +29,611 @@
 #define EC_TRACE(fmt, ...)
 #endif
 
+/**
+ * Parity buffer cache.
+ *
+ * Parity buffers of full stripe updates are reused across requests instead of
+ * being allocated and freed for each request. Cached buffers are kept in per
+ * size-class (power of two) free lists, the list link is stored in the free
+ * buffer itself. The total cached size is bounded by DAOS_EC_PBUF_CACHE_MB.
+ */
+#define EC_PBUF_CLASS_MIN	12	/* 4KiB */
+#define EC_PBUF_CLASS_MAX	25	/* 32MiB */
+#define EC_PBUF_CLASS_NR	(EC_PBUF_CLASS_MAX - EC_PBUF_CLASS_MIN + 1)
+#define EC_PBUF_CACHE_MB_DEF	64
+
+struct obj_ec_pbuf_cache {
+	pthread_mutex_t		 epc_lock;
+	d_list_t		 epc_free[EC_PBUF_CLASS_NR];
+	/** total bytes cached in free lists */
+	uint64_t		 epc_cached;
+	/** max bytes to be cached, 0 means caching is disabled */
+	uint64_t		 epc_max;
+};
+
+/**
+ * EC encoding worker pool.
+ *
+ * When DAOS_EC_ENC_THREADS is set, the full stripes of an update are encoded
+ * by a small pool of worker threads in parallel, the calling thread encodes
+ * stripes as well while waiting for the whole batch to be done.
+ */
+#define EC_ENC_THREADS_MAX	32
+
+struct obj_ec_enc_batch {
+	pthread_mutex_t		 eb_lock;
+	pthread_cond_t		 eb_cond;
+	uint32_t		 eb_pending;
+	int			 eb_rc;
+};
+
+struct obj_ec_enc_job {
+	d_list_t		 ej_link;
+	struct obj_ec_enc_batch	*ej_batch;
+	daos_iod_t		*ej_iod;
+	d_sg_list_t		*ej_sgl;
+	struct obj_ec_codec	*ej_codec;
+	struct daos_oclass_attr	*ej_oca;
+	uint64_t		 ej_cell_bytes;
+	uint64_t		 ej_iov_off;
+	uint32_t		 ej_iov_idx;
+	unsigned char		*ej_pbufs[OBJ_EC_MAX_P];
+};
+
+struct obj_ec_enc_pool {
+	pthread_mutex_t		 ep_lock;
+	pthread_cond_t		 ep_cond;
+	d_list_t		 ep_jobs;
+	pthread_t		*ep_threads;
+	uint32_t		 ep_nr;
+	bool			 ep_stop;
+};
+
+static struct obj_ec_pbuf_cache	ec_pbuf_cache;
+static struct obj_ec_enc_pool	ec_enc_pool;
+
+static int
+obj_ec_stripe_encode(daos_iod_t *iod, d_sg_list_t *sgl, uint32_t iov_idx,
+		     size_t iov_off, struct obj_ec_codec *codec,
+		     struct daos_oclass_attr *oca, uint64_t cell_bytes,
+		     unsigned char *parity_bufs[]);
+
+static int
+ec_pbuf_class(uint64_t len)
+{
+	int	bits = EC_PBUF_CLASS_MIN;
+
+	while (bits <= EC_PBUF_CLASS_MAX && (1ULL << bits) < len)
+		bits++;
+
+	return bits - EC_PBUF_CLASS_MIN;
+}
+
+static void *
+obj_ec_pbuf_get(uint64_t len, uint64_t *alloc_len)
+{
+	struct obj_ec_pbuf_cache	*cache = &ec_pbuf_cache;
+	d_list_t			*link = NULL;
+	void				*buf;
+	int				 cls;
+
+	cls = ec_pbuf_class(len);
+	if (cache->epc_max == 0 || cls >= EC_PBUF_CLASS_NR) {
+		*alloc_len = len;
+		D_ALLOC(buf, len);
+		return buf;
+	}
+
+	*alloc_len = 1ULL << (cls + EC_PBUF_CLASS_MIN);
+	D_MUTEX_LOCK(&cache->epc_lock);
+	if (!d_list_empty(&cache->epc_free[cls])) {
+		link = cache->epc_free[cls].next;
+		d_list_del(link);
+		cache->epc_cached -= *alloc_len;
+	}
+	D_MUTEX_UNLOCK(&cache->epc_lock);
+
+	if (link != NULL)
+		return link;
+
+	D_ALLOC(buf, *alloc_len);
+	return buf;
+}
+
+static void
+obj_ec_pbuf_put(void *buf, uint64_t alloc_len)
+{
+	struct obj_ec_pbuf_cache	*cache = &ec_pbuf_cache;
+	d_list_t			*link = buf;
+	int				 cls;
+
+	cls = ec_pbuf_class(alloc_len);
+	if (cache->epc_max == 0 || cls >= EC_PBUF_CLASS_NR ||
+	    alloc_len != 1ULL << (cls + EC_PBUF_CLASS_MIN))
+		goto free;
+
+	D_MUTEX_LOCK(&cache->epc_lock);
+	if (cache->epc_cached + alloc_len <= cache->epc_max) {
+		d_list_add(link, &cache->epc_free[cls]);
+		cache->epc_cached += alloc_len;
+		link = NULL;
+	}
+	D_MUTEX_UNLOCK(&cache->epc_lock);
+
+	if (link == NULL)
+		return;
+free:
+	D_FREE(buf);
+}
+
+static void
+obj_ec_enc_job_done(struct obj_ec_enc_job *job, int rc)
+{
+	struct obj_ec_enc_batch	*batch = job->ej_batch;
+
+	D_MUTEX_LOCK(&batch->eb_lock);
+	if (rc != 0 && batch->eb_rc == 0)
+		batch->eb_rc = rc;
+	D_ASSERT(batch->eb_pending > 0);
+	batch->eb_pending--;
+	if (batch->eb_pending == 0)
+		pthread_cond_broadcast(&batch->eb_cond);
+	D_MUTEX_UNLOCK(&batch->eb_lock);
+}
+
+static void
+obj_ec_enc_job_exec(struct obj_ec_enc_job *job)
+{
+	int	rc;
+
+	rc = obj_ec_stripe_encode(job->ej_iod, job->ej_sgl, job->ej_iov_idx,
+				  job->ej_iov_off, job->ej_codec, job->ej_oca,
+				  job->ej_cell_bytes, job->ej_pbufs);
+	if (rc)
+		D_ERROR("stripe encoding failed rc %d.\n", rc);
+	obj_ec_enc_job_done(job, rc);
+}
+
+/** Pop a job from the worker pool queue, caller should hold ep_lock */
+static struct obj_ec_enc_job *
+obj_ec_enc_job_pop(struct obj_ec_enc_pool *pool)
+{
+	struct obj_ec_enc_job	*job;
+
+	job = d_list_pop_entry(&pool->ep_jobs, struct obj_ec_enc_job, ej_link);
+	return job;
+}
+
+static void *
+obj_ec_enc_worker(void *arg)
+{
+	struct obj_ec_enc_pool	*pool = arg;
+	struct obj_ec_enc_job	*job;
+
+	D_MUTEX_LOCK(&pool->ep_lock);
+	while (1) {
+		job = obj_ec_enc_job_pop(pool);
+		if (job == NULL) {
+			if (pool->ep_stop)
+				break;
+			pthread_cond_wait(&pool->ep_cond, &pool->ep_lock);
+			continue;
+		}
+		D_MUTEX_UNLOCK(&pool->ep_lock);
+		obj_ec_enc_job_exec(job);
+		D_MUTEX_LOCK(&pool->ep_lock);
+	}
+	D_MUTEX_UNLOCK(&pool->ep_lock);
+
+	return NULL;
+}
+
+/**
+ * Encode a batch of stripes, the first job is always executed by the calling
+ * thread, other jobs are dispatched to the worker pool. The calling thread
+ * keeps helping the workers until all jobs of the batch are done.
+ */
+static int
+obj_ec_enc_batch_exec(struct obj_ec_enc_job *jobs, uint32_t nr)
+{
+	struct obj_ec_enc_pool	*pool = &ec_enc_pool;
+	struct obj_ec_enc_batch	 batch = { 0 };
+	struct obj_ec_enc_job	*job;
+	uint32_t		 i;
+	int			 rc;
+
+	rc = D_MUTEX_INIT(&batch.eb_lock, NULL);
+	if (rc)
+		return rc;
+	rc = pthread_cond_init(&batch.eb_cond, NULL);
+	if (rc != 0) {
+		D_MUTEX_DESTROY(&batch.eb_lock);
+		return daos_errno2der(rc);
+	}
+	batch.eb_pending = nr;
+
+	D_MUTEX_LOCK(&pool->ep_lock);
+	for (i = 0; i < nr; i++) {
+		jobs[i].ej_batch = &batch;
+		if (i > 0)
+			d_list_add_tail(&jobs[i].ej_link, &pool->ep_jobs);
+	}
+	pthread_cond_broadcast(&pool->ep_cond);
+	D_MUTEX_UNLOCK(&pool->ep_lock);
+
+	obj_ec_enc_job_exec(&jobs[0]);
+
+	while (1) {
+		D_MUTEX_LOCK(&pool->ep_lock);
+		job = obj_ec_enc_job_pop(pool);
+		D_MUTEX_UNLOCK(&pool->ep_lock);
+		if (job == NULL)
+			break;
+		obj_ec_enc_job_exec(job);
+	}
+
+	D_MUTEX_LOCK(&batch.eb_lock);
+	while (batch.eb_pending > 0)
+		pthread_cond_wait(&batch.eb_cond, &batch.eb_lock);
+	rc = batch.eb_rc;
+	D_MUTEX_UNLOCK(&batch.eb_lock);
+
+	pthread_cond_destroy(&batch.eb_cond);
+	D_MUTEX_DESTROY(&batch.eb_lock);
+	return rc;
+}
+
+int
+obj_ec_enc_pool_init(void)
+{
+	struct obj_ec_enc_pool	*pool = &ec_enc_pool;
+	unsigned int		 cache_mb = EC_PBUF_CACHE_MB_DEF;
+	unsigned int		 nr = 0;
+	int			 i;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&pool->ep_jobs);
+	pool->ep_stop = false;
+	pool->ep_nr = 0;
+
+	/* The client stack in the engine runs in ULTs, which must not block
+	 * the xstream on pthread_cond_wait(), and the engine has its own
+	 * memory budget, so neither the worker threads nor the cache are used.
+	 */
+	if (daos_is_server())
+		return 0;
+
+	d_getenv_int("DAOS_EC_PBUF_CACHE_MB", &cache_mb);
+	rc = D_MUTEX_INIT(&ec_pbuf_cache.epc_lock, NULL);
+	if (rc)
+		return rc;
+	for (i = 0; i < EC_PBUF_CLASS_NR; i++)
+		D_INIT_LIST_HEAD(&ec_pbuf_cache.epc_free[i]);
+	ec_pbuf_cache.epc_cached = 0;
+	ec_pbuf_cache.epc_max = (uint64_t)cache_mb << 20;
+
+	d_getenv_int("DAOS_EC_ENC_THREADS", &nr);
+	if (nr > EC_ENC_THREADS_MAX) {
+		D_WARN("DAOS_EC_ENC_THREADS %u is too large, use %u.\n",
+		       nr, EC_ENC_THREADS_MAX);
+		nr = EC_ENC_THREADS_MAX;
+	}
+
+	if (nr == 0)
+		return 0;
+
+	rc = D_MUTEX_INIT(&pool->ep_lock, NULL);
+	if (rc)
+		goto out_cache;
+	rc = pthread_cond_init(&pool->ep_cond, NULL);
+	if (rc != 0) {
+		rc = daos_errno2der(rc);
+		goto out_lock;
+	}
+	D_ALLOC_ARRAY(pool->ep_threads, nr);
+	if (pool->ep_threads == NULL)
+		D_GOTO(out_cond, rc = -DER_NOMEM);
+
+	for (i = 0; i < nr; i++) {
+		rc = pthread_create(&pool->ep_threads[i], NULL,
+				    obj_ec_enc_worker, pool);
+		if (rc != 0) {
+			D_ERROR("failed to create EC encoding thread: %d\n",
+				rc);
+			rc = daos_errno2der(rc);
+			break;
+		}
+		pool->ep_nr++;
+	}
+
+	if (pool->ep_nr == 0)
+		goto out_threads;
+
+	D_DEBUG(DB_IO, "EC encoding with %u worker threads\n", pool->ep_nr);
+	return 0;
+
+out_threads:
+	D_FREE(pool->ep_threads);
+out_cond:
+	pthread_cond_destroy(&pool->ep_cond);
+out_lock:
+	D_MUTEX_DESTROY(&pool->ep_lock);
+out_cache:
+	D_MUTEX_DESTROY(&ec_pbuf_cache.epc_lock);
+	ec_pbuf_cache.epc_max = 0;
+	return rc;
+}
+
+void
+obj_ec_enc_pool_fini(void)
+{
+	struct obj_ec_enc_pool	*pool = &ec_enc_pool;
+	d_list_t		*link;
+	uint32_t		 i;
+
+	if (pool->ep_nr > 0) {
+		D_MUTEX_LOCK(&pool->ep_lock);
+		pool->ep_stop = true;
+		pthread_cond_broadcast(&pool->ep_cond);
+		D_MUTEX_UNLOCK(&pool->ep_lock);
+
+		for (i = 0; i < pool->ep_nr; i++)
+			pthread_join(pool->ep_threads[i], NULL);
+		pool->ep_nr = 0;
+		D_FREE(pool->ep_threads);
+		pthread_cond_destroy(&pool->ep_cond);
+		D_MUTEX_DESTROY(&pool->ep_lock);
+	}
+
+	if (ec_pbuf_cache.epc_max == 0)
+		return;
+
+	ec_pbuf_cache.epc_max = 0;
+	for (i = 0; i < EC_PBUF_CLASS_NR; i++) {
+		while (!d_list_empty(&ec_pbuf_cache.epc_free[i])) {
+			link = ec_pbuf_cache.epc_free[i].next;
+			d_list_del(link);
+			D_FREE(link);
+		}
+	}
+	ec_pbuf_cache.epc_cached = 0;
+	D_MUTEX_DESTROY(&ec_pbuf_cache.epc_lock);
+}
+
+/**
+ * Cache of EC stripes recovered by degraded fetch, one per container handle.
+ *
+ * The data cells of a recovered stripe are cached with the key of (oid, dkey,
+ * akey, stripe, epoch, record size). The recovery fetch is done at the shadow
+ * epoch of the stripe, so its result won't change, the whole cache is dropped
+ * when the pool map version changes. LRU entries are evicted to keep the size
+ * under DAOS_EC_RECOV_CACHE_MB.
+ */
+#define EC_RCACHE_MB_DEF	16
+#define EC_RCACHE_BUCKETS	64
+
+unsigned int obj_ec_rcache_mb = EC_RCACHE_MB_DEF;
+
+struct obj_ec_rcache {
+	pthread_mutex_t		 erc_lock;
+	d_list_t		 erc_buckets[EC_RCACHE_BUCKETS];
+	/** LRU list, the most recently used entry at the head */
+	d_list_t		 erc_lru;
+	uint64_t		 erc_size;
+	uint64_t		 erc_max;
+	uint32_t		 erc_map_ver;
+};
+
+struct obj_ec_rcache_key {
+	daos_obj_id_t		 rk_oid;
+	daos_key_t		*rk_dkey;
+	daos_key_t		*rk_akey;
+	uint64_t		 rk_stripe;
+	daos_epoch_t		 rk_epoch;
+	daos_size_t		 rk_rec_size;
+	uint64_t		 rk_hash;
+};
+
+struct obj_ec_rcache_entry {
+	d_list_t		 ere_hash_link;
+	d_list_t		 ere_lru_link;
+	daos_obj_id_t		 ere_oid;
+	uint64_t		 ere_stripe;
+	daos_epoch_t		 ere_epoch;
+	daos_size_t		 ere_rec_size;
+	uint64_t		 ere_hash;
+	d_iov_t			 ere_dkey;
+	d_iov_t			 ere_akey;
+	uint64_t		 ere_len;
+	unsigned char		*ere_buf;
+};
+
+int
+obj_ec_rcache_create(struct obj_ec_rcache **cache)
+{
+	struct obj_ec_rcache	*erc;
+	int			 i;
+	int			 rc;
+
+	*cache = NULL;
+	if (obj_ec_rcache_mb == 0)
+		return 0;
+
+	D_ALLOC_PTR(erc);
+	if (erc == NULL)
+		return -DER_NOMEM;
+
+	rc = D_MUTEX_INIT(&erc->erc_lock, NULL);
+	if (rc) {
+		D_FREE(erc);
+		return rc;
+	}
+	for (i = 0; i < EC_RCACHE_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&erc->erc_buckets[i]);
+	D_INIT_LIST_HEAD(&erc->erc_lru);
+	erc->erc_max = (uint64_t)obj_ec_rcache_mb << 20;
+
+	*cache = erc;
+	return 0;
+}
+
+static void
+obj_ec_rcache_evict(struct obj_ec_rcache *erc,
+		    struct obj_ec_rcache_entry *entry)
+{
+	d_list_del(&entry->ere_hash_link);
+	d_list_del(&entry->ere_lru_link);
+	D_ASSERT(erc->erc_size >= entry->ere_len);
+	erc->erc_size -= entry->ere_len;
+	D_FREE(entry);
+}
+
+static void
+obj_ec_rcache_flush(struct obj_ec_rcache *erc)
+{
+	struct obj_ec_rcache_entry	*entry, *tmp;
+
+	d_list_for_each_entry_safe(entry, tmp, &erc->erc_lru, ere_lru_link)
+		obj_ec_rcache_evict(erc, entry);
+	D_ASSERT(erc->erc_size == 0);
+}
+
+void
+obj_ec_rcache_destroy(struct obj_ec_rcache *erc)
+{
+	if (erc == NULL)
+		return;
+
+	obj_ec_rcache_flush(erc);
+	D_MUTEX_DESTROY(&erc->erc_lock);
+	D_FREE(erc);
+}
+
+static void
+obj_ec_rcache_key_init(struct obj_ec_rcache_key *key, daos_obj_id_t oid,
+		       daos_key_t *dkey, daos_key_t *akey, uint64_t stripe,
+		       daos_epoch_t epoch, daos_size_t rec_size)
+{
+	key->rk_oid = oid;
+	key->rk_dkey = dkey;
+	key->rk_akey = akey;
+	key->rk_stripe = stripe;
+	key->rk_epoch = epoch;
+	key->rk_rec_size = rec_size;
+	key->rk_hash = d_hash_murmur64(dkey->iov_buf, dkey->iov_len, 0);
+	key->rk_hash = d_hash_murmur64(akey->iov_buf, akey->iov_len,
+				       key->rk_hash);
+	key->rk_hash ^= oid.lo ^ (oid.hi * DGOLDEN_RATIO_PRIME_64) ^
+			(stripe * DGOLDEN_RATIO_PRIME_64);
+}
+
+/** Check the map version, cached stripes are dropped on pool map change */
+static void
+obj_ec_rcache_map_check(struct obj_ec_rcache *erc, uint32_t map_ver)
+{
+	if (erc->erc_map_ver == map_ver)
+		return;
+
+	obj_ec_rcache_flush(erc);
+	erc->erc_map_ver = map_ver;
+}
+
+static struct obj_ec_rcache_entry *
+obj_ec_rcache_find(struct obj_ec_rcache *erc, struct obj_ec_rcache_key *key)
+{
+	struct obj_ec_rcache_entry	*entry;
+	d_list_t			*head;
+
+	head = &erc->erc_buckets[key->rk_hash % EC_RCACHE_BUCKETS];
+	d_list_for_each_entry(entry, head, ere_hash_link) {
+		if (entry->ere_hash == key->rk_hash &&
+		    entry->ere_stripe == key->rk_stripe &&
+		    entry->ere_epoch == key->rk_epoch &&
+		    entry->ere_rec_size == key->rk_rec_size &&
+		    daos_oid_cmp(entry->ere_oid, key->rk_oid) == 0 &&
+		    daos_key_match(&entry->ere_dkey, key->rk_dkey) &&
+		    daos_key_match(&entry->ere_akey, key->rk_akey))
+			return entry;
+	}
+
+	return NULL;
+}
+
+/** Copy the cached data cells of the stripe to \a buf */
+static bool
+obj_ec_rcache_lookup(struct obj_ec_rcache *erc, uint32_t map_ver,
+		     struct obj_ec_rcache_key *key, void *buf, uint64_t len)
+{
+	struct obj_ec_rcache_entry	*entry;
+	bool				 found = false;
+
+	D_MUTEX_LOCK(&erc->erc_lock);
+	obj_ec_rcache_map_check(erc, map_ver);
+	entry = obj_ec_rcache_find(erc, key);
+	if (entry != NULL && entry->ere_len == len) {
+		memcpy(buf, entry->ere_buf, len);
+		d_list_move(&entry->ere_lru_link, &erc->erc_lru);
+		found = true;
+	}
+	D_MUTEX_UNLOCK(&erc->erc_lock);
+
+	return found;
+}
+
+static void
+obj_ec_rcache_insert(struct obj_ec_rcache *erc, uint32_t map_ver,
+		     struct obj_ec_rcache_key *key, void *buf, uint64_t len)
+{
+	struct obj_ec_rcache_entry	*entry;
+	unsigned char			*ptr;
+	uint64_t			 dkey_len = key->rk_dkey->iov_len;
+	uint64_t			 akey_len = key->rk_akey->iov_len;
+
+	if (len > erc->erc_max)
+		return;
+
+	/* entry, dkey, akey and the data cells in one allocation */
+	D_ALLOC(entry, sizeof(*entry) + dkey_len + akey_len + len);
+	if (entry == NULL)
+		return;
+
+	ptr = (unsigned char *)(entry + 1);
+	memcpy(ptr, key->rk_dkey->iov_buf, dkey_len);
+	d_iov_set(&entry->ere_dkey, ptr, dkey_len);
+	ptr += dkey_len;
+	memcpy(ptr, key->rk_akey->iov_buf, akey_len);
+	d_iov_set(&entry->ere_akey, ptr, akey_len);
+	ptr += akey_len;
+	memcpy(ptr, buf, len);
+	entry->ere_buf = ptr;
+	entry->ere_len = len;
+	entry->ere_oid = key->rk_oid;
+	entry->ere_stripe = key->rk_stripe;
+	entry->ere_epoch = key->rk_epoch;
+	entry->ere_rec_size = key->rk_rec_size;
+	entry->ere_hash = key->rk_hash;
+
+	D_MUTEX_LOCK(&erc->erc_lock);
+	obj_ec_rcache_map_check(erc, map_ver);
+	if (obj_ec_rcache_find(erc, key) != NULL) {
+		D_MUTEX_UNLOCK(&erc->erc_lock);
+		D_FREE(entry);
+		return;
+	}
+
+	while (erc->erc_size + len > erc->erc_max) {
+		D_ASSERT(!d_list_empty(&erc->erc_lru));
+		obj_ec_rcache_evict(erc, d_list_entry(erc->erc_lru.prev,
+						      struct obj_ec_rcache_entry,
+						      ere_lru_link));
+	}
+	d_list_add(&entry->ere_hash_link,
+		   &erc->erc_buckets[key->rk_hash % EC_RCACHE_BUCKETS]);
+	d_list_add(&entry->ere_lru_link, &erc->erc_lru);
+	erc->erc_size += len;
+	D_MUTEX_UNLOCK(&erc->erc_lock);
+}
+
 static int
 obj_ec_recxs_init(struct obj_ec_recx_array *recxs, uint32_t recx_nr)
 {
@@ -53,10 +658,11 @@ obj_ec_pbuf_fini(struct obj_ec_recx_array *recxs)
 	int	i;
 
 	if (recxs->oer_pbufs[0] != NULL)
-		D_FREE(recxs->oer_pbufs[0]);
+		obj_ec_pbuf_put(recxs->oer_pbufs[0], recxs->oer_pbuf_len);
 
 	for (i = 0; i < recxs->oer_p; i++)
 		recxs->oer_pbufs[i] = NULL;
+	recxs->oer_pbuf_len = 0;
 }
 
 void
@@ -83,7 +689,7 @@ obj_ec_pbufs_init(struct obj_ec_recx_array *recxs, uint64_t cell_bytes)
 		return 0;
 
 	parity_len = roundup(recxs->oer_stripe_total * cell_bytes, 8);
-	D_ALLOC(pbuf, parity_len * recxs->oer_p);
+	pbuf = obj_ec_pbuf_get(parity_len * recxs->oer_p, &recxs->oer_pbuf_len);
 	if (pbuf == NULL)
 		return -DER_NOMEM;
 
@@ -560,6 +1166,8 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 		   struct obj_ec_recx_array *recx_array)
 {
 	struct obj_ec_recx	*ec_recx;
+	struct obj_ec_enc_job	*jobs = NULL;
+	struct obj_ec_enc_job	*job;
 	unsigned int		 p = oca->u.ec.e_p;
 	unsigned char		*parity_buf[p];
 	uint64_t		 cell_bytes, stripe_bytes;
@@ -587,6 +1195,10 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 	}
 	stripe_bytes = cell_bytes * oca->u.ec.e_k;
 
+	/* spread the full stripes over the encoding workers */
+	if (!singv && ec_enc_pool.ep_nr > 0 && recx_array->oer_stripe_total > 1)
+		D_ALLOC_ARRAY(jobs, recx_array->oer_stripe_total);
+
 	/* calculate EC parity for each full_stripe */
 	for (i = 0; i < recx_nr; i++) {
 		if (singv) {
@@ -607,12 +1219,28 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 				DF_U64".\n", j, iov_off / iod->iod_size,
 				stripe_bytes / iod->iod_size);
 #endif
-			rc = obj_ec_stripe_encode(iod, sgl, iov_idx, iov_off,
-						  codec, oca, cell_bytes,
-						  parity_buf);
-			if (rc) {
-				D_ERROR("stripe encoding failed rc %d.\n", rc);
-				goto out;
+			if (jobs != NULL) {
+				D_ASSERT(encoded_nr < recx_array->oer_stripe_total);
+				job = &jobs[encoded_nr];
+				job->ej_iod = iod;
+				job->ej_sgl = sgl;
+				job->ej_codec = codec;
+				job->ej_oca = oca;
+				job->ej_cell_bytes = cell_bytes;
+				job->ej_iov_idx = iov_idx;
+				job->ej_iov_off = iov_off;
+				for (m = 0; m < p; m++)
+					job->ej_pbufs[m] = parity_buf[m];
+			} else {
+				rc = obj_ec_stripe_encode(iod, sgl, iov_idx,
+							  iov_off, codec, oca,
+							  cell_bytes,
+							  parity_buf);
+				if (rc) {
+					D_ERROR("stripe encoding failed rc "
+						"%d.\n", rc);
+					goto out;
+				}
 			}
 			if (singv)
 				break;
@@ -622,7 +1250,11 @@ obj_ec_recx_encode(struct obj_ec_codec *codec, struct daos_oclass_attr *oca,
 		}
 	}
 
+	if (jobs != NULL && encoded_nr > 0)
+		rc = obj_ec_enc_batch_exec(jobs, encoded_nr);
+
 out:
+	D_FREE(jobs);
 	return rc;
 }
 
@@ -1859,18 +2491,16 @@ obj_ec_recov_codec_alloc(struct daos_oclass_attr *oca)
 	unsigned short			 k = obj_ec_data_tgt_nr(oca);
 	unsigned short			 p = obj_ec_parity_tgt_nr(oca);
 	void				*buf, *tmp_ptr;
-	size_t				 struct_size, tbl_size, matrix_size;
+	size_t				 struct_size, tbl_size;
 	size_t				 idx_size, list_size, err_size;
 
 	struct_size = roundup(sizeof(struct obj_ec_recov_codec), 8);
 	tbl_size = k * p * 32;
-	matrix_size = roundup((k + p) * k, 8);
 	idx_size = roundup(sizeof(uint32_t) * k, 8);
 	list_size = roundup(sizeof(uint32_t) * p, 8);
 	err_size = roundup(sizeof(bool) * (k + p), 8);
 
-	D_ALLOC(buf, struct_size + tbl_size + 3 * matrix_size + idx_size +
-		     list_size + err_size);
+	D_ALLOC(buf, struct_size + tbl_size + idx_size + list_size + err_size);
 	if (buf == NULL)
 		return NULL;
 
@@ -1879,12 +2509,6 @@ obj_ec_recov_codec_alloc(struct daos_oclass_attr *oca)
 	tmp_ptr += struct_size;
 	recov->er_gftbls = tmp_ptr;
 	tmp_ptr += tbl_size;
-	recov->er_de_matrix = tmp_ptr;
-	tmp_ptr += matrix_size;
-	recov->er_inv_matrix = tmp_ptr;
-	tmp_ptr += matrix_size;
-	recov->er_b_matrix = tmp_ptr;
-	tmp_ptr += matrix_size;
 	recov->er_dec_idx = tmp_ptr;
 	tmp_ptr += idx_size;
 	recov->er_err_list = tmp_ptr;
@@ -2060,8 +2684,7 @@ obj_ec_recov_codec_init(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 	struct obj_ec_fail_info		*fail_info = reasb_req->orr_fail;
 	struct obj_ec_codec		*codec;
 	struct obj_ec_recov_codec	*recov;
-	unsigned char			 s;
-	uint32_t			 i, j, r, k, p;
+	uint32_t			 i, k, p;
 	int				 rc;
 
 	D_ASSERT(fail_info != NULL);
@@ -2103,42 +2726,17 @@ obj_ec_recov_codec_init(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 		return 0;
 	}
 
-	/* Construct matrix b by removing error rows */
-	for (i = 0, r = 0; i < k; i++, r++) {
-		while (recov->er_in_err[r])
-			r++;
-		for (j = 0; j < k; j++)
-			recov->er_b_matrix[k * i + j] =
-				codec->ec_en_matrix[k * r + j];
-		recov->er_dec_idx[i] = r;
-	}
-
-	/* Cauchy matrix is always invertible, should not fail */
-	rc = gf_invert_matrix(recov->er_b_matrix, recov->er_inv_matrix, k);
-	D_ASSERT(rc == 0);
-
-	/* Generate decode matrix (err_list from invert matrix) */
-	for (i = 0; i < recov->er_data_nerrs; i++) {
-		for (j = 0; j < k; j++)
-			recov->er_de_matrix[k * i + j] =
-				recov->er_inv_matrix[k * err_list[i] + j];
-	}
-	/* err_list from encode_matrix * invert matrix, for parity decoding */
-	for (p = recov->er_data_nerrs; p < recov->er_nerrs; p++) {
-		for (i = 0; i < k; i++) {
-			s = 0;
-			for (j = 0; j < k; j++)
-				s ^= gf_mul(recov->er_inv_matrix[j * k + i],
-					    codec->ec_en_matrix[k * err_list[p]
-								+ j]);
-
-			recov->er_de_matrix[k * p + i] = s;
-		}
+	/* the decode tables only depend on the failure pattern, so they are
+	 * shared by all objects of the EC class.
+	 */
+	rc = obj_ec_dec_tbl_get(codec, nerrs, err_list, recov->er_gftbls,
+				recov->er_dec_idx);
+	if (rc) {
+		/* force regenerating for the next call */
+		recov->er_nerrs = 0;
+		return rc;
 	}
 
-	ec_init_tables(k, recov->er_nerrs, recov->er_de_matrix,
-		       recov->er_gftbls);
-
 	return 0;
 }
 
@@ -2490,6 +3088,62 @@ out:
 	return rc;
 }
 
+/**
+ * Looks up the stripes to be recovered in the recovery cache. A recovery task
+ * with all its stripes found in the cache is marked as ert_cached, it needn't
+ * to fetch and decode the stripes again.
+ */
+void
+obj_ec_recov_cache_fill(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
+			daos_iod_t *iods, uint32_t iod_nr)
+{
+	struct obj_ec_fail_info		*fail_info = reasb_req->orr_fail;
+	struct obj_ec_rcache		*erc = fail_info->efi_rcache;
+	struct daos_oclass_attr		*oca = reasb_req->orr_oca;
+	struct obj_ec_recov_task	*rtask;
+	struct obj_ec_rcache_key	 key;
+	uint64_t			 stripe_rec_nr = obj_ec_stripe_rec_nr(oca);
+	uint64_t			 cell_sz, stripe_total_sz, stripe;
+	uint32_t			 i, j, stripe_nr;
+	void				*buf;
+
+	if (erc == NULL || fail_info->efi_dkey == NULL ||
+	    reasb_req->orr_singv_only)
+		return;
+
+	for (i = 0; i < fail_info->efi_recov_ntasks; i++) {
+		rtask = &fail_info->efi_recov_tasks[i];
+		rtask->ert_cached = 0;
+		/* stripe buffer is laid out with the original record size */
+		if (rtask->ert_iod.iod_type != DAOS_IOD_ARRAY ||
+		    rtask->ert_epoch == DAOS_EPOCH_MAX ||
+		    rtask->ert_oiod->iod_size != rtask->ert_iod.iod_size)
+			continue;
+
+		cell_sz = obj_ec_cell_rec_nr(oca) * rtask->ert_iod.iod_size;
+		stripe_total_sz = cell_sz * obj_ec_tgt_nr(oca);
+		stripe = rtask->ert_iod.iod_recxs->rx_idx / stripe_rec_nr;
+		stripe_nr = rtask->ert_iod.iod_recxs->rx_nr / stripe_rec_nr;
+		buf = rtask->ert_sgl.sg_iovs[0].iov_buf;
+		for (j = 0; j < stripe_nr; j++) {
+			obj_ec_rcache_key_init(&key, oid, fail_info->efi_dkey,
+					       &rtask->ert_iod.iod_name,
+					       stripe + j, rtask->ert_epoch,
+					       rtask->ert_iod.iod_size);
+			if (!obj_ec_rcache_lookup(erc, fail_info->efi_map_ver,
+						  &key, buf + j * stripe_total_sz,
+						  obj_ec_data_tgt_nr(oca) *
+						  cell_sz))
+				break;
+		}
+		if (j == stripe_nr) {
+			rtask->ert_cached = 1;
+			D_DEBUG(DB_IO, DF_OID" %u stripes from recovery cache\n",
+				DP_OID(oid), stripe_nr);
+		}
+	}
+}
+
 static void
 obj_ec_recov_stripe(struct obj_ec_recov_codec *codec,
 		    struct daos_oclass_attr *oca, void *buf_stripe,
@@ -2671,6 +3325,9 @@ obj_ec_recov_data(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 	uint64_t			 stripe_rec_nr =
 						obj_ec_stripe_rec_nr(oca);
 	struct daos_recx_ep		*recx_ep;
+	struct obj_ec_recov_task	*rtask;
+	struct obj_ec_rcache_key	 key;
+	uint32_t			 tidx = 0;
 	bool				 singv;
 
 	for (i = 0; i < iod_nr; i++) {
@@ -2698,6 +3355,8 @@ obj_ec_recov_data(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 		buf_stripe = stripe_sgl->sg_iovs[0].iov_buf;
 		recx_nr = singv ? 1 : stripe_list->re_nr;
 		for (j = 0; j < recx_nr; j++) {
+			D_ASSERT(tidx < fail_info->efi_recov_ntasks);
+			rtask = &fail_info->efi_recov_tasks[tidx++];
 			if (singv) {
 				stripe_nr = 1;
 				if (obj_ec_singv_one_tgt(iod->iod_size,
@@ -2709,8 +3368,29 @@ obj_ec_recov_data(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
 					    stripe_rec_nr;
 			}
 			for (sidx = 0; sidx < stripe_nr; sidx++) {
+				if (rtask->ert_cached) {
+					buf_stripe += stripe_total_sz;
+					continue;
+				}
 				obj_ec_recov_stripe(codec, oca, buf_stripe,
 						    cell_sz);
+				if (!singv && fail_info->efi_rcache != NULL &&
+				    fail_info->efi_dkey != NULL &&
+				    iod->iod_size == rtask->ert_iod.iod_size) {
+					obj_ec_rcache_key_init(&key, oid,
+						fail_info->efi_dkey,
+						&iod->iod_name,
+						recx_ep->re_recx.rx_idx /
+						stripe_rec_nr + sidx,
+						rtask->ert_epoch,
+						rtask->ert_iod.iod_size);
+					obj_ec_rcache_insert(
+						fail_info->efi_rcache,
+						fail_info->efi_map_ver, &key,
+						buf_stripe,
+						obj_ec_data_tgt_nr(oca) *
+						cell_sz);
+				}
 				buf_stripe += stripe_total_sz;
 			}
 		}
@@ -70,6 +70,8 @@ dc_obj_init(void)
 	int			rc;
 
 	d_getenv_int("DAOS_IO_MODE", &srv_io_mode);
+	d_getenv_int("DAOS_EC_RECOV_CACHE_MB", &obj_ec_rcache_mb);
+	d_getenv_int("DAOS_OBJ_LAYOUT_CACHE", &obj_layout_cache_max);
 	if (srv_io_mode == DIM_CLIENT_DISPATCH) {
 		D_DEBUG(DB_IO, "Client dispatch.\n");
 	} else if (srv_io_mode == DIM_SERVER_DISPATCH) {
@@ -166,6 +168,29 @@ dc_obj_init(void)
 		D_GOTO(out_rsvc, rc);
 	}
 
+	rc = obj_ec_enc_pool_init();
+	if (rc) {
+		D_ERROR("failed to init EC encoding pool: "DF_RC"\n", DP_RC(rc));
+		obj_ec_codec_fini();
+		if (dc_obj_proto_version == DAOS_OBJ_VERSION - 1)
+			daos_rpc_unregister(&obj_proto_fmt_0);
+		else
+			daos_rpc_unregister(&obj_proto_fmt_1);
+		D_GOTO(out_rsvc, rc);
+	}
+
+	rc = obj_tgt_win_init();
+	if (rc) {
+		D_ERROR("failed to init target windows: "DF_RC"\n", DP_RC(rc));
+		obj_ec_enc_pool_fini();
+		obj_ec_codec_fini();
+		if (dc_obj_proto_version == DAOS_OBJ_VERSION - 1)
+			daos_rpc_unregister(&obj_proto_fmt_0);
+		else
+			daos_rpc_unregister(&obj_proto_fmt_1);
+		D_GOTO(out_rsvc, rc);
+	}
+
 out_rsvc:
 	rsvc_client_fini(&oproto->cli);
 out_grp:
@@ -191,6 +216,8 @@ dc_obj_fini(void)
 		daos_rpc_unregister(&obj_proto_fmt_0);
 	else
 		daos_rpc_unregister(&obj_proto_fmt_1);
+	obj_tgt_win_fini();
+	obj_ec_enc_pool_fini();
 	obj_ec_codec_fini();
 	obj_class_fini();
 	obj_utils_fini();
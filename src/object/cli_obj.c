@@ -135,6 +135,7 @@ obj_shard_open(struct dc_object *obj, unsigned int shard, unsigned int map_ver,
 	       struct dc_obj_shard **shard_ptr)
 {
 	struct dc_obj_shard	*obj_shard;
+	struct pl_obj_shard	*pl_shard;
 	bool			 lock_upgraded = false;
 	int			 rc = 0;
 
@@ -152,18 +153,18 @@ open_retry:
 		D_GOTO(unlock, rc = -DER_STALE);
 	}
 
-	obj_shard = &obj->cob_shards->do_shards[shard];
+	pl_shard = obj_get_shard(obj, shard);
 
 	/* Skip the invalid shards and targets */
-	if (obj_shard->do_shard == -1 ||
-	    obj_shard->do_target_id == -1) {
+	if (pl_shard->po_shard == -1 || pl_shard->po_target == -1) {
 		D_DEBUG(DB_IO, "shard %u does not exist.\n", shard);
 		D_GOTO(unlock, rc = -DER_NONEXIST);
 	}
 
 	D_DEBUG(DB_TRACE, "Open object shard %d\n", shard);
 
-	if (obj_shard->do_obj == NULL) {
+	obj_shard = obj->cob_shards->do_shards[shard];
+	if (obj_shard == NULL || obj_shard->do_obj == NULL) {
 		daos_unit_oid_t	 oid;
 
 		/* upgrade to write lock to safely update open shard cache */
@@ -174,6 +175,17 @@ open_retry:
 			goto open_retry;
 		}
 
+		if (obj_shard == NULL) {
+			D_ALLOC_PTR(obj_shard);
+			if (obj_shard == NULL)
+				D_GOTO(unlock, rc = -DER_NOMEM);
+
+			obj_shard->do_pl_shard = *pl_shard;
+			obj_shard->do_shard_idx = shard;
+			obj_shard->do_layout = obj->cob_shards;
+			obj->cob_shards->do_shards[shard] = obj_shard;
+		}
+
 		oid.id_shard  = obj_shard->do_shard;
 		oid.id_pub    = obj->cob_md.omd_id;
 		oid.id_pad_32 = 0;
@@ -196,18 +208,185 @@ unlock:
 	return rc;
 }
 
+/**
+ * Cache of object layouts, one per container handle.
+ *
+ * All open handles of an object share the placement result as long as the
+ * pool map does not change, so the placement is not recomputed and only one
+ * copy of the shards of a wide object is kept in memory. Layouts are keyed
+ * by (oid, pool map version, read-only open), the layouts generated with an
+ * older pool map version are dropped on lookup, and the least recently used
+ * ones are dropped when there are more than DAOS_OBJ_LAYOUT_CACHE of them.
+ */
+#define OBJ_LAYOUT_CACHE_DEF	1024
+#define OBJ_LAYOUT_BUCKETS	128
+
+unsigned int obj_layout_cache_max = OBJ_LAYOUT_CACHE_DEF;
+
+struct obj_layout_cache {
+	pthread_mutex_t		 olc_lock;
+	d_list_t		 olc_buckets[OBJ_LAYOUT_BUCKETS];
+	/** LRU list, the most recently used layout at the head */
+	d_list_t		 olc_lru;
+	uint32_t		 olc_nr;
+};
+
+static inline void
+obj_shared_layout_addref(struct obj_shared_layout *plo)
+{
+	atomic_fetch_add(&plo->osl_ref, 1);
+}
+
+static void
+obj_shared_layout_decref(struct obj_shared_layout *plo)
+{
+	if (atomic_fetch_sub(&plo->osl_ref, 1) == 1)
+		D_FREE(plo);
+}
+
+int
+obj_layout_cache_create(struct obj_layout_cache **cache)
+{
+	struct obj_layout_cache	*olc;
+	int			 i;
+	int			 rc;
+
+	*cache = NULL;
+	if (obj_layout_cache_max == 0)
+		return 0;
+
+	D_ALLOC_PTR(olc);
+	if (olc == NULL)
+		return -DER_NOMEM;
+
+	rc = D_MUTEX_INIT(&olc->olc_lock, NULL);
+	if (rc) {
+		D_FREE(olc);
+		return rc;
+	}
+	for (i = 0; i < OBJ_LAYOUT_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&olc->olc_buckets[i]);
+	D_INIT_LIST_HEAD(&olc->olc_lru);
+
+	*cache = olc;
+	return 0;
+}
+
+/** Drop the layout from the cache, the open objects still hold it */
+static void
+obj_layout_cache_evict(struct obj_layout_cache *olc,
+		       struct obj_shared_layout *plo)
+{
+	d_list_del_init(&plo->osl_hash_link);
+	d_list_del_init(&plo->osl_lru_link);
+	D_ASSERT(olc->olc_nr > 0);
+	olc->olc_nr--;
+	obj_shared_layout_decref(plo);
+}
+
+void
+obj_layout_cache_destroy(struct obj_layout_cache *olc)
+{
+	struct obj_shared_layout	*plo, *tmp;
+
+	if (olc == NULL)
+		return;
+
+	d_list_for_each_entry_safe(plo, tmp, &olc->olc_lru, osl_lru_link)
+		obj_layout_cache_evict(olc, plo);
+	D_ASSERT(olc->olc_nr == 0);
+	D_MUTEX_DESTROY(&olc->olc_lock);
+	D_FREE(olc);
+}
+
+static inline d_list_t *
+obj_layout_cache_head(struct obj_layout_cache *olc, daos_obj_id_t oid)
+{
+	uint64_t	hash = oid.lo ^ (oid.hi * DGOLDEN_RATIO_PRIME_64);
+
+	return &olc->olc_buckets[hash % OBJ_LAYOUT_BUCKETS];
+}
+
+/** Find the layout and take a reference on it, NULL if not cached */
+static struct obj_shared_layout *
+obj_layout_cache_lookup(struct obj_layout_cache *olc, daos_obj_id_t oid,
+			uint32_t map_ver, bool ro)
+{
+	struct obj_shared_layout	*plo, *tmp;
+	struct obj_shared_layout	*found = NULL;
+
+	D_MUTEX_LOCK(&olc->olc_lock);
+	d_list_for_each_entry_safe(plo, tmp, obj_layout_cache_head(olc, oid),
+				   osl_hash_link) {
+		if (daos_oid_cmp(plo->osl_oid, oid) != 0 || plo->osl_ro != ro)
+			continue;
+
+		if (plo->osl_map_ver < map_ver) {
+			obj_layout_cache_evict(olc, plo);
+			continue;
+		}
+
+		if (plo->osl_map_ver == map_ver) {
+			d_list_move(&plo->osl_lru_link, &olc->olc_lru);
+			obj_shared_layout_addref(plo);
+			found = plo;
+			break;
+		}
+	}
+	D_MUTEX_UNLOCK(&olc->olc_lock);
+
+	return found;
+}
+
+static void
+obj_layout_cache_insert(struct obj_layout_cache *olc,
+			struct obj_shared_layout *plo)
+{
+	struct obj_shared_layout	*lru;
+
+	D_MUTEX_LOCK(&olc->olc_lock);
+	/* the cache holds one reference */
+	obj_shared_layout_addref(plo);
+	d_list_add(&plo->osl_hash_link,
+		   obj_layout_cache_head(olc, plo->osl_oid));
+	d_list_add(&plo->osl_lru_link, &olc->olc_lru);
+	olc->olc_nr++;
+
+	while (olc->olc_nr > obj_layout_cache_max) {
+		lru = d_list_entry(olc->olc_lru.prev, struct obj_shared_layout,
+				   osl_lru_link);
+		obj_layout_cache_evict(olc, lru);
+	}
+	D_MUTEX_UNLOCK(&olc->olc_lock);
+}
+
+/** Free the layout and the shards allocated for it */
+void
+obj_layout_release(struct dc_obj_layout *layout)
+{
+	uint32_t	i;
+
+	for (i = 0; i < layout->do_plo->osl_nr; i++)
+		D_FREE(layout->do_shards[i]);
+
+	obj_shared_layout_decref(layout->do_plo);
+	D_FREE(layout);
+}
+
 static void
 obj_layout_free(struct dc_object *obj)
 {
 	struct dc_obj_layout	*layout = NULL;
+	struct dc_obj_shard	*obj_shard;
 	int			 i;
 
 	if (obj->cob_shards == NULL)
 		return;
 
 	for (i = 0; i < obj->cob_shards_nr; i++) {
-		if (obj->cob_shards->do_shards[i].do_obj != NULL)
-			obj_shard_close(&obj->cob_shards->do_shards[i]);
+		obj_shard = obj->cob_shards->do_shards[i];
+		if (obj_shard != NULL && obj_shard->do_obj != NULL)
+			obj_shard_close(obj_shard);
 	}
 
 	D_SPIN_LOCK(&obj->cob_spin);
@@ -217,7 +396,8 @@ obj_layout_free(struct dc_object *obj)
 	obj->cob_shards_nr = 0;
 	D_SPIN_UNLOCK(&obj->cob_spin);
 
-	D_FREE(layout);
+	if (layout != NULL)
+		obj_layout_release(layout);
 }
 
 static void
@@ -302,15 +482,17 @@ dc_obj_hdl2cont_hdl(daos_handle_t oh)
 	return hdl;
 }
 
+/** Generate the placement result of the object */
 static int
-obj_layout_create(struct dc_object *obj, unsigned int mode, bool refresh)
+obj_layout_place(struct dc_object *obj, unsigned int mode, bool refresh,
+		 struct obj_shared_layout **plo_p)
 {
-	struct pl_obj_layout	*layout = NULL;
-	struct dc_pool		*pool;
-	struct pl_map		*map;
-	uint32_t		old;
-	int			i;
-	int			rc;
+	struct pl_obj_layout		*layout = NULL;
+	struct obj_shared_layout	*plo;
+	struct dc_pool			*pool;
+	struct pl_map			*map;
+	int				 i;
+	int				 rc;
 
 	pool = dc_hdl2pool(dc_cont_hdl2pool_hdl(obj->cob_coh));
 	if (pool == NULL) {
@@ -340,16 +522,79 @@ obj_layout_create(struct dc_object *obj, unsigned int mode, bool refresh)
 	if (refresh)
 		obj_layout_dump(obj->cob_md.omd_id, layout);
 
-	obj->cob_version = layout->ol_ver;
+	D_ALLOC(plo, sizeof(*plo) + sizeof(struct pl_obj_shard) * layout->ol_nr);
+	if (plo == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_INIT_LIST_HEAD(&plo->osl_hash_link);
+	D_INIT_LIST_HEAD(&plo->osl_lru_link);
+	plo->osl_oid = obj->cob_md.omd_id;
+	plo->osl_map_ver = obj->cob_md.omd_ver;
+	plo->osl_ver = layout->ol_ver;
+	plo->osl_ref = 1;
+	plo->osl_nr = layout->ol_nr;
+	plo->osl_grp_size = layout->ol_grp_size;
+	plo->osl_ro = (mode & DAOS_OO_RO) != 0;
+	for (i = 0; i < layout->ol_nr; i++)
+		plo->osl_shards[i] = layout->ol_shards[i];
+
+	*plo_p = plo;
+out:
+	if (layout)
+		pl_obj_layout_free(layout);
+	return rc;
+}
+
+static int
+obj_layout_create(struct dc_object *obj, unsigned int mode, bool refresh)
+{
+	struct obj_shared_layout	*plo = NULL;
+	struct obj_layout_cache		*olc;
+	struct dc_pool			*pool;
+	uint32_t			 old;
+	int				 rc = 0;
+
+	olc = dc_cont_hdl2layout_cache(obj->cob_coh);
+	if (olc != NULL) {
+		pool = dc_hdl2pool(dc_cont_hdl2pool_hdl(obj->cob_coh));
+		if (pool == NULL) {
+			D_WARN("Cannot find valid pool\n");
+			D_GOTO(out, rc = -DER_NO_HDL);
+		}
+
+		obj->cob_md.omd_ver = dc_pool_get_version(pool);
+		dc_pool_put(pool);
+		plo = obj_layout_cache_lookup(olc, obj->cob_md.omd_id,
+					      obj->cob_md.omd_ver,
+					      (mode & DAOS_OO_RO) != 0);
+	}
+
+	if (plo == NULL) {
+		rc = obj_layout_place(obj, mode, refresh, &plo);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		if (olc != NULL)
+			obj_layout_cache_insert(olc, plo);
+	}
+
+	obj->cob_version = plo->osl_ver;
 
+	/* Only the shard pointers are allocated, shards are allocated on
+	 * the first open, most of the shards of a wide object are never
+	 * accessed through one open handle.
+	 */
 	D_ASSERT(obj->cob_shards == NULL);
 	D_ALLOC(obj->cob_shards, sizeof(struct dc_obj_layout) +
-		sizeof(struct dc_obj_shard) * layout->ol_nr);
-	if (obj->cob_shards == NULL)
+		sizeof(struct dc_obj_shard *) * plo->osl_nr);
+	if (obj->cob_shards == NULL) {
+		obj_shared_layout_decref(plo);
 		D_GOTO(out, rc = -DER_NOMEM);
+	}
+	obj->cob_shards->do_plo = plo;
 
-	obj->cob_shards_nr = layout->ol_nr;
-	obj->cob_grp_size = layout->ol_grp_size;
+	obj->cob_shards_nr = plo->osl_nr;
+	obj->cob_grp_size = plo->osl_grp_size;
 	old = obj->cob_grp_nr;
 	obj->cob_grp_nr = obj->cob_shards_nr / obj->cob_grp_size;
 
@@ -361,21 +606,7 @@ obj_layout_create(struct dc_object *obj, unsigned int mode, bool refresh)
 		if (obj->cob_time_fetch_leader == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
 	}
-
-	for (i = 0; i < layout->ol_nr; i++) {
-		struct dc_obj_shard *obj_shard;
-
-		obj_shard = &obj->cob_shards->do_shards[i];
-		obj_shard->do_shard = layout->ol_shards[i].po_shard;
-		obj_shard->do_shard_idx = i;
-		obj_shard->do_target_id = layout->ol_shards[i].po_target;
-		obj_shard->do_fseq = layout->ol_shards[i].po_fseq;
-		obj_shard->do_rebuilding = layout->ol_shards[i].po_rebuilding;
-		obj_shard->do_reintegrating = layout->ol_shards[i].po_reintegrating;
-	}
 out:
-	if (layout)
-		pl_obj_layout_free(layout);
 	return rc;
 }
 
@@ -526,12 +757,32 @@ obj_get_grp_nr(struct dc_object *obj)
 	return obj->cob_grp_nr;
 }
 
+/* One in OBJ_LAT_EXPLORE replica reads ignores the latency history */
+#define OBJ_LAT_EXPLORE		16
+
+/* Fetch latency EWMA of the target of the shard, 0 if it is unknown */
+static uint64_t
+obj_shard_lat(struct dc_object *obj, int idx)
+{
+	struct dc_obj_shard	*shard = obj->cob_shards->do_shards[idx];
+
+	if (shard == NULL || shard->do_obj == NULL)
+		return 0;
+
+	return obj_tgt_lat_get(shard->do_target_rank, shard->do_target_idx,
+			       NULL);
+}
+
 /* Get a valid shard from an object group */
 static int
 obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 			unsigned int map_ver,
 			struct obj_auxi_tgt_list *failed_list)
 {
+	uint64_t lat;
+	uint64_t best_lat = 0;
+	bool by_lat;
+	int best = -1;
 	int grp_start;
 	int idx;
 	int grp_size;
@@ -565,36 +816,110 @@ obj_grp_valid_shard_get(struct dc_object *obj, int grp_idx,
 	D_ASSERT(grp_size >= obj_get_replicas(obj));
 	grp_start = grp_idx * grp_size;
 	idx = grp_start + d_rand() % grp_size;
+	/* With hedged reads, prefer the replica with the lowest latency */
+	by_lat = obj_hedge_enabled() && d_rand() % OBJ_LAT_EXPLORE != 0;
 	for (i = 0; i < grp_size; i++, idx++) {
 		uint32_t tgt_id;
 		int index;
 
 		index = idx % grp_size + grp_start;
 		/* let's skip the rebuild shard */
-		if (obj->cob_shards->do_shards[index].do_rebuilding)
+		if (obj_get_shard(obj, index)->po_rebuilding)
 			continue;
 
 		/* Skip the target which is already in the failed list, i.e.
 		 * they have been tried.
 		 */
-		tgt_id = obj->cob_shards->do_shards[index].do_target_id;
+		tgt_id = obj_get_shard(obj, index)->po_target;
 		if (failed_list && tgt_in_failed_tgts_list(tgt_id, failed_list))
 			continue;
 
 		/* Skip the invalid shards and targets */
-		if (obj->cob_shards->do_shards[index].do_target_id != -1 ||
-		    obj->cob_shards->do_shards[index].do_shard != -1) {
-			idx = index;
-			break;
+		if (obj_get_shard(obj, index)->po_target != -1 ||
+		    obj_get_shard(obj, index)->po_shard != -1) {
+			if (!by_lat) {
+				best = index;
+				break;
+			}
+
+			lat = obj_shard_lat(obj, index);
+			if (best < 0 || lat < best_lat) {
+				best = index;
+				best_lat = lat;
+			}
 		}
 	}
 
 	D_RWLOCK_UNLOCK(&obj->cob_lock);
 
-	if (i == grp_size)
+	if (best < 0)
 		return -DER_NONEXIST;
 
-	return idx;
+	return best;
+}
+
+/**
+ * Choose the replica to hedge a replicated fetch to, it is another valid
+ * shard in the same group, with the lowest latency.
+ *
+ * \return	shard index, or negative if the fetch can't be hedged.
+ */
+int
+obj_hedge_shard_get(struct shard_auxi_args *shard_auxi)
+{
+	struct obj_auxi_args	*obj_auxi = shard_auxi->obj_auxi;
+	struct dc_object	*obj = shard_auxi->obj;
+	struct pl_obj_shard	*pl_shard;
+	uint64_t		 lat;
+	uint64_t		 best_lat = 0;
+	int			 best = -1;
+	int			 grp_size;
+	int			 grp_start;
+	int			 index;
+	int			 i;
+
+	/*
+	 * EC shards hold different data, reads in TX must stay on the shard
+	 * that records the read timestamp, and retried reads to the leader
+	 * would get -DER_INPROGRESS again from the other replicas.
+	 */
+	if (obj_auxi->opc != DAOS_OBJ_RPC_FETCH || obj_auxi->is_ec_obj ||
+	    obj_auxi->to_leader || obj_auxi->spec_shard ||
+	    obj_auxi->spec_group || obj_auxi->req_tgts.ort_srv_disp ||
+	    daos_handle_is_valid(obj_auxi->th))
+		return -1;
+
+	grp_size = obj_get_grp_size(obj);
+	grp_start = shard_auxi->shard / grp_size * grp_size;
+
+	D_RWLOCK_RDLOCK(&obj->cob_lock);
+	if (obj->cob_version != shard_auxi->map_ver)
+		goto out;
+
+	for (i = 0; i < grp_size; i++) {
+		index = grp_start + i;
+		if (index == shard_auxi->shard)
+			continue;
+
+		pl_shard = obj_get_shard(obj, index);
+		if (pl_shard->po_rebuilding || pl_shard->po_target == -1 ||
+		    pl_shard->po_shard == -1)
+			continue;
+
+		if (obj_auxi->failed_tgt_list != NULL &&
+		    tgt_in_failed_tgts_list(pl_shard->po_target,
+					    obj_auxi->failed_tgt_list))
+			continue;
+
+		lat = obj_shard_lat(obj, index);
+		if (best < 0 || lat < best_lat) {
+			best = index;
+			best_lat = lat;
+		}
+	}
+out:
+	D_RWLOCK_UNLOCK(&obj->cob_lock);
+	return best;
 }
 
 static int
@@ -605,7 +930,7 @@ obj_shard_find_replica(struct dc_object *obj, unsigned int target,
 	int idx;
 
 	for (idx = 0; idx < obj->cob_shards_nr; idx++) {
-		if (obj->cob_shards->do_shards[idx].do_target_id == target)
+		if (obj_get_shard(obj, idx)->po_target == target)
 			break;
 	}
 
@@ -902,7 +1227,7 @@ obj_shard2tgtid(struct dc_object *obj, uint32_t shard, uint32_t map_ver,
 		return -DER_NONEXIST;
 	}
 
-	*tgt_id = obj->cob_shards->do_shards[shard].do_target_id;
+	*tgt_id = obj_get_shard(obj, shard)->po_target;
 	D_RWLOCK_UNLOCK(&obj->cob_lock);
 	return 0;
 }
@@ -1704,15 +2029,15 @@ dc_obj_layout_get(daos_handle_t oh, struct daos_obj_layout **p_layout)
 		shard = layout->ol_shards[i];
 		shard->os_replica_nr = grp_size;
 		for (j = 0; j < grp_size; j++) {
-			struct dc_obj_shard *obj_shard;
+			struct pl_obj_shard *pl_shard;
 			struct pool_target *tgt;
 
-			obj_shard = &obj->cob_shards->do_shards[k++];
-			if (obj_shard->do_target_id == -1)
+			pl_shard = obj_get_shard(obj, k++);
+			if (pl_shard->po_target == -1)
 				continue;
 
 			rc = dc_cont_tgt_idx2ptr(obj->cob_coh,
-						 obj_shard->do_target_id, &tgt);
+						 pl_shard->po_target, &tgt);
 			if (rc != 0)
 				D_GOTO(out, rc);
 
@@ -1871,11 +2196,22 @@ obj_ec_recov_cb(tse_task_t *task, struct dc_object *obj,
 		goto out;
 	}
 
+	/* Migration reads each stripe once, don't pollute the cache */
+	if (!(obj_auxi->flags & ORF_FOR_MIGRATION)) {
+		fail_info->efi_rcache = dc_cont_hdl2ec_rcache(coh);
+		fail_info->efi_dkey = args->dkey;
+		fail_info->efi_map_ver = obj_auxi->map_ver_req;
+		obj_ec_recov_cache_fill(reasb_req, obj->cob_md.omd_id,
+					args->iods, args->nr);
+	}
+
 	D_ASSERT(fail_info->efi_recov_ntasks > 0 &&
 		 fail_info->efi_recov_tasks != NULL);
 	D_INIT_LIST_HEAD(&task_list);
 	for (i = 0; i < fail_info->efi_recov_ntasks; i++) {
 		recov_task = &fail_info->efi_recov_tasks[i];
+		if (recov_task->ert_cached)
+			continue;
 		/* Set client hlc as recovery epoch only for the case that
 		 * singv recovery without fetch from server ahead - when
 		 * some targets un-available.
@@ -2028,8 +2364,9 @@ obj_rw_bulk_prep(struct dc_object *obj, daos_iod_t *iods, d_sg_list_t *sgls,
 	     obj_auxi->bulks != NULL) || obj_auxi->reasb_req.orr_size_fetch)
 		return 0;
 
-	/* inline fetch needs to pack sgls buffer into RPC so uses it to check
-	 * if need bulk transferring.
+	/* inline update packs sgls buffer into the request, inline fetch
+	 * packs it into the reply, so uses it to check if need bulk
+	 * transferring.
 	 */
 	sgls_size = daos_sgls_packed_size(sgls, nr, NULL);
 	if (sgls_size >= DAOS_BULK_LIMIT ||
@@ -2827,8 +3164,25 @@ obj_embedded_shard_arg(struct obj_auxi_args *obj_auxi)
 	};
 }
 
+struct shard_win_args {
+	d_rank_t	rank;
+	uint32_t	tag;
+};
+
+static int
+shard_win_comp_cb(tse_task_t *task, void *data)
+{
+	struct shard_win_args	*args = data;
+
+	obj_tgt_win_release(args->rank, args->tag);
+	return 0;
+}
+
+/* Delay before retrying the shard task throttled by the target window */
+#define SHARD_WIN_DELAY		100 /* us */
+
 static int
-shard_io(tse_task_t *task, struct shard_auxi_args *shard_auxi)
+shard_io(tse_task_t *task, struct shard_auxi_args *shard_auxi, bool throttle)
 {
 	struct dc_object		*obj = shard_auxi->obj;
 	struct obj_auxi_args		*obj_auxi = shard_auxi->obj_auxi;
@@ -2848,6 +3202,27 @@ shard_io(tse_task_t *task, struct shard_auxi_args *shard_auxi)
 		return rc;
 	}
 
+	/* Limit the inflight shard tasks fanned out to the same target */
+	if (throttle) {
+		struct shard_win_args	win_args;
+
+		win_args.rank = obj_shard->do_target_rank;
+		win_args.tag = obj_shard->do_target_idx;
+		if (obj_tgt_win_acquire(win_args.rank, win_args.tag) != 0) {
+			obj_shard_close(obj_shard);
+			return tse_task_reinit_with_delay(task, SHARD_WIN_DELAY);
+		}
+
+		rc = tse_task_register_comp_cb(task, shard_win_comp_cb,
+					       &win_args, sizeof(win_args));
+		if (rc != 0) {
+			obj_tgt_win_release(win_args.rank, win_args.tag);
+			obj_shard_close(obj_shard);
+			tse_task_complete(task, rc);
+			return rc;
+		}
+	}
+
 	shard_auxi->flags = shard_auxi->obj_auxi->flags;
 	req_tgts = &shard_auxi->obj_auxi->req_tgts;
 	D_ASSERT(shard_auxi->grp_idx < req_tgts->ort_grp_nr);
@@ -2899,7 +3274,7 @@ shard_io_task(tse_task_t *task)
 			return tse_task_reinit(task);
 	}
 
-	return shard_io(task, shard_auxi);
+	return shard_io(task, shard_auxi, true);
 }
 
 typedef int (*shard_io_prep_cb_t)(struct shard_auxi_args *shard_auxi,
@@ -3040,7 +3415,7 @@ obj_req_fanout(struct dc_object *obj, struct obj_auxi_args *obj_auxi,
 					     tgt->st_ec_tgt);
 			shard_auxi->start_shard = req_tgts->ort_start_shard;
 			shard_auxi->shard_io_cb = io_cb;
-			rc = shard_io(obj_task, shard_auxi);
+			rc = shard_io(obj_task, shard_auxi, false);
 			return rc;
 		}
 	}
@@ -3065,7 +3440,7 @@ obj_req_fanout(struct dc_object *obj, struct obj_auxi_args *obj_auxi,
 		obj_auxi->shards_scheded = 1;
 
 		/* for fail case the obj_task will be completed in shard_io() */
-		rc = shard_io(obj_task, shard_auxi);
+		rc = shard_io(obj_task, shard_auxi, false);
 		return rc;
 	}
 
@@ -5137,6 +5512,118 @@ comp:
 	return rc > 0 ? 0 : rc;
 }
 
+/**
+ * Issue one update sub task per dkey of a multi-dkey update, the multi-dkey
+ * task completes with the first error when all of them complete.
+ */
+static int
+obj_multi_fan_out(tse_task_t *task, daos_obj_multi_rw_t *args)
+{
+	tse_sched_t	*sched = tse_task2sched(task);
+	tse_task_t	*sub_task;
+	daos_dkey_io_t	*io;
+	d_list_t	 task_list;
+	uint32_t	 i;
+	int		 rc = 0;
+
+	D_INIT_LIST_HEAD(&task_list);
+	for (i = 0; i < args->nr; i++) {
+		io = &args->ios[i];
+		rc = dc_obj_update_task_create(args->oh, args->th, args->flags,
+					       io->dio_dkey, io->dio_nr,
+					       io->dio_iods, io->dio_sgls, NULL,
+					       sched, &sub_task);
+		if (rc != 0)
+			goto out;
+
+		rc = tse_task_register_deps(task, 1, &sub_task);
+		if (rc != 0) {
+			tse_task_complete(sub_task, rc);
+			goto out;
+		}
+
+		tse_task_list_add(sub_task, &task_list);
+	}
+
+	tse_task_list_sched(&task_list, false);
+	return 0;
+
+out:
+	/* the multi-dkey task completes with the last aborted dependency */
+	if (d_list_empty(&task_list))
+		tse_task_complete(task, rc);
+	else
+		tse_task_list_abort(&task_list, rc);
+	return rc;
+}
+
+/** Check the multi-dkey update and return the object */
+static int
+obj_multi_req_valid(daos_obj_multi_rw_t *args, struct dc_object **p_obj)
+{
+	struct dc_object	*obj;
+	daos_dkey_io_t		*io;
+	uint32_t		 i;
+	int			 rc;
+
+	if (args->nr == 0 || args->ios == NULL) {
+		D_ERROR("Invalid multi-dkey parameter.\n");
+		return -DER_INVAL;
+	}
+
+	obj = obj_hdl2ptr(args->oh);
+	if (obj == NULL)
+		return -DER_NO_HDL;
+
+	for (i = 0; i < args->nr; i++) {
+		io = &args->ios[i];
+		if (!obj_key_valid(obj->cob_md.omd_id, io->dio_dkey, true) ||
+		    io->dio_nr == 0) {
+			D_ERROR("Invalid multi-dkey parameter of dkey %u.\n", i);
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+
+		rc = obj_iod_sgl_valid(obj->cob_md.omd_id, io->dio_nr,
+				       io->dio_iods, io->dio_sgls, true,
+				       false, false);
+		if (rc)
+			goto out;
+	}
+
+	*p_obj = obj;
+	return 0;
+out:
+	obj_decref(obj);
+	return rc;
+}
+
+int
+dc_obj_update_multi_task(tse_task_t *task)
+{
+	daos_obj_multi_rw_t	*args = dc_task_get_args(task);
+	struct dc_object	*obj = NULL;
+	int			 rc;
+
+	rc = obj_multi_req_valid(args, &obj);
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	/*
+	 * Updates in a transaction are packed by its commit, and conditional
+	 * updates check the existence of the key before being packed, so only
+	 * the independent plain updates are packed per leader here.
+	 */
+	if (daos_handle_is_valid(args->th) || args->nr == 1 ||
+	    (args->flags & DAOS_COND_MASK)) {
+		obj_decref(obj);
+		return obj_multi_fan_out(task, args);
+	}
+
+	return dc_tx_update_multi(obj, task);
+}
+
 static int
 shard_anchors_check_alloc_bufs(struct obj_auxi_args *obj_auxi,
 			       struct shard_anchors *sub_anchors,
@@ -5449,10 +5936,10 @@ obj_ec_list_get_shard(struct obj_auxi_args *obj_auxi, unsigned int map_ver,
 			/* let's skip the rebuild shard for non-update op */
 			shard = parities[idx];
 
-			if (obj->cob_shards->do_shards[shard].do_rebuilding)
+			if (obj_get_shard(obj, shard)->po_rebuilding)
 				continue;
 
-			if (obj->cob_shards->do_shards[shard].do_target_id != -1)
+			if (obj_get_shard(obj, shard)->po_target != -1)
 				break;
 		}
 
@@ -5468,8 +5955,8 @@ obj_ec_list_get_shard(struct obj_auxi_args *obj_auxi, unsigned int map_ver,
 	/* Check if all data shard are in good state */
 	first = grp_idx * obj_get_grp_size(obj);
 	for (idx = first; idx < first + obj_ec_data_tgt_nr(oca); idx++) {
-		if (obj->cob_shards->do_shards[idx].do_rebuilding ||
-		    obj->cob_shards->do_shards[idx].do_target_id == -1)
+		if (obj_get_shard(obj, idx)->po_rebuilding ||
+		    obj_get_shard(obj, idx)->po_target == -1)
 			break;
 	}
 
@@ -17,13 +17,6 @@
 #include "obj_rpc.h"
 #include "obj_internal.h"
 
-static inline struct dc_obj_layout *
-obj_shard2layout(struct dc_obj_shard *shard)
-{
-	return container_of(shard, struct dc_obj_layout,
-			    do_shards[shard->do_shard_idx]);
-}
-
 void
 obj_shard_decref(struct dc_obj_shard *shard)
 {
@@ -36,7 +29,7 @@ obj_shard_decref(struct dc_obj_shard *shard)
 	D_ASSERT(shard->do_obj != NULL);
 
 	obj = shard->do_obj;
-	layout = obj_shard2layout(shard);
+	layout = shard->do_layout;
 
 	D_SPIN_LOCK(&obj->cob_spin);
 	if (--(shard->do_ref) == 0) {
@@ -48,7 +41,7 @@ obj_shard_decref(struct dc_obj_shard *shard)
 	D_SPIN_UNLOCK(&obj->cob_spin);
 
 	if (release)
-		D_FREE(layout);
+		obj_layout_release(layout);
 }
 
 void
@@ -83,7 +76,7 @@ dc_obj_shard_open(struct dc_object *obj, daos_unit_oid_t oid,
 	obj_shard_addref(shard); /* release this until obj_layout_free */
 
 	D_SPIN_LOCK(&obj->cob_spin);
-	obj->cob_shards->do_open_count++;
+	shard->do_layout->do_open_count++;
 	D_SPIN_UNLOCK(&obj->cob_spin);
 
 	return 0;
@@ -95,15 +88,306 @@ dc_obj_shard_close(struct dc_obj_shard *shard)
 	obj_shard_decref(shard);
 }
 
+/**
+ * Per engine target window of inflight shard tasks. Wide objects fan out
+ * one shard task per target, many clients doing that at the same time can
+ * overflow the target queues, so the number of inflight shard tasks to one
+ * target is limited by a window which is halved when the target reports a
+ * deep scheduler queue, and grows again by one per window of replies.
+ *
+ * The same per target entry also tracks the fetch latency for hedged reads.
+ */
+struct obj_tgt_win {
+	d_list_t		otw_link;
+	d_rank_t		otw_rank;
+	uint32_t		otw_tag;
+	uint32_t		otw_inflight;
+	uint32_t		otw_window;
+	/* replies since the last window change */
+	uint32_t		otw_acked;
+	/* fetch latency estimate */
+	struct obj_lat_est	otw_lat;
+};
+
+#define OBJ_TGT_WIN_BUCKETS	256
+/* default scheduler queue depth regarded as congestion */
+#define OBJ_TGT_WIN_DEPTH_DEF	64
+
+static struct obj_tgt_wins {
+	pthread_mutex_t		ow_lock;
+	d_list_t		ow_buckets[OBJ_TGT_WIN_BUCKETS];
+	/** max inflight shard tasks per target, 0 means no limit */
+	uint32_t		ow_max;
+	uint32_t		ow_depth;
+	/** statistics */
+	uint64_t		ow_throttled;
+	uint64_t		ow_congested;
+} obj_tgt_wins;
+
+/* default minimal delay before sending the hedged fetch */
+#define OBJ_HEDGE_MIN_DEF	500 /* us */
+
+/**
+ * Hedged replica reads: when a fetch from one replica takes longer than the
+ * configured percentile of the latency of its target, the same fetch is sent
+ * to another replica and the first reply wins, the other RPC is aborted.
+ */
+static struct obj_hedge {
+	/** latency percentile to send the hedged fetch at, 0 means disabled */
+	uint32_t		oh_pct;
+	/** minimal delay before sending the hedged fetch */
+	uint32_t		oh_min;
+	/** statistics, protected by ow_lock */
+	uint64_t		oh_sent;
+	uint64_t		oh_won;
+} obj_hedge;
+
+int
+obj_tgt_win_init(void)
+{
+	int	i;
+	int	rc;
+
+	obj_tgt_wins.ow_max = 0;
+	obj_tgt_wins.ow_depth = OBJ_TGT_WIN_DEPTH_DEF;
+	d_getenv_int("DAOS_OBJ_TGT_INFLIGHT", &obj_tgt_wins.ow_max);
+	d_getenv_int("DAOS_OBJ_TGT_CONGEST_DEPTH", &obj_tgt_wins.ow_depth);
+	if (obj_tgt_wins.ow_depth == 0)
+		obj_tgt_wins.ow_depth = OBJ_TGT_WIN_DEPTH_DEF;
+
+	obj_hedge.oh_pct = 0;
+	obj_hedge.oh_min = OBJ_HEDGE_MIN_DEF;
+	d_getenv_int("DAOS_OBJ_HEDGE_READ_PCT", &obj_hedge.oh_pct);
+	d_getenv_int("DAOS_OBJ_HEDGE_MIN_US", &obj_hedge.oh_min);
+	if (obj_hedge.oh_pct >= 100) {
+		D_WARN("Invalid hedged read percentile %u, disabled\n",
+		       obj_hedge.oh_pct);
+		obj_hedge.oh_pct = 0;
+	}
+
+	rc = D_MUTEX_INIT(&obj_tgt_wins.ow_lock, NULL);
+	if (rc)
+		return rc;
+
+	for (i = 0; i < OBJ_TGT_WIN_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&obj_tgt_wins.ow_buckets[i]);
+
+	if (obj_tgt_wins.ow_max != 0)
+		D_INFO("Per target inflight window %u, congestion depth %u\n",
+		       obj_tgt_wins.ow_max, obj_tgt_wins.ow_depth);
+	if (obj_hedge.oh_pct != 0)
+		D_INFO("Hedged reads at p%u of target latency, min %u us\n",
+		       obj_hedge.oh_pct, obj_hedge.oh_min);
+	return 0;
+}
+
+void
+obj_tgt_win_fini(void)
+{
+	struct obj_tgt_win	*win;
+	int			 i;
+
+	if (obj_tgt_wins.ow_max != 0)
+		D_INFO("Per target inflight window: "DF_U64" shard tasks "
+		       "throttled, "DF_U64" congestion reports\n",
+		       obj_tgt_wins.ow_throttled, obj_tgt_wins.ow_congested);
+	if (obj_hedge.oh_pct != 0)
+		D_INFO("Hedged reads: "DF_U64" sent, "DF_U64" won\n",
+		       obj_hedge.oh_sent, obj_hedge.oh_won);
+
+	for (i = 0; i < OBJ_TGT_WIN_BUCKETS; i++) {
+		while ((win = d_list_pop_entry(&obj_tgt_wins.ow_buckets[i],
+					       struct obj_tgt_win,
+					       otw_link)) != NULL)
+			D_FREE(win);
+	}
+	D_MUTEX_DESTROY(&obj_tgt_wins.ow_lock);
+}
+
+void
+dc_obj_tgt_stats_query(struct daos_obj_tgt_stats *stats)
+{
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	stats->ots_throttled = obj_tgt_wins.ow_throttled;
+	stats->ots_congested = obj_tgt_wins.ow_congested;
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+}
+
+static struct obj_tgt_win *
+obj_tgt_win_lookup(d_rank_t rank, uint32_t tag, bool create)
+{
+	struct obj_tgt_win	*win;
+	d_list_t		*head;
+
+	head = &obj_tgt_wins.ow_buckets[(rank * 31 + tag) %
+					OBJ_TGT_WIN_BUCKETS];
+	d_list_for_each_entry(win, head, otw_link) {
+		if (win->otw_rank == rank && win->otw_tag == tag)
+			return win;
+	}
+
+	if (!create)
+		return NULL;
+
+	D_ALLOC_PTR(win);
+	if (win == NULL)
+		return NULL;
+
+	win->otw_rank = rank;
+	win->otw_tag = tag;
+	win->otw_window = obj_tgt_wins.ow_max;
+	d_list_add(&win->otw_link, head);
+	return win;
+}
+
+/**
+ * Take one inflight slot of the target.
+ *
+ * \return	0 if the slot is taken or the window is disabled,
+ *		-DER_BUSY if the window of the target is full.
+ */
+int
+obj_tgt_win_acquire(d_rank_t rank, uint32_t tag)
+{
+	struct obj_tgt_win	*win;
+	int			 rc = 0;
+
+	if (obj_tgt_wins.ow_max == 0)
+		return 0;
+
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	/* failed to allocate the window, just do not limit it */
+	win = obj_tgt_win_lookup(rank, tag, true);
+	if (win != NULL) {
+		if (win->otw_inflight < win->otw_window) {
+			win->otw_inflight++;
+		} else {
+			obj_tgt_wins.ow_throttled++;
+			rc = -DER_BUSY;
+		}
+	}
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+
+	return rc;
+}
+
+void
+obj_tgt_win_release(d_rank_t rank, uint32_t tag)
+{
+	struct obj_tgt_win	*win;
+
+	if (obj_tgt_wins.ow_max == 0)
+		return;
+
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	win = obj_tgt_win_lookup(rank, tag, false);
+	if (win != NULL && win->otw_inflight > 0)
+		win->otw_inflight--;
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+}
+
+/* Adjust the window of the target per the queue depth in the reply */
+static void
+obj_tgt_win_feedback(d_rank_t rank, uint32_t tag, uint32_t depth)
+{
+	struct obj_tgt_win	*win;
+
+	if (obj_tgt_wins.ow_max == 0)
+		return;
+
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	win = obj_tgt_win_lookup(rank, tag, false);
+	if (win == NULL)
+		goto out;
+
+	win->otw_acked++;
+	if (depth >= obj_tgt_wins.ow_depth) {
+		/* Only shrink once for the replies of the same window */
+		if (win->otw_acked >= win->otw_window && win->otw_window > 1) {
+			win->otw_window = max(win->otw_window / 2, 1U);
+			win->otw_acked = 0;
+			obj_tgt_wins.ow_congested++;
+			D_DEBUG(DB_IO, "rank %u tag %u congested (depth %u), "
+				"window %u\n", rank, tag, depth,
+				win->otw_window);
+		}
+	} else if (win->otw_window < obj_tgt_wins.ow_max &&
+		   win->otw_acked >= win->otw_window) {
+		win->otw_window++;
+		win->otw_acked = 0;
+	}
+out:
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+}
+
+bool
+obj_hedge_enabled(void)
+{
+	return obj_hedge.oh_pct != 0;
+}
+
+/*
+ * Sample the fetch latency of the target, \a aborted means the fetch was
+ * aborted after \a lat usec, see obj_lat_est_abort().
+ */
+static void
+obj_tgt_lat_update(d_rank_t rank, uint32_t tag, uint64_t lat, bool aborted)
+{
+	struct obj_tgt_win	*win;
+
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	win = obj_tgt_win_lookup(rank, tag, true);
+	if (win == NULL)
+		goto out;
+
+	if (aborted)
+		obj_lat_est_abort(&win->otw_lat, lat, obj_hedge.oh_pct);
+	else
+		obj_lat_est_update(&win->otw_lat, lat, obj_hedge.oh_pct);
+out:
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+}
+
+/**
+ * Get the fetch latency EWMA of the target.
+ *
+ * \param[out] pct	the estimated hedge percentile of the latency
+ *
+ * \return		EWMA in usec, 0 if the target was never sampled.
+ */
+uint64_t
+obj_tgt_lat_get(d_rank_t rank, uint32_t tag, uint64_t *pct)
+{
+	struct obj_tgt_win	*win;
+	uint64_t		 lat = 0;
+
+	D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+	win = obj_tgt_win_lookup(rank, tag, false);
+	if (win != NULL) {
+		lat = win->otw_lat.ole_lat;
+		if (pct != NULL)
+			*pct = win->otw_lat.ole_pct / 100;
+	}
+	D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+
+	return lat;
+}
+
 struct rw_cb_args {
 	crt_rpc_t		*rpc;
 	daos_handle_t		*hdlp;
 	d_sg_list_t		*rwaa_sgls;
+	/* layout-only sgls packed into inline fetch request */
+	d_sg_list_t		*rwaa_shape_sgls;
 	daos_handle_t		coh;
 	unsigned int		*map_ver;
 	daos_iom_t		*maps;
 	crt_endpoint_t		tgt_ep;
 	struct shard_rw_args	*shard_args;
+	/* send time of the fetch to sample the target latency, 0 if not */
+	uint64_t		rwaa_sent;
+	/* the epoch of the hedged fetch is chosen by the client */
+	bool			rwaa_pinned;
 };
 
 static struct dcs_layout *
@@ -890,7 +1174,24 @@ dc_rw_cb(tse_task_t *task, void *arg)
 		D_GOTO(out, ret);
 	}
 
+	if (opc_get_rpc_ver(rw_args->rpc->cr_opc) == DAOS_OBJ_VERSION)
+		obj_tgt_win_feedback(rw_args->tgt_ep.ep_rank,
+				     rw_args->tgt_ep.ep_tag,
+				     orwo->orw_sched_depth);
+	if (rw_args->rwaa_sent != 0)
+		obj_tgt_lat_update(rw_args->tgt_ep.ep_rank,
+				   rw_args->tgt_ep.ep_tag,
+				   (daos_get_ntime() - rw_args->rwaa_sent) /
+				   NSEC_PER_USEC, false);
+
 	rc = obj_reply_get_status(rw_args->rpc);
+	/*
+	 * The non-TX fetch pinned to a client chosen epoch for hedging hit
+	 * the epoch uncertainty, retry it with a new epoch that is after the
+	 * conflict since the HLC has been synced via the reply.
+	 */
+	if (rc == -DER_TX_RESTART && rw_args->rwaa_pinned)
+		rc = -DER_TX_BUSY;
 	/*
 	 * orwo->orw_epoch may be set even when the status is nonzero (e.g.,
 	 * -DER_TX_RESTART and -DER_INPROGRESS).
@@ -1138,6 +1439,7 @@ out:
 	if (rc == -DER_CSUM && opc == DAOS_OBJ_RPC_FETCH)
 		dc_shard_csum_report(task, &rw_args->tgt_ep, rw_args->rpc);
 	crt_req_decref(rw_args->rpc);
+	D_FREE(rw_args->rwaa_shape_sgls);
 	dc_pool_put((struct dc_pool *)rw_args->hdlp);
 
 	if (ret == 0 || obj_retry_error(rc))
@@ -1145,6 +1447,47 @@ out:
 	return ret;
 }
 
+/*
+ * Inline fetch only needs the buffer layout of the sgls on the server side,
+ * the fetched data comes back in the reply. Pack shadow sgls with zero
+ * iov_len into the request, so the stale content of the destination buffers
+ * is neither copied into the request nor transferred to the server, which
+ * allocates the reply buffers per iov_buf_len (see obj_prep_fetch_sgls()).
+ */
+static int
+dc_rw_fetch_shape_sgls(d_sg_list_t *sgls, unsigned int nr,
+		       d_sg_list_t **shape_sgls)
+{
+	d_sg_list_t	*shape;
+	d_iov_t		*iovs;
+	unsigned int	 iov_nr = 0;
+	int		 i;
+	int		 j;
+
+	for (i = 0; i < nr; i++)
+		iov_nr += sgls[i].sg_nr;
+
+	/* one allocation for both the sgls and the iovs behind them */
+	D_ALLOC(shape, nr * sizeof(*shape) + iov_nr * sizeof(*iovs));
+	if (shape == NULL)
+		return -DER_NOMEM;
+
+	iovs = (d_iov_t *)&shape[nr];
+	for (i = 0; i < nr; i++) {
+		shape[i].sg_nr = sgls[i].sg_nr;
+		shape[i].sg_nr_out = sgls[i].sg_nr_out;
+		shape[i].sg_iovs = iovs;
+		for (j = 0; j < sgls[i].sg_nr; j++) {
+			iovs[j] = sgls[i].sg_iovs[j];
+			iovs[j].iov_len = 0;
+		}
+		iovs += sgls[i].sg_nr;
+	}
+
+	*shape_sgls = shape;
+	return 0;
+}
+
 static struct dc_pool *
 obj_shard_ptr2pool(struct dc_obj_shard *shard)
 {
@@ -1157,6 +1500,252 @@ obj_shard_ptr2pool(struct dc_obj_shard *shard)
 	return dc_hdl2pool(poh);
 }
 
+/* A fetch sent to one replica, which may be hedged with another replica */
+struct obj_hedge_req {
+	pthread_mutex_t		 ohr_lock;
+	tse_task_t		*ohr_task;
+	/* dc_rw_cb() arguments, registered with the winner RPC */
+	struct rw_cb_args	 ohr_rw_args;
+	/* the primary and the hedged RPC, NULL once handed to dc_rw_cb() */
+	crt_rpc_t		*ohr_rpcs[2];
+	uint64_t		 ohr_sent[2];
+	/* the replica to send the hedged RPC to */
+	crt_endpoint_t		 ohr_alt_ep;
+	daos_unit_oid_t		 ohr_alt_id;
+	uint32_t		 ohr_ref;
+	uint32_t		 ohr_inflight;
+	bool			 ohr_done;
+};
+
+static void
+obj_hedge_req_put(struct obj_hedge_req *hedge)
+{
+	uint32_t	ref;
+	int		i;
+
+	D_MUTEX_LOCK(&hedge->ohr_lock);
+	ref = --hedge->ohr_ref;
+	D_MUTEX_UNLOCK(&hedge->ohr_lock);
+	if (ref > 0)
+		return;
+
+	for (i = 0; i < 2; i++) {
+		if (hedge->ohr_rpcs[i] != NULL)
+			crt_req_decref(hedge->ohr_rpcs[i]);
+	}
+	D_MUTEX_DESTROY(&hedge->ohr_lock);
+	D_FREE(hedge);
+}
+
+static void
+obj_hedge_rpc_cb(const struct crt_cb_info *cb_info)
+{
+	struct obj_hedge_req	*hedge = cb_info->cci_arg;
+	crt_rpc_t		*rpc = cb_info->cci_rpc;
+	crt_rpc_t		*loser = NULL;
+	struct rw_cb_args	 rw_args;
+	uint64_t		 now = daos_get_ntime();
+	bool			 won = false;
+	int			 idx;
+	int			 rc = cb_info->cci_rc;
+
+	D_MUTEX_LOCK(&hedge->ohr_lock);
+	idx = (rpc == hedge->ohr_rpcs[0]) ? 0 : 1;
+	hedge->ohr_inflight--;
+	/* A failed RPC only completes the fetch if nothing else is inflight */
+	if (!hedge->ohr_done && (rc == 0 || hedge->ohr_inflight == 0)) {
+		hedge->ohr_done = true;
+		won = true;
+		/* hand the reference over to dc_rw_cb() */
+		hedge->ohr_rpcs[idx] = NULL;
+		loser = hedge->ohr_rpcs[1 - idx];
+		if (loser != NULL)
+			crt_req_addref(loser);
+	}
+	D_MUTEX_UNLOCK(&hedge->ohr_lock);
+
+	if (rc == 0)
+		obj_tgt_lat_update(rpc->cr_ep.ep_rank, rpc->cr_ep.ep_tag,
+				   (now - hedge->ohr_sent[idx]) / NSEC_PER_USEC,
+				   false);
+
+	if (won) {
+		if (loser != NULL) {
+			/*
+			 * The aborted RPC is never sampled, so account the time
+			 * the primary one took so far if the hedged one won,
+			 * otherwise a slow target keeps its low latency history
+			 * and is chosen again. The hedged RPC losing was sent
+			 * late, which says nothing about its target.
+			 */
+			if (idx == 1)
+				obj_tgt_lat_update(loser->cr_ep.ep_rank,
+						   loser->cr_ep.ep_tag,
+						   (now - hedge->ohr_sent[0]) /
+						   NSEC_PER_USEC, true);
+			crt_req_abort(loser);
+			crt_req_decref(loser);
+		}
+		if (idx == 1 && rc == 0) {
+			D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+			obj_hedge.oh_won++;
+			D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+		}
+
+		rw_args = hedge->ohr_rw_args;
+		rw_args.rpc = rpc;
+		rw_args.tgt_ep.ep_rank = rpc->cr_ep.ep_rank;
+		rw_args.tgt_ep.ep_tag = rpc->cr_ep.ep_tag;
+		if (tse_task_register_comp_cb(hedge->ohr_task, dc_rw_cb, &rw_args,
+					      sizeof(rw_args)) != 0) {
+			crt_req_decref(rpc);
+			D_FREE(rw_args.rwaa_shape_sgls);
+			dc_pool_put((struct dc_pool *)rw_args.hdlp);
+			if (rc == 0)
+				rc = -DER_NOMEM;
+		}
+		tse_task_complete(hedge->ohr_task, rc);
+	}
+
+	obj_hedge_req_put(hedge);
+}
+
+/*
+ * Fire the hedged fetch if the primary one did not complete yet. The fetch
+ * task has not completed, so the request arguments shared with the primary
+ * RPC are still valid. Only inline fetch is hedged, so the two RPCs do not
+ * share any bulk handle, and both of them read at the same epoch.
+ */
+static int
+obj_hedge_timer(tse_task_t *timer)
+{
+	struct obj_hedge_req	*hedge = tse_task_get_priv(timer);
+	struct obj_rw_in	*orw;
+	crt_rpc_t		*req = NULL;
+	int			 rc = 0;
+
+	D_MUTEX_LOCK(&hedge->ohr_lock);
+	if (hedge->ohr_done)
+		goto unlock;
+
+	rc = obj_req_create(daos_task2ctx(hedge->ohr_task), &hedge->ohr_alt_ep,
+			    DAOS_OBJ_RPC_FETCH, &req);
+	if (rc != 0)
+		goto unlock;
+
+	orw = crt_req_get(req);
+	*orw = *(struct obj_rw_in *)crt_req_get(hedge->ohr_rpcs[0]);
+	orw->orw_oid = hedge->ohr_alt_id;
+
+	crt_req_addref(req);
+	hedge->ohr_rpcs[1] = req;
+	hedge->ohr_sent[1] = daos_get_ntime();
+	hedge->ohr_inflight++;
+	hedge->ohr_ref++;
+unlock:
+	D_MUTEX_UNLOCK(&hedge->ohr_lock);
+
+	if (req != NULL) {
+		D_DEBUG(DB_IO, "hedge fetch "DF_UOID" to rank %d tag %d\n",
+			DP_UOID(hedge->ohr_alt_id), hedge->ohr_alt_ep.ep_rank,
+			hedge->ohr_alt_ep.ep_tag);
+		D_MUTEX_LOCK(&obj_tgt_wins.ow_lock);
+		obj_hedge.oh_sent++;
+		D_MUTEX_UNLOCK(&obj_tgt_wins.ow_lock);
+		/* the callback is called on failure as well */
+		crt_req_send(req, obj_hedge_rpc_cb, hedge);
+	} else if (rc != 0) {
+		D_DEBUG(DB_IO, "failed to create hedged fetch: "DF_RC"\n",
+			DP_RC(rc));
+	}
+
+	obj_hedge_req_put(hedge);
+	tse_task_complete(timer, 0);
+	return 0;
+}
+
+/*
+ * Prepare hedging the fetch to another replica if the primary target has a
+ * latency history and the object layer allows reading from another replica.
+ *
+ * \return	0 with *hedgep set to NULL if the fetch is not hedged.
+ */
+static int
+obj_hedge_prep(struct shard_rw_args *args, crt_endpoint_t *tgt_ep,
+	       tse_task_t *task, uint64_t *delay,
+	       struct obj_hedge_req **hedgep)
+{
+	struct obj_hedge_req	*hedge;
+	struct dc_obj_shard	*alt;
+	uint64_t		 pct = 0;
+	int			 idx;
+	int			 rc;
+
+	*hedgep = NULL;
+	if (obj_tgt_lat_get(tgt_ep->ep_rank, tgt_ep->ep_tag, &pct) == 0)
+		return 0;
+
+	idx = obj_hedge_shard_get(&args->auxi);
+	if (idx < 0)
+		return 0;
+
+	rc = obj_shard_open(args->auxi.obj, idx, args->auxi.map_ver, &alt);
+	if (rc != 0)
+		return 0;
+
+	D_ALLOC_PTR(hedge);
+	if (hedge == NULL) {
+		obj_shard_close(alt);
+		return -DER_NOMEM;
+	}
+
+	rc = D_MUTEX_INIT(&hedge->ohr_lock, NULL);
+	if (rc != 0) {
+		obj_shard_close(alt);
+		D_FREE(hedge);
+		return rc;
+	}
+
+	hedge->ohr_task = task;
+	hedge->ohr_alt_ep.ep_grp = tgt_ep->ep_grp;
+	hedge->ohr_alt_ep.ep_rank = alt->do_target_rank;
+	hedge->ohr_alt_ep.ep_tag = alt->do_target_idx;
+	hedge->ohr_alt_id = alt->do_id;
+	obj_shard_close(alt);
+
+	*delay = max(pct, (uint64_t)obj_hedge.oh_min);
+	*hedgep = hedge;
+	return 0;
+}
+
+/* Send the primary fetch and arm the timer of the hedged fetch */
+static int
+obj_hedge_send(struct obj_hedge_req *hedge, crt_rpc_t *req,
+	       struct rw_cb_args *rw_args, uint64_t delay)
+{
+	tse_task_t	*timer = NULL;
+	int		 rc;
+
+	hedge->ohr_rw_args = *rw_args;
+	/* the reference for dc_rw_cb() taken by dc_obj_shard_rw() */
+	hedge->ohr_rpcs[0] = req;
+	hedge->ohr_sent[0] = daos_get_ntime();
+	hedge->ohr_inflight = 1;
+	hedge->ohr_ref = 1;
+
+	/* Failed to create the timer, just send the fetch without hedging */
+	rc = tse_task_create(obj_hedge_timer, tse_task2sched(hedge->ohr_task),
+			     hedge, &timer);
+	if (rc == 0) {
+		hedge->ohr_ref++;
+		tse_task_schedule_with_delay(timer, false, delay);
+	}
+
+	/* the callback is called on failure as well */
+	crt_req_send(req, obj_hedge_rpc_cb, hedge);
+	return 0;
+}
+
 int
 dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 		void *shard_args, struct daos_shard_tgt *fw_shard_tgts,
@@ -1214,6 +1803,7 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	tgt_ep.ep_tag = shard->do_target_idx;
 	tgt_ep.ep_rank = shard->do_target_rank;
 	rw_args.tgt_ep = tgt_ep;
+	rw_args.rwaa_shape_sgls = NULL;
 	if ((int)tgt_ep.ep_rank < 0)
 		D_GOTO(out_pool, rc = (int)tgt_ep.ep_rank);
 
@@ -1289,6 +1879,14 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 			/* NULL bulk/sgl for size_fetch or check existence */
 			orw->orw_sgls.ca_count = 0;
 			orw->orw_sgls.ca_arrays = NULL;
+		} else if (opc == DAOS_OBJ_RPC_FETCH && sgls != NULL) {
+			/* Only pack the buffer layout for inline fetch */
+			rc = dc_rw_fetch_shape_sgls(sgls, nr,
+						    &rw_args.rwaa_shape_sgls);
+			if (rc != 0)
+				D_GOTO(out_req, rc);
+			orw->orw_sgls.ca_count = nr;
+			orw->orw_sgls.ca_arrays = rw_args.rwaa_shape_sgls;
 		} else {
 			/* Transfer data inline */
 			if (sgls != NULL)
@@ -1333,6 +1931,40 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 	if (DAOS_FAIL_CHECK(DAOS_SHARD_OBJ_RW_CRT_ERROR))
 		D_GOTO(out_args, rc = -DER_HG);
 
+	rw_args.rwaa_sent = 0;
+	rw_args.rwaa_pinned = false;
+	if (opc == DAOS_OBJ_RPC_FETCH && obj_hedge.oh_pct != 0 &&
+	    !(daos_io_bypass & IOBP_CLI_RPC)) {
+		struct obj_hedge_req	*hedge = NULL;
+		uint64_t		 delay;
+
+		/*
+		 * Bulk fetch is not hedged: the server bulk transfer cannot be
+		 * stopped by aborting the losing RPC, then two replicas would
+		 * write into the user buffer, even after the task completion.
+		 */
+		if (args->bulks == NULL) {
+			rc = obj_hedge_prep(args, &tgt_ep, task, &delay, &hedge);
+			if (rc != 0)
+				D_GOTO(out_args, rc);
+		}
+		if (hedge != NULL) {
+			/*
+			 * Pin both replicas to the same epoch, the uncertainty
+			 * is checked against it as TX fetch does.
+			 */
+			if (!dtx_epoch_chosen(&auxi->epoch)) {
+				orw->orw_epoch = crt_hlc_get();
+				orw->orw_epoch_first = orw->orw_epoch;
+				orw->orw_flags |= ORF_EPOCH_UNCERTAIN;
+				rw_args.rwaa_pinned = true;
+			}
+			return obj_hedge_send(hedge, req, &rw_args, delay);
+		}
+
+		rw_args.rwaa_sent = daos_get_ntime();
+	}
+
 	rc = tse_task_register_comp_cb(task, dc_rw_cb, &rw_args,
 				       sizeof(rw_args));
 	if (rc != 0)
@@ -1358,6 +1990,7 @@ dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 out_args:
 	crt_req_decref(req);
 out_req:
+	D_FREE(rw_args.rwaa_shape_sgls);
 	crt_req_decref(req);
 out_pool:
 	dc_pool_put(pool);
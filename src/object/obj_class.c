@@ -346,6 +346,35 @@ static daos_sort_ops_t	ecc_redun_sort_ops = {
 	.so_cmp_key	= ecc_sop_redun_cmp_key,
 };
 
+/**
+ * Decode tables of one failure pattern, generating them costs more than the
+ * decoding itself for small cells, so they are cached per EC class.
+ */
+struct obj_ec_dec_tbl {
+	d_list_t		 edt_link;
+	uint32_t		 edt_nerrs;
+	uint32_t		 edt_err_list[OBJ_EC_MAX_P];
+	uint32_t		 edt_dec_idx[OBJ_EC_MAX_K];
+	/* k * nerrs * 32 bytes of GF tables */
+	unsigned char		 edt_gftbls[0];
+};
+
+/** max number of cached failure patterns per EC class */
+#define OBJ_EC_DEC_TBL_MAX	32
+
+static void
+obj_ec_dec_tbls_free(struct obj_ec_codec *ec_codec)
+{
+	struct obj_ec_dec_tbl	*tbl;
+
+	while ((tbl = d_list_pop_entry(&ec_codec->ec_dec_tbls,
+				       struct obj_ec_dec_tbl,
+				       edt_link)) != NULL)
+		D_FREE(tbl);
+	ec_codec->ec_dec_nr = 0;
+	D_MUTEX_DESTROY(&ec_codec->ec_dec_lock);
+}
+
 void
 obj_ec_codec_fini(void)
 {
@@ -376,6 +405,8 @@ obj_ec_codec_fini(void)
 			D_FREE(ec_codec->ec_en_matrix);
 		if (ec_codec->ec_gftbls != NULL)
 			D_FREE(ec_codec->ec_gftbls);
+		if (ec_codec->ec_dec_tbls.next != NULL)
+			obj_ec_dec_tbls_free(ec_codec);
 	}
 
 	D_FREE(oc_ec_codecs);
@@ -438,6 +469,12 @@ obj_ec_codec_init()
 			D_GOTO(failed, rc = -DER_INVAL);
 		}
 		m = k + p;
+		ec_codec->ec_k = k;
+		ec_codec->ec_p = p;
+		rc = D_MUTEX_INIT(&ec_codec->ec_dec_lock, NULL);
+		if (rc)
+			D_GOTO(failed, rc);
+		D_INIT_LIST_HEAD(&ec_codec->ec_dec_tbls);
 		/* 32B needed for data generated for each input coefficient */
 		D_ALLOC(ec_codec->ec_gftbls, k * p * 32);
 		if (ec_codec->ec_gftbls == NULL)
@@ -486,6 +523,130 @@ obj_ec_codec_get(daos_oclass_id_t oc_id)
 	return &ecc_array[idx]->ec_codec;
 }
 
+/**
+ * Generate the decode GF tables and the decode index for the failure pattern
+ * \a err_list, the data targets in error should be ahead of the parity ones.
+ */
+int
+obj_ec_dec_tbl_gen(struct obj_ec_codec *codec, uint32_t nerrs,
+		   uint32_t *err_list, unsigned char *gftbls,
+		   uint32_t *dec_idx)
+{
+	unsigned char	*b_matrix, *inv_matrix, *de_matrix;
+	bool		 in_err[OBJ_EC_MAX_M] = { 0 };
+	uint32_t	 k = codec->ec_k;
+	uint32_t	 p = codec->ec_p;
+	uint32_t	 data_nerrs = 0;
+	uint32_t	 i, j, r;
+	unsigned char	 s;
+	int		 rc;
+
+	D_ASSERT(nerrs > 0 && nerrs <= p);
+	for (i = 0; i < nerrs; i++) {
+		D_ASSERT(err_list[i] < k + p);
+		in_err[err_list[i]] = true;
+		if (err_list[i] < k)
+			data_nerrs++;
+	}
+
+	D_ALLOC(b_matrix, 2 * k * k + (k + p) * k);
+	if (b_matrix == NULL)
+		return -DER_NOMEM;
+	inv_matrix = b_matrix + k * k;
+	de_matrix = inv_matrix + k * k;
+
+	/* Construct matrix b by removing error rows */
+	for (i = 0, r = 0; i < k; i++, r++) {
+		while (in_err[r])
+			r++;
+		for (j = 0; j < k; j++)
+			b_matrix[k * i + j] = codec->ec_en_matrix[k * r + j];
+		dec_idx[i] = r;
+	}
+
+	/* Cauchy matrix is always invertible, should not fail */
+	rc = gf_invert_matrix(b_matrix, inv_matrix, k);
+	D_ASSERT(rc == 0);
+
+	/* Generate decode matrix (err_list from invert matrix) */
+	for (i = 0; i < data_nerrs; i++) {
+		for (j = 0; j < k; j++)
+			de_matrix[k * i + j] = inv_matrix[k * err_list[i] + j];
+	}
+	/* err_list from encode_matrix * invert matrix, for parity decoding */
+	for (p = data_nerrs; p < nerrs; p++) {
+		for (i = 0; i < k; i++) {
+			s = 0;
+			for (j = 0; j < k; j++)
+				s ^= gf_mul(inv_matrix[j * k + i],
+					    codec->ec_en_matrix[k * err_list[p]
+								+ j]);
+			de_matrix[k * p + i] = s;
+		}
+	}
+
+	ec_init_tables(k, nerrs, de_matrix, gftbls);
+	D_FREE(b_matrix);
+	return 0;
+}
+
+/**
+ * Get the decode tables for the failure pattern \a err_list, from the cache
+ * of the EC class if possible, otherwise generate and cache them.
+ */
+int
+obj_ec_dec_tbl_get(struct obj_ec_codec *codec, uint32_t nerrs,
+		   uint32_t *err_list, unsigned char *gftbls,
+		   uint32_t *dec_idx)
+{
+	struct obj_ec_dec_tbl	*tbl;
+	uint32_t		 k = codec->ec_k;
+	size_t			 tbl_size = k * nerrs * 32;
+	int			 rc;
+
+	D_MUTEX_LOCK(&codec->ec_dec_lock);
+	d_list_for_each_entry(tbl, &codec->ec_dec_tbls, edt_link) {
+		if (tbl->edt_nerrs != nerrs ||
+		    memcmp(tbl->edt_err_list, err_list,
+			   sizeof(*err_list) * nerrs) != 0)
+			continue;
+
+		memcpy(gftbls, tbl->edt_gftbls, tbl_size);
+		memcpy(dec_idx, tbl->edt_dec_idx, sizeof(*dec_idx) * k);
+		d_list_move(&tbl->edt_link, &codec->ec_dec_tbls);
+		D_MUTEX_UNLOCK(&codec->ec_dec_lock);
+		return 0;
+	}
+	D_MUTEX_UNLOCK(&codec->ec_dec_lock);
+
+	rc = obj_ec_dec_tbl_gen(codec, nerrs, err_list, gftbls, dec_idx);
+	if (rc)
+		return rc;
+
+	/* failed to cache is not fatal */
+	D_ALLOC(tbl, sizeof(*tbl) + tbl_size);
+	if (tbl == NULL)
+		return 0;
+
+	tbl->edt_nerrs = nerrs;
+	memcpy(tbl->edt_err_list, err_list, sizeof(*err_list) * nerrs);
+	memcpy(tbl->edt_dec_idx, dec_idx, sizeof(*dec_idx) * k);
+	memcpy(tbl->edt_gftbls, gftbls, tbl_size);
+
+	D_MUTEX_LOCK(&codec->ec_dec_lock);
+	d_list_add(&tbl->edt_link, &codec->ec_dec_tbls);
+	if (++codec->ec_dec_nr > OBJ_EC_DEC_TBL_MAX) {
+		tbl = d_list_entry(codec->ec_dec_tbls.prev,
+				   struct obj_ec_dec_tbl, edt_link);
+		d_list_del(&tbl->edt_link);
+		codec->ec_dec_nr--;
+		D_FREE(tbl);
+	}
+	D_MUTEX_UNLOCK(&codec->ec_dec_lock);
+
+	return 0;
+}
+
 static void
 oc_sop_swap(void *array, int a, int b)
 {
@@ -38,6 +38,13 @@ struct obj_ec_codec {
 	 * from coding coefficients. Needed for both encoding and decoding.
 	 */
 	unsigned char		*ec_gftbls;
+	/** number of data and parity targets */
+	uint16_t		 ec_k;
+	uint16_t		 ec_p;
+	/** cached decode tables (struct obj_ec_dec_tbl), in LRU order */
+	d_list_t		 ec_dec_tbls;
+	uint32_t		 ec_dec_nr;
+	pthread_mutex_t		 ec_dec_lock;
 };
 
 /** Shard IO descriptor */
@@ -130,6 +137,8 @@ struct obj_ec_recx_array {
 	uint32_t		 oer_last;
 	/** parity buffer pointer array, one for each parity tgt */
 	uint8_t			*oer_pbufs[OBJ_EC_MAX_P];
+	/** allocated length of the parity buffer (oer_pbufs[0]) */
+	uint64_t		 oer_pbuf_len;
 	/** total number of full stripes in oer_recxs array */
 	uint32_t		 oer_stripe_total;
 	/** number of valid items in oer_recxs array */
@@ -206,9 +215,6 @@ struct obj_ec_seg_sorter {
 /** ISAL codec for EC data recovery */
 struct obj_ec_recov_codec {
 	unsigned char		*er_gftbls;	/* GF tables */
-	unsigned char		*er_de_matrix;	/* decode matrix */
-	unsigned char		*er_inv_matrix;	/* invert matrix */
-	unsigned char		*er_b_matrix;	/* temporary b matrix */
 	uint32_t		*er_dec_idx;	/* decode index */
 	uint32_t		*er_err_list;	/* target idx list in error */
 	bool			*er_in_err;	/* boolean array for targets */
@@ -226,7 +232,8 @@ struct obj_ec_recov_task {
 	d_sg_list_t		ert_sgl;
 	daos_epoch_t		ert_epoch;
 	daos_handle_t		ert_th;		/* read-only tx handle */
-	uint32_t		ert_snapshot:1;	/* For snapshot flag */
+	uint32_t		ert_snapshot:1,	/* For snapshot flag */
+				ert_cached:1;	/* Stripes from recovery cache */
 };
 
 /** EC obj IO failure information */
@@ -253,6 +260,12 @@ struct obj_ec_fail_info {
 	 */
 	struct obj_ec_recov_task	*efi_recov_tasks;
 	uint32_t			 efi_recov_ntasks;
+	/* pool map version used by the degraded fetch */
+	uint32_t			 efi_map_ver;
+	/* dkey of the degraded fetch, for the recovery cache */
+	daos_key_t			*efi_dkey;
+	/* per-container cache of recovered stripes, NULL if disabled */
+	struct obj_ec_rcache		*efi_rcache;
 };
 
 struct obj_reasb_req;
@@ -639,10 +652,56 @@ obj_shard_is_ec_parity(daos_unit_oid_t oid, struct daos_oclass_attr *attr)
 	return is_ec_parity_shard(oid.id_shard, attr);
 }
 
+/**
+ * Incrementally update the parity cells with the data cells in @bit_map.
+ * @odata and @data hold the old and new data of the @cell_cnt cells in the
+ * order of the bits set in @bit_map, @diff is the scratch buffer of one cell.
+ * @diff_prep (optional) is called with the delta of each cell before it is
+ * encoded into the parity.
+ */
+static inline int
+obj_ec_parity_delta_update(unsigned char *gftbls, unsigned int k,
+			   unsigned int p, unsigned int cell_bytes,
+			   uint8_t *bit_map, unsigned int cell_cnt,
+			   unsigned char *odata, unsigned char *data,
+			   unsigned char *diff, unsigned char **parity_bufs,
+			   void (*diff_prep)(void *arg, unsigned char *diff,
+					     unsigned int cell_idx),
+			   void *arg)
+{
+	unsigned char	*vects[3];
+	unsigned int	 i, j;
+	int		 rc;
+
+	for (i = 0, j = 0; i < cell_cnt; i++, j++) {
+		vects[0] = &odata[i * cell_bytes];
+		vects[1] = &data[i * cell_bytes];
+		vects[2] = diff;
+		rc = xor_gen(3, cell_bytes, (void **)vects);
+		if (rc)
+			return rc;
+		while (j < k && !isset(bit_map, j))
+			j++;
+		D_ASSERT(j < k);
+		if (diff_prep != NULL)
+			diff_prep(arg, diff, j);
+		ec_encode_data_update(cell_bytes, k, p, j, gftbls, diff,
+				      parity_bufs);
+	}
+
+	return 0;
+}
+
 /* obj_class.c */
 int obj_ec_codec_init(void);
 void obj_ec_codec_fini(void);
 struct obj_ec_codec *obj_ec_codec_get(daos_oclass_id_t oc_id);
+int obj_ec_dec_tbl_gen(struct obj_ec_codec *codec, uint32_t nerrs,
+		       uint32_t *err_list, unsigned char *gftbls,
+		       uint32_t *dec_idx);
+int obj_ec_dec_tbl_get(struct obj_ec_codec *codec, uint32_t nerrs,
+		       uint32_t *err_list, unsigned char *gftbls,
+		       uint32_t *dec_idx);
 
 static inline struct obj_ec_codec *
 obj_id2ec_codec(daos_obj_id_t id)
@@ -685,6 +744,11 @@ obj_ec_parity_lists_match(struct daos_recx_ep_list *lists_1,
 }
 
 /* cli_ec.c */
+extern unsigned int obj_ec_rcache_mb;
+int obj_ec_enc_pool_init(void);
+void obj_ec_enc_pool_fini(void);
+void obj_ec_recov_cache_fill(struct obj_reasb_req *reasb_req, daos_obj_id_t oid,
+			     daos_iod_t *iods, uint32_t iod_nr);
 int obj_ec_req_reasb(daos_iod_t *iods, d_sg_list_t *sgls, daos_obj_id_t oid,
 		     struct daos_oclass_attr *oca,
 		     struct obj_reasb_req *reasb_req,
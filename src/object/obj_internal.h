@@ -24,6 +24,7 @@
 #include <daos/object.h>
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/dtx_srv.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_producer.h>
 
@@ -45,6 +46,8 @@ struct obj_io_context;
 extern bool	cli_bypass_rpc;
 /** Switch of server-side IO dispatch */
 extern unsigned int	srv_io_mode;
+/** Max number of layouts cached per container handle, 0 to disable */
+extern unsigned int	obj_layout_cache_max;
 
 /** client object shard */
 struct dc_obj_shard {
@@ -58,6 +61,8 @@ struct dc_obj_shard {
 	struct pl_obj_shard	do_pl_shard;
 	/** point back to object */
 	struct dc_object	*do_obj;
+	/** point back to the layout the shard was allocated for */
+	struct dc_obj_layout	*do_layout;
 	uint32_t		do_shard_idx;
 	uint8_t			do_target_idx;	/* target VOS index in node */
 };
@@ -68,11 +73,35 @@ struct dc_obj_shard {
 #define do_rebuilding	do_pl_shard.po_rebuilding
 #define do_reintegrating do_pl_shard.po_reintegrating
 
+/**
+ * Placement result of an object, it is immutable and shared by all open
+ * handles of the object with the same pool map version in the container.
+ */
+struct obj_shared_layout {
+	/** link chain in the layout cache of the container */
+	d_list_t		osl_hash_link;
+	d_list_t		osl_lru_link;
+	daos_obj_id_t		osl_oid;
+	/** pool map version the layout is generated with */
+	uint32_t		osl_map_ver;
+	/** layout version */
+	uint32_t		osl_ver;
+	ATOMIC uint32_t		osl_ref;
+	uint32_t		osl_nr;
+	uint32_t		osl_grp_size;
+	/** generated for read-only open, no extending shards */
+	bool			osl_ro;
+	struct pl_obj_shard	osl_shards[0];
+};
+
 /** client object layout */
 struct dc_obj_layout {
 	/** The reference for the shards that are opened (in-using). */
-	unsigned int		do_open_count;
-	struct dc_obj_shard	do_shards[0];
+	unsigned int		 do_open_count;
+	/** shared placement result */
+	struct obj_shared_layout *do_plo;
+	/** shards are allocated on the first open */
+	struct dc_obj_shard	*do_shards[0];
 };
 
 /** Client stack object */
@@ -281,6 +310,91 @@ migrate_pool_tls_destroy(struct migrate_pool_tls *tls);
  */
 #define NR_LATENCY_BUCKETS 16
 
+/*
+ * Slots of the Space-Saving sketch that samples the dkeys hit by restarted
+ * (conflicting) operations. The dkey hash of a slot may be over-counted by
+ * the hits of the slot's evicted dkey hash, but any dkey hash hit more than
+ * 1/OBJ_HOT_DKEY_NR of the conflicts is guaranteed to hold a slot.
+ */
+#define OBJ_HOT_DKEY_NR	8
+
+struct obj_hot_dkey {
+	uint64_t		ohd_hash;
+	uint64_t		ohd_hits;
+};
+
+/**
+ * Account \a dkey_hash into the Space-Saving \a sketch, return its slot. The
+ * slots are never released, the unused ones are at the tail. If the hash has
+ * no slot and all of them are used, the least hit one is evicted and its hits
+ * are inherited.
+ */
+static inline int
+obj_hot_dkey_sketch_add(struct obj_hot_dkey *sketch, uint64_t dkey_hash)
+{
+	int	idx = 0;
+	int	i;
+
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++) {
+		if (sketch[i].ohd_hash == dkey_hash || sketch[i].ohd_hits == 0) {
+			idx = i;
+			break;
+		}
+
+		if (sketch[i].ohd_hits < sketch[idx].ohd_hits)
+			idx = i;
+	}
+
+	sketch[idx].ohd_hash = dkey_hash;
+	sketch[idx].ohd_hits++;
+
+	return idx;
+}
+
+/** Fetch latency estimate of a target */
+struct obj_lat_est {
+	/* latency EWMA in usec, 0 if never sampled */
+	uint64_t		ole_lat;
+	/* estimate of the hedge percentile of the latency, in 1/100 usec */
+	uint64_t		ole_pct;
+};
+
+/*
+ * Sample the fetch latency \a lat of the target. The EWMA drives the replica
+ * choice, the percentile is tracked by a streaming estimator that moves up by
+ * pct and down by (100 - pct) steps, which settles where pct% of samples are
+ * below.
+ */
+static inline void
+obj_lat_est_update(struct obj_lat_est *est, uint64_t lat, uint32_t pct)
+{
+	uint64_t	step;
+
+	if (est->ole_lat == 0) {
+		est->ole_lat = max(lat, 1UL);
+		est->ole_pct = est->ole_lat * 100;
+		return;
+	}
+
+	est->ole_lat = max((est->ole_lat * 7 + lat) / 8, 1UL);
+	step = max(est->ole_lat / 16, 1UL);
+	if (lat * 100 > est->ole_pct)
+		est->ole_pct += step * pct;
+	else
+		est->ole_pct -= min(est->ole_pct, step * (100 - pct));
+}
+
+/**
+ * Account a fetch aborted after \a lat usec. That only tells the target is
+ * not faster than \a lat, so the sample is clamped to the current EWMA and an
+ * aborted fetch never lowers the estimate.
+ */
+static inline void
+obj_lat_est_abort(struct obj_lat_est *est, uint64_t lat, uint32_t pct)
+{
+	obj_lat_est_update(est, max(lat, est->ole_lat), pct);
+}
+
 struct obj_pool_metrics {
 	/** Count number of total per-opcode requests (type = counter) */
 	struct d_tm_node_t	*opm_total[OBJ_PROTO_CLI_COUNT];
@@ -295,11 +409,42 @@ struct obj_pool_metrics {
 	struct d_tm_node_t	*opm_update_resent;
 	/** Total number of retry update operations (type = counter) */
 	struct d_tm_node_t	*opm_update_retry;
+	/** Partial stripes aggregated by delta parity update (type = counter) */
+	struct d_tm_node_t	*opm_ec_agg_delta;
+	/** Partial stripes aggregated by parity recalculation (type = counter) */
+	struct d_tm_node_t	*opm_ec_agg_recalc;
+	/** Bytes read to aggregate partial stripes (type = counter) */
+	struct d_tm_node_t	*opm_ec_agg_read_bytes;
+	/** Bytes not read thanks to delta parity update (type = counter) */
+	struct d_tm_node_t	*opm_ec_agg_saved_bytes;
+	/** Latency of update forwarded to one replica in us (type = stats gauge) */
+	struct d_tm_node_t	*opm_fwd_update_lat;
+	/** Updates relayed to replicas by the leader (type = counter) */
+	struct d_tm_node_t	*opm_fwd_relay;
+	/** Bytes pulled by replicas from the leader (type = counter) */
+	struct d_tm_node_t	*opm_fwd_relay_bytes;
+	/** Modifications restarted by conflicting reads (type = counter) */
+	struct d_tm_node_t	*opm_conflict_rw;
+	/** Reads restarted because of epoch uncertainty (type = counter) */
+	struct d_tm_node_t	*opm_conflict_uncertain;
+	/** The most contended dkey hashes and their hits (type = gauge) */
+	struct d_tm_node_t	*opm_hot_dkey[OBJ_HOT_DKEY_NR];
+	struct d_tm_node_t	*opm_hot_dkey_hits[OBJ_HOT_DKEY_NR];
+	/** DTXs dispatched via coalesced CPD RPCs (type = counter) */
+	struct d_tm_node_t	*opm_cpd_coalesced;
+
+	/*
+	 * Not metrics, only the metric nodes above are counted by
+	 * obj_metrics_count(), keep it as the last member.
+	 */
+	struct obj_hot_dkey	 opm_hot_sketch[OBJ_HOT_DKEY_NR];
 };
 
 struct obj_tls {
 	d_sg_list_t		ot_echo_sgl;
 	d_list_t		ot_pool_list;
+	/** CPD dispatches being coalesced, see obj_cpd_batch_add() */
+	d_list_t		ot_cpd_batches;
 
 	/** Measure per-operation latency in us (type = gauge) */
 	struct d_tm_node_t	*ot_op_lat[OBJ_PROTO_CLI_COUNT];
@@ -507,6 +652,14 @@ int dc_obj_shard_open(struct dc_object *obj, daos_unit_oid_t id,
 		      unsigned int mode, struct dc_obj_shard *shard);
 void dc_obj_shard_close(struct dc_obj_shard *shard);
 
+int obj_tgt_win_init(void);
+void obj_tgt_win_fini(void);
+int obj_tgt_win_acquire(d_rank_t rank, uint32_t tag);
+void obj_tgt_win_release(d_rank_t rank, uint32_t tag);
+bool obj_hedge_enabled(void);
+uint64_t obj_tgt_lat_get(d_rank_t rank, uint32_t tag, uint64_t *pct);
+int obj_hedge_shard_get(struct shard_auxi_args *shard_auxi);
+
 int dc_obj_shard_rw(struct dc_obj_shard *shard, enum obj_rpc_opc opc,
 		    void *shard_args, struct daos_shard_tgt *fw_shard_tgts,
 		    uint32_t fw_cnt, tse_task_t *task);
@@ -578,7 +731,7 @@ obj_get_shard(void *data, int idx)
 {
 	struct dc_object	*obj = data;
 
-	return &obj->cob_shards->do_shards[idx].do_pl_shard;
+	return &obj->cob_shards->do_plo->osl_shards[idx];
 }
 
 static inline bool
@@ -646,12 +799,48 @@ dc_sgl_out_set(d_sg_list_t *sgl, daos_size_t data_size)
 
 void obj_shard_decref(struct dc_obj_shard *shard);
 void obj_shard_addref(struct dc_obj_shard *shard);
+void obj_layout_release(struct dc_obj_layout *layout);
 void obj_addref(struct dc_object *obj);
 void obj_decref(struct dc_object *obj);
 int obj_get_grp_size(struct dc_object *obj);
 struct dc_object *obj_hdl2ptr(daos_handle_t oh);
 
 /* handles, pointers for handling I/O */
+/**
+ * DRAM copy of the update data made by the leader, the replicas pull the data
+ * from it instead of from the client, see obj_fwd_relay_size.
+ */
+struct obj_fwd_buf {
+	/** one SG list per iod, referring to ofb_buf */
+	d_sg_list_t		*ofb_sgls;
+	/** bulk handles (bound to the leader) exported to the replicas */
+	crt_bulk_t		*ofb_bulks;
+	uint32_t		 ofb_nr;
+	daos_size_t		 ofb_size;
+	void			*ofb_buf;
+};
+
+/**
+ * Minimal size of replicated update that the leader relays to the replicas,
+ * zero means the replicas always pull the data from the client. Configured
+ * by DAOS_OBJ_FWD_RELAY_SIZE.
+ */
+extern unsigned int obj_fwd_relay_size;
+
+/**
+ * Max size of replicated update that the leader relays, larger ones are pulled
+ * by the replicas from the client, to bound the DRAM held by each relay.
+ */
+#define OBJ_FWD_RELAY_MAX	(64ULL << 20)
+
+/**
+ * Max DTXs that the leader coalesces into one CPD RPC to the same follower
+ * target, 0 or 1 means no coalescing. Configured by DAOS_OBJ_CPD_BATCH, all
+ * the engines must support coalesced CPD RPC before enabling it.
+ */
+#define OBJ_CPD_BATCH_MAX	32
+extern unsigned int obj_cpd_batch_size;
+
 struct obj_io_context {
 	struct ds_cont_hdl	*ioc_coh;
 	struct ds_cont_child	*ioc_coc;
@@ -660,7 +849,10 @@ struct obj_io_context {
 	uint32_t		 ioc_map_ver;
 	uint32_t		 ioc_opc;
 	uint64_t		 ioc_start_time;
+	/* The dkey hash of single dkey operations, zero for others. */
+	uint64_t		 ioc_dkey_hash;
 	uint64_t		 ioc_io_size;
+	struct obj_fwd_buf	*ioc_fwd_buf;
 	uint32_t		 ioc_began:1,
 				 ioc_free_sgls:1,
 				 ioc_lost_reply:1,
@@ -691,7 +883,6 @@ void ds_obj_tgt_update_handler(crt_rpc_t *rpc);
 void ds_obj_enum_handler(crt_rpc_t *rpc);
 void ds_obj_punch_handler(crt_rpc_t *rpc);
 void ds_obj_tgt_punch_handler(crt_rpc_t *rpc);
-void ds_obj_query_key_handler_0(crt_rpc_t *rpc);
 void ds_obj_query_key_handler_1(crt_rpc_t *rpc);
 void ds_obj_sync_handler(crt_rpc_t *rpc);
 void ds_obj_migrate_handler(crt_rpc_t *rpc);
@@ -942,6 +1133,9 @@ dc_tx_attach(daos_handle_t th, struct dc_object *obj, enum obj_rpc_opc opc,
 int
 dc_tx_convert(struct dc_object *obj, enum obj_rpc_opc opc, tse_task_t *task);
 
+int
+dc_tx_update_multi(struct dc_object *obj, tse_task_t *task);
+
 /* obj_enum.c */
 int
 fill_oid(daos_unit_oid_t oid, struct dss_enum_arg *arg);
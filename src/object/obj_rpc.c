@@ -1015,6 +1015,7 @@ out:
 	return rc;
 }
 
+CRT_RPC_DEFINE(obj_rw_0, DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW_0)
 CRT_RPC_DEFINE(obj_rw, DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 CRT_RPC_DEFINE(obj_key_enum, DAOS_ISEQ_OBJ_KEY_ENUM, DAOS_OSEQ_OBJ_KEY_ENUM)
 CRT_RPC_DEFINE(obj_punch, DAOS_ISEQ_OBJ_PUNCH, DAOS_OSEQ_OBJ_PUNCH)
@@ -31,26 +31,17 @@
  * These are for daos_rpc::dr_opc and DAOS_RPC_OPCODE(opc, ...) rather than
  * crt_req_create(..., opc, ...). See daos_rpc.h.
  */
-#define DAOS_OBJ_VERSION 8
+#define DAOS_OBJ_VERSION 9
 /* LIST of internal RPCS in form of:
  * OPCODE, flags, FMT, handler, corpc_hdlr and name
  */
 
-#define QUERY_KEY_0							\
-	X(DAOS_OBJ_RPC_QUERY_KEY,					\
-		0, &CQF_obj_query_key,					\
-		ds_obj_query_key_handler_0, NULL, "key_query")
-#define QUERY_KEY_1							\
-	X(DAOS_OBJ_RPC_QUERY_KEY,					\
-		0, &CQF_obj_query_key,					\
-		ds_obj_query_key_handler_1, NULL, "key_query")
-
 #define OBJ_PROTO_CLI_RPC_LIST(ver)					\
 	X(DAOS_OBJ_RPC_UPDATE,						\
-		0, &CQF_obj_rw,						\
+		0, ver == 0 ? &CQF_obj_rw_0 : &CQF_obj_rw,		\
 		ds_obj_rw_handler, NULL, "update")			\
 	X(DAOS_OBJ_RPC_FETCH,						\
-		0, &CQF_obj_rw,						\
+		0, ver == 0 ? &CQF_obj_rw_0 : &CQF_obj_rw,		\
 		ds_obj_rw_handler, NULL, "fetch")			\
 	X(DAOS_OBJ_DKEY_RPC_ENUMERATE,					\
 		0, &CQF_obj_key_enum,					\
@@ -74,14 +65,13 @@
 		0, &CQF_obj_punch,					\
 		ds_obj_punch_handler, NULL, "akey_punch")		\
 	X(DAOS_OBJ_RPC_QUERY_KEY,					\
-	  0, ver == 0 ? &CQF_obj_query_key_0 : &CQF_obj_query_key_1,	\
-	  ver == 0 ? ds_obj_query_key_handler_0 :			\
-	  ds_obj_query_key_handler_1, NULL, "key_query")		\
+		0, &CQF_obj_query_key_1,				\
+		ds_obj_query_key_handler_1, NULL, "key_query")		\
 	X(DAOS_OBJ_RPC_SYNC,						\
 		0, &CQF_obj_sync,					\
 		ds_obj_sync_handler, NULL, "obj_sync")			\
 	X(DAOS_OBJ_RPC_TGT_UPDATE,					\
-		0, &CQF_obj_rw,						\
+		0, ver == 0 ? &CQF_obj_rw_0 : &CQF_obj_rw,		\
 		ds_obj_tgt_update_handler, NULL, "tgt_update")		\
 	X(DAOS_OBJ_RPC_TGT_PUNCH,					\
 		0, &CQF_obj_punch,					\
@@ -208,7 +198,7 @@ enum obj_rpc_flags {
 	((uint32_t)		(orw_tgt_idx)		CRT_VAR)   \
 	((uint32_t)		(orw_tgt_max)		CRT_VAR)
 
-#define DAOS_OSEQ_OBJ_RW	/* output fields */		 \
+#define DAOS_OSEQ_OBJ_RW_0	/* output fields */		 \
 	((int32_t)		(orw_ret)		CRT_VAR) \
 	((uint32_t)		(orw_map_version)	CRT_VAR) \
 	((uint64_t)		(orw_epoch)		CRT_VAR) \
@@ -220,6 +210,13 @@ enum obj_rpc_flags {
 	((struct daos_recx_ep_list)	(orw_rels)	CRT_ARRAY) \
 	((daos_iom_t)		(orw_maps)		CRT_ARRAY)
 
+/* The new fields must be appended, the old reply is the prefix of the new one. */
+#define DAOS_OSEQ_OBJ_RW	/* output fields */		 \
+	DAOS_OSEQ_OBJ_RW_0					 \
+	((uint32_t)		(orw_sched_depth)	CRT_VAR) \
+	((uint32_t)		(orw_padding)		CRT_VAR)
+
+CRT_RPC_DECLARE(obj_rw_0,	DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW_0)
 CRT_RPC_DECLARE(obj_rw,		DAOS_ISEQ_OBJ_RW, DAOS_OSEQ_OBJ_RW)
 
 /* object Enumerate in/out */
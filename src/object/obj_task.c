@@ -232,6 +232,29 @@ dc_obj_update_task_create(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 	return 0;
 }
 
+int
+dc_obj_update_multi_task_create(daos_handle_t oh, daos_handle_t th,
+				uint64_t flags, uint32_t nr,
+				daos_dkey_io_t *ios, daos_event_t *ev,
+				tse_sched_t *tse, tse_task_t **task)
+{
+	daos_obj_multi_rw_t	*args;
+	int			 rc;
+
+	rc = dc_task_create(dc_obj_update_multi_task, tse, ev, task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(*task);
+	args->oh	= oh;
+	args->th	= th;
+	args->flags	= flags;
+	args->nr	= nr;
+	args->ios	= ios;
+
+	return 0;
+}
+
 int
 dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 			     daos_key_desc_t *kds, d_sg_list_t *sgl,
@@ -104,6 +104,8 @@ struct dc_tx {
 	struct daos_cpd_sg	 tx_tgts;
 
 	struct d_backoff_seq	 tx_backoff_seq;
+	/** Conflict statistics, kept across restarts. */
+	struct daos_tx_stats	 tx_stats;
 };
 
 static int
@@ -529,8 +531,10 @@ dc_tx_op_end(tse_task_t *task, daos_handle_t th, struct dtx_epoch *req_epoch,
 		goto out;
 	}
 
-	if (rep_rc == -DER_TX_RESTART)
+	if (rep_rc == -DER_TX_RESTART) {
 		tx->tx_status = TX_FAILED;
+		tx->tx_stats.ts_io_conflicts++;
+	}
 
 	if (rep_epoch == DAOS_EPOCH_MAX) {
 		D_ERROR("invalid reply epoch: DAOS_EPOCH_MAX\n");
@@ -605,6 +609,7 @@ dc_tx_check_pmv_internal(daos_handle_t th, struct dc_tx **ptx)
 		/* For external non-snap TX, restart it if pool map is stale. */
 		if (tx->tx_pm_ver != 0 && !tx->tx_fixed_epoch) {
 			tx->tx_status = TX_FAILED;
+			tx->tx_stats.ts_pm_changes++;
 			rc = -DER_TX_RESTART;
 		} else {
 			tx->tx_pm_ver = pm_ver;
@@ -832,6 +837,26 @@ dc_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch)
 	return rc;
 }
 
+int
+dc_tx_hdl2stats(daos_handle_t th, struct daos_tx_stats *stats)
+{
+	struct dc_tx	*tx;
+
+	if (daos_handle_is_inval(th))
+		return -DER_INVAL;
+
+	tx = dc_tx_hdl2ptr(th);
+	if (tx == NULL)
+		return -DER_NO_HDL;
+
+	D_MUTEX_LOCK(&tx->tx_lock);
+	*stats = tx->tx_stats;
+	D_MUTEX_UNLOCK(&tx->tx_lock);
+	dc_tx_decref(tx);
+
+	return 0;
+}
+
 int
 dc_tx_open(tse_task_t *task)
 {
@@ -937,6 +962,10 @@ dc_tx_commit_cb(tse_task_t *task, void *data)
 	if (rc == -DER_TX_RESTART || rc == -DER_STALE) {
 		tx->tx_set_resend = 1;
 		tx->tx_status = TX_FAILED;
+		if (rc == -DER_STALE)
+			tx->tx_stats.ts_pm_changes++;
+		else
+			tx->tx_stats.ts_commit_conflicts++;
 
 		if (pool_task != NULL) {
 			D_MUTEX_UNLOCK(&tx->tx_lock);
@@ -1781,14 +1810,18 @@ dc_tx_commit_trigger(tse_task_t *task, struct dc_tx *tx, daos_tx_commit_t *args)
 	int				 rc;
 
 	if (tx->tx_pm_ver != 0 && tx->tx_pm_ver != dc_pool_get_version(tx->tx_pool) &&
-	    (tx->tx_retry || tx->tx_read_cnt > 0))
+	    (tx->tx_retry || tx->tx_read_cnt > 0)) {
+		tx->tx_stats.ts_pm_changes++;
 		D_GOTO(out, rc = -DER_TX_RESTART);
+	}
 
 	if (!tx->tx_retry) {
 		rc = dc_tx_commit_prepare(tx, task);
 		if (rc != 0) {
-			if (rc == -DER_STALE)
+			if (rc == -DER_STALE) {
+				tx->tx_stats.ts_pm_changes++;
 				rc = -DER_TX_RESTART;
+			}
 
 			goto out;
 		}
@@ -1851,6 +1884,40 @@ out:
 	return rc;
 }
 
+/*
+ * Whether the TX only contains reads that can be committed locally without CPD RPC.
+ *
+ * Each transactional fetch (or enumeration) has been served at the TX epoch, and the
+ * replica serving it has set related read timestamp in its VOS TS cache. But other
+ * replicas only get the read timestamp via the CPD RPC (see "P1: Spread read TS" on
+ * server), without that a conflicting modification with lower epoch led by another
+ * replica would not be rejected. So only the TX whose reads are all against objects
+ * without redundancy is committed locally, unless the pool map has been changed, in
+ * which case the target holding the read timestamp may have been excluded.
+ */
+static inline bool
+dc_tx_rdonly_committable(struct dc_tx *tx)
+{
+	struct daos_cpd_sub_req	*dcsr;
+	uint32_t		 start;
+	uint32_t		 i;
+
+	if (tx->tx_write_cnt != 0 || tx->tx_retry)
+		return false;
+
+	if (!dtx_epoch_chosen(&tx->tx_epoch))
+		return false;
+
+	start = dc_tx_leftmost_req(tx, false);
+	for (i = 0; i < tx->tx_read_cnt; i++) {
+		dcsr = &tx->tx_req_cache[i + start];
+		if (obj_get_grp_size(dcsr->dcsr_obj) > 1)
+			return false;
+	}
+
+	return tx->tx_pm_ver == dc_pool_get_version(tx->tx_pool);
+}
+
 int
 dc_tx_commit(tse_task_t *task)
 {
@@ -1890,6 +1957,14 @@ dc_tx_commit(tse_task_t *task)
 		D_GOTO(out_tx, rc = 0);
 	}
 
+	if (dc_tx_rdonly_committable(tx)) {
+		D_DEBUG(DB_TRACE, "Commit read-only TX "DF_DTI" with %u reads at epoch "
+			DF_X64" locally\n", DP_DTI(&tx->tx_id), tx->tx_read_cnt,
+			tx->tx_epoch.oe_value);
+		tx->tx_status = TX_COMMITTED;
+		D_GOTO(out_tx, rc = 0);
+	}
+
 	rc = dc_tx_commit_trigger(task, tx, args);
 	if (rc)
 		D_GOTO(out_tx, rc);
@@ -2042,6 +2117,7 @@ dc_tx_restart_begin(struct dc_tx *tx, uint32_t *backoff)
 		 * tx_lock is temporarily released during the backoff.
 		 */
 		tx->tx_status = TX_RESTARTING;
+		tx->tx_stats.ts_restarts++;
 
 		*backoff = d_backoff_seq_next(&tx->tx_backoff_seq);
 	}
@@ -3070,3 +3146,367 @@ out:
 
 	return rc;
 }
+
+/*
+ * Multi-dkey update without TX handle.
+ *
+ * Each dkey is updated by its own internal DTX, so that the dkeys succeed or
+ * fail independently as they do with daos_obj_update(), but the DTXs that
+ * share the same leader are packed into one CPD RPC, see ds_obj_cpd_handler()
+ * for the leader handling of multiple DTXs. The dkey whose DTX failed, for
+ * whatever reason, is updated again via the regular update path that handles
+ * the pool map refresh, the resend and the other retries.
+ */
+
+/* The max count of DTXs packed in one CPD RPC. */
+#define DTX_MULTI_PER_RPC	32
+
+struct dc_tx_multi {
+	/* The multi-dkey update task. */
+	tse_task_t		 *tm_task;
+	uint32_t		  tm_nr;
+	/* One internal DTX per dkey, NULL if the dkey is regularly updated. */
+	struct dc_tx		**tm_txs;
+};
+
+struct dc_tx_multi_rpc {
+	struct dc_tx_multi	*tmr_multi;
+	crt_rpc_t		*tmr_req;
+	uint32_t		 tmr_nr;
+	bool			 tmr_sent;
+	/* Index of the dkey in the multi-dkey update of each DTX. */
+	uint32_t		 tmr_idx[DTX_MULTI_PER_RPC];
+	struct daos_cpd_sg	 tmr_heads[DTX_MULTI_PER_RPC];
+	struct daos_cpd_sg	 tmr_reqs[DTX_MULTI_PER_RPC];
+	struct daos_cpd_sg	 tmr_disp[DTX_MULTI_PER_RPC];
+	struct daos_cpd_sg	 tmr_tgts[DTX_MULTI_PER_RPC];
+};
+
+/*
+ * Update the dkey @idx via the regular update path, the update task is added
+ * to @task_list if it is not NULL, otherwise it is scheduled immediately.
+ */
+static int
+dc_tx_multi_fallback(struct dc_tx_multi *tm, uint32_t idx, d_list_t *task_list)
+{
+	daos_obj_multi_rw_t	*mu = dc_task_get_args(tm->tm_task);
+	daos_dkey_io_t		*io = &mu->ios[idx];
+	tse_task_t		*sub_task;
+	int			 rc;
+
+	rc = dc_obj_update_task_create(mu->oh, DAOS_TX_NONE, mu->flags,
+				       io->dio_dkey, io->dio_nr, io->dio_iods,
+				       io->dio_sgls, NULL,
+				       tse_task2sched(tm->tm_task), &sub_task);
+	if (rc != 0)
+		return rc;
+
+	rc = tse_task_register_deps(tm->tm_task, 1, &sub_task);
+	if (rc != 0) {
+		tse_task_complete(sub_task, rc);
+		return rc;
+	}
+
+	if (task_list != NULL) {
+		tse_task_list_add(sub_task, task_list);
+		return 0;
+	}
+
+	return tse_task_schedule(sub_task, false);
+}
+
+static int
+dc_tx_multi_rpc_cb(tse_task_t *task, void *data)
+{
+	struct dc_tx_multi_rpc	*tmr = *((struct dc_tx_multi_rpc **)data);
+	struct dc_tx_multi	*tm = tmr->tmr_multi;
+	struct obj_cpd_out	*oco = crt_reply_get(tmr->tmr_req);
+	int			*sub_rets = NULL;
+	int			 rc = task->dt_result;
+	int			 rc1;
+	int			 ret = 0;
+	uint32_t		 i;
+
+	/* Aborted before being sent. */
+	if (!tmr->tmr_sent) {
+		crt_req_decref(tmr->tmr_req);
+		goto out;
+	}
+
+	if (rc == 0) {
+		rc = oco->oco_ret;
+		if (rc == 0 && oco->oco_sub_rets.ca_count != tmr->tmr_nr)
+			rc = -DER_PROTO;
+		if (rc == 0)
+			sub_rets = oco->oco_sub_rets.ca_arrays;
+	}
+
+	for (i = 0; i < tmr->tmr_nr; i++) {
+		rc1 = sub_rets != NULL ? sub_rets[i] : rc;
+		if (rc1 == 0) {
+			tm->tm_txs[tmr->tmr_idx[i]]->tx_status = TX_COMMITTED;
+			continue;
+		}
+
+		D_DEBUG(DB_IO, "Update dkey %u of multi-dkey update again: "
+			DF_RC"\n", tmr->tmr_idx[i], DP_RC(rc1));
+		rc1 = dc_tx_multi_fallback(tm, tmr->tmr_idx[i], NULL);
+		if (rc1 != 0 && ret == 0)
+			ret = rc1;
+	}
+
+	/* The failed DTXs have been handed over to the regular updates. */
+	task->dt_result = ret;
+out:
+	crt_req_decref(tmr->tmr_req);
+	D_FREE(tmr);
+	return 0;
+}
+
+static int
+dc_tx_multi_rpc_send(tse_task_t *task)
+{
+	struct dc_tx_multi_rpc	*tmr = tse_task_get_priv(task);
+
+	tmr->tmr_sent = true;
+	return daos_rpc_send(tmr->tmr_req, task);
+}
+
+/*
+ * Pack the DTXs of @tmr into one CPD RPC to their common leader, the returned
+ * RPC task owns @tmr, which is freed on failure.
+ */
+static int
+dc_tx_multi_rpc_prep(struct dc_tx_multi_rpc *tmr, tse_task_t **rpc_task)
+{
+	struct dc_tx_multi	*tm = tmr->tmr_multi;
+	struct dc_tx		*tx = tm->tm_txs[tmr->tmr_idx[0]];
+	struct obj_cpd_in	*oci;
+	crt_endpoint_t		 tgt_ep;
+	tse_task_t		*task;
+	uint32_t		 i;
+	int			 rc;
+
+	tgt_ep.ep_grp = tx->tx_pool->dp_sys->sy_group;
+	tgt_ep.ep_tag = tx->tx_leader_tag;
+	tgt_ep.ep_rank = tx->tx_leader_rank;
+
+	rc = obj_req_create(daos_task2ctx(tm->tm_task), &tgt_ep,
+			    DAOS_OBJ_RPC_CPD, &tmr->tmr_req);
+	if (rc != 0) {
+		D_FREE(tmr);
+		return rc;
+	}
+
+	oci = crt_req_get(tmr->tmr_req);
+	rc = dc_cont_hdl2uuid(tx->tx_coh, &oci->oci_co_hdl, &oci->oci_co_uuid);
+	D_ASSERT(rc == 0);
+
+	uuid_copy(oci->oci_pool_uuid, tx->tx_pool->dp_pool);
+	oci->oci_map_ver = tx->tx_pm_ver;
+	oci->oci_flags = ORF_CPD_LEADER;
+
+	for (i = 0; i < tmr->tmr_nr; i++) {
+		tx = tm->tm_txs[tmr->tmr_idx[i]];
+		tmr->tmr_heads[i] = tx->tx_head;
+		tmr->tmr_reqs[i] = tx->tx_reqs;
+		tmr->tmr_disp[i] = tx->tx_disp;
+		tmr->tmr_tgts[i] = tx->tx_tgts;
+		tx->tx_status = TX_COMMITTING;
+	}
+
+	oci->oci_sub_heads.ca_arrays = tmr->tmr_heads;
+	oci->oci_sub_heads.ca_count = tmr->tmr_nr;
+	oci->oci_sub_reqs.ca_arrays = tmr->tmr_reqs;
+	oci->oci_sub_reqs.ca_count = tmr->tmr_nr;
+	oci->oci_disp_ents.ca_arrays = tmr->tmr_disp;
+	oci->oci_disp_ents.ca_count = tmr->tmr_nr;
+	oci->oci_disp_tgts.ca_arrays = tmr->tmr_tgts;
+	oci->oci_disp_tgts.ca_count = tmr->tmr_nr;
+
+	rc = tse_task_create(dc_tx_multi_rpc_send, tse_task2sched(tm->tm_task),
+			     tmr, &task);
+	if (rc != 0) {
+		crt_req_decref(tmr->tmr_req);
+		D_FREE(tmr);
+		return rc;
+	}
+
+	/* One reference for the completion callback. */
+	crt_req_addref(tmr->tmr_req);
+	rc = tse_task_register_comp_cb(task, dc_tx_multi_rpc_cb, &tmr,
+				       sizeof(tmr));
+	if (rc != 0) {
+		crt_req_decref(tmr->tmr_req);
+		crt_req_decref(tmr->tmr_req);
+		D_FREE(tmr);
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	rc = tse_task_register_deps(tm->tm_task, 1, &task);
+	if (rc != 0) {
+		tse_task_complete(task, rc);
+		return rc;
+	}
+
+	*rpc_task = task;
+	return 0;
+}
+
+static int
+dc_tx_multi_comp_cb(tse_task_t *task, void *data)
+{
+	struct dc_tx_multi	*tm = *((struct dc_tx_multi **)data);
+	uint32_t		 i;
+
+	for (i = 0; i < tm->tm_nr; i++) {
+		if (tm->tm_txs[i] != NULL)
+			dc_tx_close_internal(tm->tm_txs[i]);
+	}
+	D_FREE(tm->tm_txs);
+	D_FREE(tm);
+
+	return 0;
+}
+
+/* Prepare the internal DTX of the dkey @idx, consumes one object reference. */
+static int
+dc_tx_multi_prep_one(struct dc_tx_multi *tm, struct dc_object *obj,
+		     uint32_t idx)
+{
+	daos_obj_multi_rw_t	*mu = dc_task_get_args(tm->tm_task);
+	daos_dkey_io_t		*io = &mu->ios[idx];
+	struct dc_tx		*tx = NULL;
+	int			 rc;
+
+	rc = dc_tx_alloc(dc_obj_hdl2cont_hdl(mu->oh), 0, DAOS_TF_ZERO_COPY,
+			 &tx);
+	if (rc != 0) {
+		obj_decref(obj);
+		return rc;
+	}
+
+	tx->tx_pm_ver = dc_pool_get_version(tx->tx_pool);
+	tm->tm_txs[idx] = tx;
+
+	rc = dc_tx_add_update(tx, &obj, mu->flags, io->dio_dkey, io->dio_nr,
+			      io->dio_iods, io->dio_sgls);
+	if (rc != 0) {
+		if (obj != NULL)
+			obj_decref(obj);
+		return rc;
+	}
+
+	return dc_tx_commit_prepare(tx, tm->tm_task);
+}
+
+/*
+ * Update the dkeys of a multi-dkey update without TX handle with one CPD RPC
+ * per leader target, see the comment above. Consumes the object reference.
+ */
+int
+dc_tx_update_multi(struct dc_object *obj, tse_task_t *task)
+{
+	daos_obj_multi_rw_t	*mu = dc_task_get_args(task);
+	struct dc_tx_multi	*tm;
+	struct dc_tx_multi_rpc	*tmr;
+	struct dc_tx		*tx;
+	tse_task_t		*rpc_task;
+	d_list_t		 task_list;
+	bool			*packed = NULL;
+	uint32_t		 i;
+	uint32_t		 j;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&task_list);
+
+	D_ALLOC_PTR(tm);
+	if (tm == NULL)
+		D_GOTO(out_obj, rc = -DER_NOMEM);
+
+	tm->tm_task = task;
+	tm->tm_nr = mu->nr;
+	D_ALLOC_ARRAY(tm->tm_txs, mu->nr);
+	if (tm->tm_txs == NULL) {
+		D_FREE(tm);
+		D_GOTO(out_obj, rc = -DER_NOMEM);
+	}
+
+	rc = tse_task_register_comp_cb(task, dc_tx_multi_comp_cb, &tm,
+				       sizeof(tm));
+	if (rc != 0) {
+		D_FREE(tm->tm_txs);
+		D_FREE(tm);
+		goto out_obj;
+	}
+
+	D_ALLOC_ARRAY(packed, mu->nr);
+	if (packed == NULL)
+		D_GOTO(out_obj, rc = -DER_NOMEM);
+
+	for (i = 0; i < mu->nr; i++) {
+		obj_addref(obj);
+		rc = dc_tx_multi_prep_one(tm, obj, i);
+		if (rc == 0)
+			continue;
+
+		D_DEBUG(DB_IO, "Update dkey %u of multi-dkey update regularly: "
+			DF_RC"\n", i, DP_RC(rc));
+		if (tm->tm_txs[i] != NULL) {
+			dc_tx_close_internal(tm->tm_txs[i]);
+			tm->tm_txs[i] = NULL;
+		}
+		packed[i] = true;
+		rc = dc_tx_multi_fallback(tm, i, &task_list);
+		if (rc != 0)
+			goto out;
+	}
+
+	/* Group the DTXs by their leader target. */
+	for (i = 0; i < mu->nr; i++) {
+		if (packed[i])
+			continue;
+
+		D_ALLOC_PTR(tmr);
+		if (tmr == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		tmr->tmr_multi = tm;
+		tx = tm->tm_txs[i];
+		for (j = i; j < mu->nr && tmr->tmr_nr < DTX_MULTI_PER_RPC; j++) {
+			if (packed[j] ||
+			    tm->tm_txs[j]->tx_leader_rank != tx->tx_leader_rank ||
+			    tm->tm_txs[j]->tx_leader_tag != tx->tx_leader_tag ||
+			    tm->tm_txs[j]->tx_pm_ver != tx->tx_pm_ver)
+				continue;
+
+			packed[j] = true;
+			tmr->tmr_idx[tmr->tmr_nr++] = j;
+		}
+
+		rc = dc_tx_multi_rpc_prep(tmr, &rpc_task);
+		if (rc != 0)
+			goto out;
+		tse_task_list_add(rpc_task, &task_list);
+	}
+
+	D_FREE(packed);
+	obj_decref(obj);
+	tse_task_list_sched(&task_list, false);
+	return 0;
+
+out:
+	D_FREE(packed);
+	/* The multi-dkey task completes with the last aborted dependency. */
+	if (d_list_empty(&task_list))
+		tse_task_complete(task, rc);
+	else
+		tse_task_list_abort(&task_list, rc);
+	obj_decref(obj);
+	return rc;
+out_obj:
+	obj_decref(obj);
+	tse_task_complete(task, rc);
+	return rc;
+}
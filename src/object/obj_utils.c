@@ -12,7 +12,7 @@
 #include <daos_types.h>
 #include "obj_internal.h"
 
-static daos_size_t
+daos_size_t
 daos_iod_len(daos_iod_t *iod)
 {
 	daos_size_t	len;
@@ -125,6 +125,7 @@ struct ec_agg_param {
 	void			*ap_yield_arg;   /* yield argument            */
 	uint32_t		 ap_credits_max; /* # of tight loops to yield */
 	uint32_t		 ap_credits;     /* # of tight loops          */
+	struct obj_pool_metrics	*ap_metrics;	 /* per-pool object metrics   */
 	uint32_t		 ap_initialized:1, /* initialized flag */
 				 ap_obj_skipped:1; /* skipped obj during aggregation */
 };
@@ -136,6 +137,7 @@ struct ec_agg_stripe_ud {
 	uint8_t			*asu_bit_map;   /* Bitmap of cells       */
 	daos_recx_t		*asu_recxs;     /* For re-replicate      */
 	unsigned int		 asu_cell_cnt;  /* Count of cells        */
+	uint64_t		 asu_read_bytes; /* Bytes read from peers */
 	bool			 asu_recalc;    /* Should recalc parity  */
 	bool			 asu_write_par; /* Should write parity   */
 	struct daos_csummer	*asu_csummer;
@@ -522,15 +524,69 @@ out:
 	return rc;
 }
 
+/* Adds the ranges of cell \a cell_idx overwritten after the parity epoch to
+ * the recx array, overlapped or adjacent ranges are merged. The matching iov
+ * points to the same offset of the cell in \a buf.
+ */
+static unsigned int
+agg_odata_ranges_add(struct ec_agg_entry *entry, unsigned int cell_idx,
+		     unsigned char *buf, daos_recx_t *recxs, d_iov_t *iovs,
+		     unsigned int nr)
+{
+	struct ec_agg_extent	*extent;
+	uint64_t		 rsize = entry->ae_rsize;
+	unsigned int		 len = ec_age2cs(entry);
+	unsigned int		 k = ec_age2k(entry);
+	uint64_t		 ss, cell_start, cell_end;
+	uint64_t		 start, end;
+	unsigned int		 first = nr;
+	daos_recx_t		*last;
+
+	ss = k * len * entry->ae_cur_stripe.as_stripenum;
+	cell_start = ss + (uint64_t)cell_idx * len;
+	cell_end = cell_start + len;
+	d_list_for_each_entry(extent, &entry->ae_cur_stripe.as_dextents,
+			      ae_link) {
+		if (extent->ae_epoch <= entry->ae_par_extent.ape_epoch)
+			continue;
+		start = max(extent->ae_recx.rx_idx, cell_start);
+		end = min(DAOS_RECX_END(extent->ae_recx), cell_end);
+		if (start >= cell_end)
+			break;
+		if (start >= end)
+			continue;
+
+		last = nr > first ? &recxs[nr - 1] : NULL;
+		if (last != NULL && start <= DAOS_RECX_END(*last)) {
+			if (end > DAOS_RECX_END(*last)) {
+				last->rx_nr = end - last->rx_idx;
+				iovs[nr - 1].iov_len = last->rx_nr * rsize;
+				iovs[nr - 1].iov_buf_len = last->rx_nr * rsize;
+			}
+			continue;
+		}
+		recxs[nr].rx_idx = start;
+		recxs[nr].rx_nr = end - start;
+		d_iov_set(&iovs[nr], &buf[(start - cell_start) * rsize],
+			  (end - start) * rsize);
+		nr++;
+	}
+
+	return nr;
+}
+
 /* Fetches the old data for the cells in the stripe undergoing a partial parity
  * update, or a parity recalculation. For update, the bit_map indicates the
  * cells that are present as replicas. In this case the parity epoch is used
- * for the fetch. For recalc, the bit_map indicates the cells that are not fully
- * populated as replicas. In this case, the highest replica epoch is used.
+ * for the fetch, and only the ranges overwritten by the replicas are fetched,
+ * the rest of the diff is zeroed by agg_diff_preprocess() anyway. For recalc,
+ * the bit_map indicates the cells that are not fully populated as replicas.
+ * In this case, the highest replica epoch is used.
  */
 static int
 agg_fetch_odata_cells(struct ec_agg_entry *entry, uint8_t *bit_map,
-		      unsigned int cell_cnt, bool is_recalc)
+		      unsigned int cell_cnt, bool is_recalc,
+		      uint64_t *read_bytes)
 {
 	daos_iod_t		 iod = { 0 };
 	d_sg_list_t		 sgl = { 0 };
@@ -541,37 +597,54 @@ agg_fetch_odata_cells(struct ec_agg_entry *entry, uint8_t *bit_map,
 	uint64_t		 cell_b = ec_age2cs_b(entry);
 	unsigned int		 len = ec_age2cs(entry);
 	unsigned int		 k = ec_age2k(entry);
+	unsigned int		 recx_max, nr = 0;
 	unsigned int		 i, j;
 	int			 rc = 0;
 
-	D_ALLOC_ARRAY(recxs, cell_cnt);
+	/* Each extent could be split by the cell boundaries */
+	recx_max = is_recalc ? cell_cnt : stripe->as_extent_cnt + k;
+	D_ALLOC_ARRAY(recxs, recx_max);
 	if (recxs == NULL)
 		return -DER_NOMEM;
 
+	D_ALLOC_ARRAY(sgl.sg_iovs, recx_max);
+	if (sgl.sg_iovs == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+
+	buf = entry->ae_sgl.sg_iovs[AGG_IOV_ODATA].iov_buf;
 	for (i = 0, j = 0; i < k; i++) {
 		if (!isset(bit_map, i))
 			continue;
 
-		recxs[j].rx_idx = stripe->as_stripenum * k * len + i * len;
-		recxs[j++].rx_nr = len;
+		if (is_recalc) {
+			recxs[nr].rx_idx = stripe->as_stripenum * k * len +
+					   i * len;
+			recxs[nr].rx_nr = len;
+			d_iov_set(&sgl.sg_iovs[nr], &buf[j * cell_b], cell_b);
+			nr++;
+		} else {
+			nr = agg_odata_ranges_add(entry, i, &buf[j * cell_b],
+						  recxs, sgl.sg_iovs, nr);
+		}
+		j++;
 	}
 	D_ASSERT(j == cell_cnt);
+	D_ASSERT(nr <= recx_max);
+
+	*read_bytes = 0;
+	for (i = 0; i < nr; i++)
+		*read_bytes += sgl.sg_iovs[i].iov_len;
+	if (nr == 0)
+		goto out;
 
 	iod.iod_name	= entry->ae_akey;
 	iod.iod_type	= DAOS_IOD_ARRAY;
 	iod.iod_size	= entry->ae_rsize;
-	iod.iod_nr	= cell_cnt;
+	iod.iod_nr	= nr;
 	iod.iod_recxs	= recxs;
-
-	D_ALLOC_ARRAY(sgl.sg_iovs, cell_cnt);
-	if (sgl.sg_iovs == NULL) {
-		rc = -DER_NOMEM;
-		goto out;
-	}
-	sgl.sg_nr = cell_cnt;
-	buf = entry->ae_sgl.sg_iovs[AGG_IOV_ODATA].iov_buf;
-	for (i = 0; i < cell_cnt; i++)
-		d_iov_set(&sgl.sg_iovs[i], &buf[i * cell_b], cell_b);
+	sgl.sg_nr	= nr;
 
 	rc = agg_get_obj_handle(entry);
 	if (rc) {
@@ -1010,6 +1083,12 @@ agg_diff_preprocess(struct ec_agg_entry *entry, unsigned char *diff,
 	}
 }
 
+static void
+agg_diff_prep_cb(void *arg, unsigned char *diff, unsigned int cell_idx)
+{
+	agg_diff_preprocess(arg, diff, cell_idx);
+}
+
 /* Performs an incremental update of the existing parity for the stripe.
  */
 static int
@@ -1020,40 +1099,19 @@ agg_update_parity(struct ec_agg_entry *entry, uint8_t *bit_map,
 	unsigned int	 p = ec_age2p(entry);
 	unsigned int	 cell_bytes = ec_age2cs_b(entry);
 	unsigned char	*parity_bufs[OBJ_EC_MAX_P];
-	unsigned char	*vects[3];
 	unsigned char	*buf;
-	unsigned char	*obuf;
-	unsigned char	*old;
-	unsigned char	*new;
-	unsigned char	*diff;
-	int		 i, j, rc = 0;
+	int		 i;
 
 	buf = entry->ae_sgl.sg_iovs[AGG_IOV_PARITY].iov_buf;
 	for (i = 0; i < p; i++)
 		parity_bufs[i] = &buf[i * cell_bytes];
 
-	obuf = entry->ae_sgl.sg_iovs[AGG_IOV_ODATA].iov_buf;
-	buf  = entry->ae_sgl.sg_iovs[AGG_IOV_DATA].iov_buf;
-	diff = entry->ae_sgl.sg_iovs[AGG_IOV_DIFF].iov_buf;
-
-	for (i = 0, j = 0; i < cell_cnt; i++) {
-		old = &obuf[i * cell_bytes];
-		new = &buf[i * cell_bytes];
-		vects[0] = old;
-		vects[1] = new;
-		vects[2] = diff;
-		rc = xor_gen(3, cell_bytes, (void **)vects);
-		if (rc)
-			goto out;
-		while (!isset(bit_map, j))
-			j++;
-		agg_diff_preprocess(entry, diff, j);
-		ec_encode_data_update(cell_bytes, k, p, j,
-				      entry->ae_codec->ec_gftbls, diff,
-				      parity_bufs);
-	}
-out:
-	return rc;
+	return obj_ec_parity_delta_update(entry->ae_codec->ec_gftbls, k, p,
+					  cell_bytes, bit_map, cell_cnt,
+					  entry->ae_sgl.sg_iovs[AGG_IOV_ODATA].iov_buf,
+					  entry->ae_sgl.sg_iovs[AGG_IOV_DATA].iov_buf,
+					  entry->ae_sgl.sg_iovs[AGG_IOV_DIFF].iov_buf,
+					  parity_bufs, agg_diff_prep_cb, entry);
 }
 
 /* Recalculates new parity for partial stripe updates. Used when replica
@@ -1106,7 +1164,8 @@ agg_process_partial_stripe_ult(void *arg)
 	 * the bitmap is set for the same cells as are replicated.
 	 */
 	rc = agg_fetch_odata_cells(entry, bit_map, cell_cnt,
-				   stripe_ud->asu_recalc);
+				   stripe_ud->asu_recalc,
+				   &stripe_ud->asu_read_bytes);
 	if (rc)
 		goto out;
 
@@ -1114,6 +1173,7 @@ agg_process_partial_stripe_ult(void *arg)
 		rc = agg_fetch_remote_parity(entry);
 		if (rc)
 			goto out;
+		stripe_ud->asu_read_bytes += (p - 1) * ec_age2cs_b(entry);
 	}
 
 	if (stripe_ud->asu_recalc)
@@ -1137,8 +1197,12 @@ agg_process_partial_stripe(struct ec_agg_entry *entry)
 	uint8_t			*bit_map = NULL;
 	uint8_t			 fcbit_map[OBJ_TGT_BITMAP_LEN] = {0};
 	uint8_t			 tbit_map[OBJ_TGT_BITMAP_LEN] = {0};
+	struct obj_pool_metrics	*opm;
+	uint64_t		 cell_b = ec_age2cs_b(entry);
+	uint64_t		 read_bytes;
 	unsigned int		 len = ec_age2cs(entry);
 	unsigned int		 k = ec_age2k(entry);
+	unsigned int		 p = ec_age2p(entry);
 	unsigned long            ss;
 	unsigned int		 i, full_cell_cnt = 0;
 	unsigned int		 cell_cnt = 0;
@@ -1180,7 +1244,14 @@ agg_process_partial_stripe(struct ec_agg_entry *entry)
 				    entry->ae_cur_stripe.as_stripenum,
 				    &full_cell_cnt);
 
-	if (full_cell_cnt >= k / 2 || cell_cnt == k || has_old_replicas) {
+	/*
+	 * Recalculating the parity reads the cells not fully covered by the
+	 * replicas from the peers, while the delta parity update reads the
+	 * old data of the overwritten cells and the parity of the other parity
+	 * shards. Choose the one reading less, the replicas older than the
+	 * parity can't be handled by the delta update.
+	 */
+	if (cell_cnt + p - 1 >= k - full_cell_cnt || has_old_replicas) {
 		stripe_ud.asu_recalc = true;
 		cell_cnt = full_cell_cnt;
 		bit_map = fcbit_map;
@@ -1231,6 +1302,28 @@ agg_process_partial_stripe(struct ec_agg_entry *entry)
 		goto ev_out;
 	}
 
+	/* Local replicas (and local parity for delta update) plus peer reads */
+	read_bytes = stripe_ud.asu_read_bytes;
+	if (stripe_ud.asu_recalc)
+		read_bytes += (k - cell_cnt) * cell_b;
+	else
+		read_bytes += (cell_cnt + 1) * cell_b;
+
+	opm = container_of(entry, struct ec_agg_param,
+			   ap_agg_entry)->ap_metrics;
+	if (opm != NULL) {
+		d_tm_inc_counter(opm->opm_ec_agg_read_bytes, read_bytes);
+		if (stripe_ud.asu_recalc) {
+			d_tm_inc_counter(opm->opm_ec_agg_recalc, 1);
+		} else {
+			d_tm_inc_counter(opm->opm_ec_agg_delta, 1);
+			/* Recalculation would read the whole stripe */
+			if (k * cell_b > read_bytes)
+				d_tm_inc_counter(opm->opm_ec_agg_saved_bytes,
+						 k * cell_b - read_bytes);
+		}
+	}
+
 ev_out:
 	ABT_eventual_free(&stripe_ud.asu_eventual);
 
@@ -2399,6 +2492,7 @@ ec_agg_param_init(struct ds_cont_child *cont, struct agg_param *param)
 	agg_param->ap_yield_func	= agg_rate_ctl;
 	agg_param->ap_yield_arg		= param;
 	agg_param->ap_credits_max	= EC_AGG_ITERATION_MAX;
+	agg_param->ap_metrics		= cont->sc_pool->spc_metrics[DAOS_OBJ_MODULE];
 	D_INIT_LIST_HEAD(&agg_param->ap_agg_entry.ae_cur_stripe.as_dextents);
 
 	arg.param = agg_param;
@@ -18,11 +18,35 @@
 /**
  * Switch of enable DTX or not, enabled by default.
  */
+unsigned int obj_fwd_relay_size;
+unsigned int obj_cpd_batch_size;
+
 static int
 obj_mod_init(void)
 {
 	int	rc;
 
+	d_getenv_int("DAOS_OBJ_FWD_RELAY_SIZE", &obj_fwd_relay_size);
+	if (obj_fwd_relay_size > OBJ_FWD_RELAY_MAX) {
+		D_WARN("Invalid relay size %u, the max is %llu, disable relay\n",
+		       obj_fwd_relay_size, OBJ_FWD_RELAY_MAX);
+		obj_fwd_relay_size = 0;
+	}
+	if (obj_fwd_relay_size != 0)
+		D_INFO("Relay replicated updates of %u to %llu bytes\n",
+		       obj_fwd_relay_size, OBJ_FWD_RELAY_MAX);
+
+	d_getenv_int("DAOS_OBJ_CPD_BATCH", &obj_cpd_batch_size);
+	if (obj_cpd_batch_size > OBJ_CPD_BATCH_MAX) {
+		D_WARN("Invalid CPD batch size %u, the valid range is [0, %u], "
+		       "use %u\n", obj_cpd_batch_size, OBJ_CPD_BATCH_MAX,
+		       OBJ_CPD_BATCH_MAX);
+		obj_cpd_batch_size = OBJ_CPD_BATCH_MAX;
+	}
+	if (obj_cpd_batch_size > 1)
+		D_INFO("Coalesce at most %u DTXs into one CPD RPC\n",
+		       obj_cpd_batch_size);
+
 	rc = obj_utils_init();
 	if (rc)
 		goto out;
@@ -89,6 +113,7 @@ obj_tls_init(int xs_id, int tgt_id)
 		return NULL;
 
 	D_INIT_LIST_HEAD(&tls->ot_pool_list);
+	D_INIT_LIST_HEAD(&tls->ot_cpd_batches);
 
 	if (tgt_id < 0)
 		/** skip sensor setup on system xstreams */
@@ -223,6 +248,7 @@ obj_metrics_alloc(const char *path, int tgt_id)
 {
 	struct obj_pool_metrics	*metrics;
 	uint32_t		opc;
+	uint32_t		i;
 	int			rc;
 
 	D_ASSERT(tgt_id >= 0);
@@ -282,6 +308,97 @@ obj_metrics_alloc(const char *path, int tgt_id)
 		D_WARN("Failed to create bytes update counter: "DF_RC"\n",
 		       DP_RC(rc));
 
+	/** EC aggregation of partial stripes */
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_delta, D_TM_COUNTER,
+			     "partial stripes aggregated by delta parity update",
+			     "stripes", "%s/ec_agg/delta/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg delta counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_recalc, D_TM_COUNTER,
+			     "partial stripes aggregated by parity recalculation",
+			     "stripes", "%s/ec_agg/recalc/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg recalc counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_read_bytes, D_TM_COUNTER,
+			     "bytes read to aggregate partial stripes", "bytes",
+			     "%s/ec_agg/read_bytes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg read counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_ec_agg_saved_bytes, D_TM_COUNTER,
+			     "bytes saved by delta parity update", "bytes",
+			     "%s/ec_agg/saved_bytes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create EC agg saved counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_fwd_update_lat, D_TM_STATS_GAUGE,
+			     "update forwarded to one replica", "us",
+			     "%s/fwd_update/latency/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create fwd latency sensor: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_fwd_relay, D_TM_COUNTER,
+			     "updates relayed by the leader", "updates",
+			     "%s/fwd_update/relay/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create fwd relay counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_fwd_relay_bytes, D_TM_COUNTER,
+			     "bytes pulled by replicas from the leader", "bytes",
+			     "%s/fwd_update/relay_bytes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create fwd relay bytes counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	/** Restarted operations by conflict cause */
+	rc = d_tm_add_metric(&metrics->opm_conflict_rw, D_TM_COUNTER,
+			     "modifications restarted by conflicting reads",
+			     "ops", "%s/conflict/rw/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create rw conflict counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_conflict_uncertain, D_TM_COUNTER,
+			     "reads restarted because of epoch uncertainty",
+			     "ops", "%s/conflict/uncertain/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create uncertain conflict counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_cpd_coalesced, D_TM_COUNTER,
+			     "DTXs dispatched via coalesced CPD RPCs", "dtxs",
+			     "%s/cpd/coalesced/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create CPD coalesced counter: "DF_RC"\n",
+		       DP_RC(rc));
+
+	/** The most contended dkeys */
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++) {
+		rc = d_tm_add_metric(&metrics->opm_hot_dkey[i], D_TM_GAUGE,
+				     "hash of a contended dkey", "hash",
+				     "%s/conflict/hot_dkey_%u/hash/tgt_%u", path,
+				     i, tgt_id);
+		if (rc)
+			D_WARN("Failed to create hot dkey gauge: "DF_RC"\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&metrics->opm_hot_dkey_hits[i], D_TM_GAUGE,
+				     "conflicts against a contended dkey", "ops",
+				     "%s/conflict/hot_dkey_%u/hits/tgt_%u", path,
+				     i, tgt_id);
+		if (rc)
+			D_WARN("Failed to create hot dkey hits gauge: "DF_RC"\n",
+			       DP_RC(rc));
+	}
+
 	return metrics;
 }
 
@@ -294,7 +411,8 @@ obj_metrics_free(void *data)
 static int
 obj_metrics_count(void)
 {
-	return (sizeof(struct obj_pool_metrics) / sizeof(struct d_tm_node_t *));
+	return (offsetof(struct obj_pool_metrics, opm_hot_sketch) /
+		sizeof(struct d_tm_node_t *));
 }
 
 struct dss_module_metrics obj_metrics = {
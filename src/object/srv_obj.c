@@ -165,6 +165,9 @@ obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
 	} else {
 		orwo->orw_epoch = epoch;
 	}
+	/* The old reply format has no room for the scheduler depth. */
+	if (opc_get_rpc_ver(rpc->cr_opc) == DAOS_OBJ_VERSION)
+		orwo->orw_sched_depth = sched_queue_depth();
 
 	D_DEBUG(DB_IO, "rpc %p opc %d send reply, pmv %d, epoch "DF_X64
 		", status %d\n", rpc, opc_get(rpc->cr_opc),
@@ -620,6 +623,112 @@ out:
 	return 0;
 }
 
+static void
+obj_fwd_buf_free(struct obj_fwd_buf *fwd)
+{
+	int	i;
+
+	if (fwd == NULL)
+		return;
+
+	for (i = 0; i < fwd->ofb_nr; i++) {
+		if (fwd->ofb_bulks[i] != NULL)
+			crt_bulk_free(fwd->ofb_bulks[i]);
+	}
+	D_FREE(fwd->ofb_buf);
+	D_FREE(fwd);
+}
+
+/**
+ * For large replicated update, pull the data from the client into DRAM on
+ * the leader, then the replicas will pull the data from the leader instead
+ * of from the client, so the client only sends the data once.
+ *
+ * \a fwd_p is left as NULL if the update should not be relayed.
+ */
+static int
+obj_fwd_buf_prep(crt_rpc_t *rpc, struct obj_io_context *ioc,
+		 struct obj_fwd_buf **fwd_p)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	daos_iod_t		*iods = orw->orw_iod_array.oia_iods;
+	crt_bulk_t		*bulks = orw->orw_bulks.ca_arrays;
+	struct obj_fwd_buf	*fwd;
+	d_sg_list_t		**sgls;
+	d_iov_t			*iovs;
+	daos_size_t		 size;
+	daos_size_t		 len;
+	void			*buf;
+	uint32_t		 nr = orw->orw_nr;
+	int			 i;
+	int			 rc;
+
+	if (obj_fwd_relay_size == 0 || bulks == NULL ||
+	    orw->orw_bulks.ca_count != nr ||
+	    ioc->ioc_coc->sc_props.dcp_dedup_enabled ||
+	    (orw->orw_flags & ORF_EC))
+		return 0;
+
+	size = daos_iods_len(iods, nr);
+	if (size == (daos_size_t)-1 || size < obj_fwd_relay_size ||
+	    size > OBJ_FWD_RELAY_MAX)
+		return 0;
+
+	D_ALLOC(fwd, sizeof(*fwd) + nr * (sizeof(*fwd->ofb_sgls) +
+		sizeof(*iovs) + sizeof(*sgls) + sizeof(*fwd->ofb_bulks)));
+	if (fwd == NULL)
+		return -DER_NOMEM;
+
+	fwd->ofb_sgls = (d_sg_list_t *)&fwd[1];
+	iovs = (d_iov_t *)&fwd->ofb_sgls[nr];
+	sgls = (d_sg_list_t **)&iovs[nr];
+	fwd->ofb_bulks = (crt_bulk_t *)&sgls[nr];
+	fwd->ofb_nr = nr;
+	fwd->ofb_size = size;
+
+	/* Fully overwritten by the bulk transfer, no need to zero it. */
+	D_ALLOC_NZ(fwd->ofb_buf, size);
+	if (fwd->ofb_buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0, buf = fwd->ofb_buf; i < nr; i++, buf += len) {
+		len = daos_iod_len(&iods[i]);
+		sgls[i] = &fwd->ofb_sgls[i];
+		/* Nothing to transfer for punch */
+		if (len == 0 || bulks[i] == NULL)
+			continue;
+
+		d_iov_set(&iovs[i], buf, len);
+		fwd->ofb_sgls[i].sg_iovs = &iovs[i];
+		fwd->ofb_sgls[i].sg_nr = 1;
+		fwd->ofb_sgls[i].sg_nr_out = 1;
+
+		rc = crt_bulk_create(rpc->cr_ctx, &fwd->ofb_sgls[i],
+				     CRT_BULK_RO, &fwd->ofb_bulks[i]);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		/* The replicas are contacted from the IO forward context */
+		rc = crt_bulk_bind(fwd->ofb_bulks[i], rpc->cr_ctx);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	rc = obj_bulk_transfer(rpc, CRT_BULK_GET, orw->orw_flags & ORF_BULK_BIND,
+			       bulks, orw->orw_iod_array.oia_offs, DAOS_HDL_INVAL,
+			       sgls, nr, NULL, ioc->ioc_coh);
+out:
+	if (rc != 0) {
+		D_ERROR(DF_UOID" failed to prepare relay buffer: "DF_RC"\n",
+			DP_UOID(orw->orw_oid), DP_RC(rc));
+		obj_fwd_buf_free(fwd);
+		return rc;
+	}
+
+	*fwd_p = fwd;
+	return 0;
+}
+
 /**
  * Pack nrs in sgls inside the reply, so the client can update
  * sgls before it returns to application.
@@ -1155,7 +1264,7 @@ obj_prep_fetch_sgls(crt_rpc_t *rpc, struct obj_io_context *ioc)
 out:
 	if (rc) {
 		for (i = 0; i < nr; i++) {
-			for (i = 0; j < sgls[i].sg_nr; j++)
+			for (j = 0; j < sgls[i].sg_nr; j++)
 				D_FREE(sgls[i].sg_iovs[j].iov_buf);
 		}
 	}
@@ -1289,8 +1398,9 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		opc_get(rpc->cr_opc), DP_UOID(orw->orw_oid), DP_KEY(dkey),
 		tag, orw->orw_epoch);
 
+	/* The data relayed to the replicas is already on the leader */
 	rma = (orw->orw_bulks.ca_arrays != NULL ||
-	       orw->orw_bulks.ca_count != 0);
+	       orw->orw_bulks.ca_count != 0) && ioc->ioc_fwd_buf == NULL;
 	cond_flags = orw->orw_api_flags;
 
 	/* Prepare IO descriptor */
@@ -1530,7 +1640,11 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc,
 		}
 	}
 
-	if (rma) {
+	if (ioc->ioc_fwd_buf != NULL) {
+		D_ASSERT(obj_rpc_is_update(rpc));
+		rc = bio_iod_copy(biod, ioc->ioc_fwd_buf->ofb_sgls,
+				  orw->orw_nr);
+	} else if (rma) {
 		bulk_bind = orw->orw_flags & ORF_BULK_BIND;
 		rc = obj_bulk_transfer(rpc, bulk_op, bulk_bind,
 				       orw->orw_bulks.ca_arrays, offs,
@@ -1892,6 +2006,40 @@ lat_bucket(uint64_t size)
 	return 56 - nr;
 }
 
+/* Account the dkey hash hit by a conflict into the Space-Saving sketch. */
+static void
+obj_hot_dkey_add(struct obj_pool_metrics *opm, uint64_t dkey_hash)
+{
+	int	idx;
+
+	idx = obj_hot_dkey_sketch_add(opm->opm_hot_sketch, dkey_hash);
+	d_tm_set_gauge(opm->opm_hot_dkey[idx], dkey_hash);
+	d_tm_set_gauge(opm->opm_hot_dkey_hits[idx],
+		       opm->opm_hot_sketch[idx].ohd_hits);
+}
+
+/*
+ * Classify the operation restarted with -DER_TX_RESTART: a modification (or
+ * a DTX that modifies) hits a newer read timestamp or conflicting write, the
+ * others are reads that hit a write in their epoch uncertainty range.
+ */
+static void
+obj_conflict_sensors(struct obj_io_context *ioc)
+{
+	struct obj_pool_metrics	*opm;
+
+	opm = ioc->ioc_coc->sc_pool->spc_metrics[DAOS_OBJ_MODULE];
+
+	if (obj_is_modification_opc(ioc->ioc_opc) ||
+	    ioc->ioc_opc == DAOS_OBJ_RPC_CPD)
+		d_tm_inc_counter(opm->opm_conflict_rw, 1);
+	else
+		d_tm_inc_counter(opm->opm_conflict_uncertain, 1);
+
+	if (ioc->ioc_dkey_hash != 0)
+		obj_hot_dkey_add(opm, ioc->ioc_dkey_hash);
+}
+
 static inline void
 obj_update_sensors(struct obj_io_context *ioc, int err)
 {
@@ -1906,8 +2054,11 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 	d_tm_dec_gauge(tls->ot_op_active[opc], 1);
 	d_tm_inc_counter(opm->opm_total[opc], 1);
 
-	if (unlikely(err != 0))
+	if (unlikely(err != 0)) {
+		if (err == -DER_TX_RESTART)
+			obj_conflict_sensors(ioc);
 		return;
+	}
 
 	/**
 	 * Measure latency of successful I/O only.
@@ -2209,6 +2360,8 @@ ds_obj_tgt_update_handler(crt_rpc_t *rpc)
 	if (rc)
 		goto out;
 
+	ioc.ioc_dkey_hash = orw->orw_dkey_hash;
+
 	if (DAOS_FAIL_CHECK(DAOS_VC_DIFF_DKEY)) {
 		unsigned char	*buf = dkey->iov_buf;
 
@@ -2473,6 +2626,8 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 		goto out;
 	}
 
+	ioc.ioc_dkey_hash = orw->orw_dkey_hash;
+
 	D_DEBUG(DB_IO,
 		"rpc %p opc %d oid "DF_UOID" dkey "DF_KEY" tag/xs %d/%d epc "
 		DF_X64", pmv %u/%u dti "DF_DTI".\n",
@@ -2566,6 +2721,9 @@ again1:
 		D_GOTO(out, rc);
 	}
 
+	if (!(flags & ORF_RESEND))
+		dtx_act_throttle(ioc.ioc_coc);
+
 again2:
 	if (orw->orw_iod_array.oia_oiods != NULL && split_req == NULL) {
 		rc = obj_ec_rw_req_split(orw->orw_oid, &orw->orw_iod_array,
@@ -2579,16 +2737,30 @@ again2:
 		}
 	}
 
+	if (tgt_cnt != 0 && split_req == NULL && ioc.ioc_fwd_buf == NULL) {
+		rc = obj_fwd_buf_prep(rpc, &ioc, &ioc.ioc_fwd_buf);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		if (ioc.ioc_fwd_buf != NULL) {
+			d_tm_inc_counter(opm->opm_fwd_relay, 1);
+			d_tm_inc_counter(opm->opm_fwd_relay_bytes,
+					 ioc.ioc_fwd_buf->ofb_size * tgt_cnt);
+		}
+	}
+
 	/* For leader case, we need to find out the potential conflict
 	 * (or share the same non-committed object/dkey) DTX(s) in the
 	 * CoS (committable) cache, piggyback them via the dispdatched
 	 * RPC to non-leaders. Then the non-leader replicas can commit
 	 * them before real modifications to avoid availability issues.
+	 * Some other committable DTXs against the same object/dkey are
+	 * piggybacked too, to save the explicit DTX commit RPCs.
 	 */
 	D_FREE(dti_cos);
 	dti_cos_cnt = dtx_list_cos(ioc.ioc_coc, &orw->orw_oid,
-				   orw->orw_dkey_hash, DTX_THRESHOLD_COUNT,
-				   &dti_cos);
+				   orw->orw_dkey_hash, version, mbs,
+				   DTX_THRESHOLD_COUNT, &dti_cos);
 	if (dti_cos_cnt < 0)
 		D_GOTO(out, rc = dti_cos_cnt);
 
@@ -2653,6 +2825,7 @@ again2:
 			orw->orw_flags &= ~ORF_RESEND;
 			flags = 0;
 			d_tm_inc_counter(m->opm_update_restart, 1);
+			obj_conflict_sensors(&ioc);
 			goto again2;
 		}
 
@@ -2689,6 +2862,7 @@ out:
 
 	obj_rw_reply(rpc, rc, epoch.oe_value, &ioc);
 	obj_ec_split_req_fini(split_req);
+	obj_fwd_buf_free(ioc.ioc_fwd_buf);
 	D_FREE(mbs);
 	D_FREE(dti_cos);
 	obj_ioc_end(&ioc, rc);
@@ -3207,6 +3381,8 @@ ds_obj_tgt_punch_handler(crt_rpc_t *rpc)
 	if (rc)
 		goto out;
 
+	ioc.ioc_dkey_hash = opi->opi_dkey_hash;
+
 	/* Handle resend. */
 	if (opi->opi_flags & ORF_RESEND) {
 		daos_epoch_t	e = opi->opi_epoch;
@@ -3393,6 +3569,8 @@ ds_obj_punch_handler(crt_rpc_t *rpc)
 	if (rc)
 		goto out;
 
+	ioc.ioc_dkey_hash = opi->opi_dkey_hash;
+
 	if (opi->opi_dkeys.ca_count == 0)
 		D_DEBUG(DB_TRACE,
 			"punch obj %p oid "DF_UOID" tag/xs %d/%d epc "
@@ -3463,17 +3641,22 @@ again1:
 		goto cleanup;
 	}
 
+	if (!(flags & ORF_RESEND))
+		dtx_act_throttle(ioc.ioc_coc);
+
 again2:
 	/* For leader case, we need to find out the potential conflict
 	 * (or share the same non-committed object/dkey) DTX(s) in the
 	 * CoS (committable) cache, piggyback them via the dispdatched
 	 * RPC to non-leaders. Then the non-leader replicas can commit
 	 * them before real modifications to avoid availability issues.
+	 * Some other committable DTXs against the same object/dkey are
+	 * piggybacked too, to save the explicit DTX commit RPCs.
 	 */
 	D_FREE(dti_cos);
 	dti_cos_cnt = dtx_list_cos(ioc.ioc_coc, &opi->opi_oid,
-				   opi->opi_dkey_hash, DTX_THRESHOLD_COUNT,
-				   &dti_cos);
+				   opi->opi_dkey_hash, version, mbs,
+				   DTX_THRESHOLD_COUNT, &dti_cos);
 	if (dti_cos_cnt < 0)
 		D_GOTO(out, rc = dti_cos_cnt);
 
@@ -3526,6 +3709,7 @@ again2:
 		opi->opi_epoch = crt_hlc_get();
 		opi->opi_flags &= ~ORF_RESEND;
 		flags = 0;
+		obj_conflict_sensors(&ioc);
 		goto again2;
 	case -DER_AGAIN:
 		opi->opi_flags |= ORF_RESEND;
@@ -3656,12 +3840,6 @@ failed:
 		D_ERROR("send reply failed: "DF_RC"\n", DP_RC(rc));
 }
 
-void
-ds_obj_query_key_handler_0(crt_rpc_t *rpc)
-{
-	ds_obj_query_key_handler(rpc, false);
-}
-
 void
 ds_obj_query_key_handler_1(crt_rpc_t *rpc)
 {
@@ -4223,13 +4401,13 @@ again:
 }
 
 static int
-ds_obj_dtx_follower(crt_rpc_t *rpc, struct obj_io_context *ioc)
+ds_obj_dtx_follower(crt_rpc_t *rpc, struct obj_io_context *ioc, int idx)
 {
 	struct dtx_handle		*dth = NULL;
 	struct obj_cpd_in		*oci = crt_req_get(rpc);
-	struct daos_cpd_sub_head	*dcsh = ds_obj_cpd_get_dcsh(rpc, 0);
-	struct daos_cpd_disp_ent	*dcde = ds_obj_cpd_get_dcde(rpc, 0, 0);
-	struct daos_cpd_sub_req		*dcsr = ds_obj_cpd_get_dcsr(rpc, 0);
+	struct daos_cpd_sub_head	*dcsh = ds_obj_cpd_get_dcsh(rpc, idx);
+	struct daos_cpd_disp_ent	*dcde = ds_obj_cpd_get_dcde(rpc, idx, 0);
+	struct daos_cpd_sub_req		*dcsr = ds_obj_cpd_get_dcsr(rpc, idx);
 	daos_epoch_t			 e = dcsh->dcsh_epoch.oe_value;
 	uint32_t			 dtx_flags = DTX_DIST;
 	int				 rc = 0;
@@ -4514,6 +4692,9 @@ again:
 	if (rc != 0)
 		goto out;
 
+	if (dcde->dcde_write_cnt != 0 && !(flags & ORF_RESEND))
+		dtx_act_throttle(dca->dca_ioc->ioc_coc);
+
 	/* 'tgts[0]' is for current dtx leader. */
 	if (tgt_cnt == 1)
 		tgts = NULL;
@@ -4636,8 +4817,9 @@ ds_obj_cpd_handler(crt_rpc_t *rpc)
 		goto reply;
 
 	if (!leader) {
-		if (tx_count != 1 || oci->oci_sub_reqs.ca_count != 1 ||
-		    oci->oci_disp_ents.ca_count != 1 ||
+		if (tx_count == 0 || tx_count > OBJ_CPD_BATCH_MAX ||
+		    oci->oci_sub_reqs.ca_count != tx_count ||
+		    oci->oci_disp_ents.ca_count != tx_count ||
 		    oci->oci_disp_tgts.ca_count != 0) {
 			D_ERROR("Unexpected CPD RPC format for non-leader: "
 				"head %u, req set %lu, disp %lu, tgts %lu\n",
@@ -4648,11 +4830,34 @@ ds_obj_cpd_handler(crt_rpc_t *rpc)
 			D_GOTO(reply, rc = -DER_PROTO);
 		}
 
-		oco->oco_sub_rets.ca_arrays = NULL;
-		oco->oco_sub_rets.ca_count = 0;
-		rc = ds_obj_dtx_follower(rpc, &ioc);
+		if (tx_count == 1) {
+			oco->oco_sub_rets.ca_arrays = NULL;
+			oco->oco_sub_rets.ca_count = 0;
+			rc = ds_obj_dtx_follower(rpc, &ioc, 0);
 
-		D_GOTO(reply, rc);
+			D_GOTO(reply, rc);
+		}
+
+		/*
+		 * The DTXs coalesced by the leader, see obj_cpd_batch_add().
+		 * They are independent, each one is handled via its own local
+		 * transaction and has its own result.
+		 */
+		D_ALLOC(oco->oco_sub_rets.ca_arrays, sizeof(int32_t) * tx_count);
+		if (oco->oco_sub_rets.ca_arrays == NULL)
+			D_GOTO(reply, rc = -DER_NOMEM);
+
+		oco->oco_sub_rets.ca_count = tx_count;
+		for (i = 0; i < tx_count; i++) {
+			/* Tests check that the others survive a failed one. */
+			if (i == 0 && DAOS_FAIL_CHECK(DAOS_DTX_CPD_BATCH))
+				rc = -DER_IO;
+			else
+				rc = ds_obj_dtx_follower(rpc, &ioc, i);
+			((int32_t *)oco->oco_sub_rets.ca_arrays)[i] = rc;
+		}
+
+		D_GOTO(reply, rc = 0);
 	}
 
 	if (tx_count != oci->oci_sub_reqs.ca_count ||
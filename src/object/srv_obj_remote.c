@@ -34,6 +34,8 @@ struct obj_remote_cb_arg {
 	void				*cpd_head;
 	void				*cpd_dcsr;
 	void				*cpd_dcde;
+	struct obj_pool_metrics		*opm;
+	uint64_t			 start_time;
 };
 
 static void
@@ -57,6 +59,11 @@ do_shard_update_req_cb(crt_rpc_t *req, struct obj_remote_cb_arg *arg, int rc)
 	if (rc >= 0)
 		rc = rc1;
 
+	/* latency of one replica hop, including the data transfer */
+	if (arg->opm != NULL)
+		d_tm_set_gauge(arg->opm->opm_fwd_update_lat,
+			       (daos_get_ntime() - arg->start_time) / 1000);
+
 	arg->comp_cb(dlh, arg->idx, rc);
 	crt_req_decref(parent_req);
 	D_FREE(arg);
@@ -85,6 +92,8 @@ ds_obj_remote_update(struct dtx_leader_handle *dlh, void *data, int idx,
 	struct obj_remote_cb_arg	*remote_arg = NULL;
 	struct obj_rw_in		*orw;
 	struct obj_rw_in		*orw_parent;
+	struct obj_io_context		*ioc = obj_exec_arg->ioc;
+	struct obj_fwd_buf		*fwd = ioc->ioc_fwd_buf;
 	uint32_t			 tgt_idx;
 	int				 rc = 0;
 
@@ -142,9 +151,20 @@ ds_obj_remote_update(struct dtx_leader_handle *dlh, void *data, int idx,
 	orw->orw_flags |= ORF_BULK_BIND | obj_exec_arg->flags;
 	orw->orw_dti_cos.ca_count	= dth->dth_dti_cos_count;
 	orw->orw_dti_cos.ca_arrays	= dth->dth_dti_cos;
+	if (fwd != NULL) {
+		/* Pull the data from the leader instead of from the client */
+		orw->orw_bulks.ca_count = fwd->ofb_nr;
+		orw->orw_bulks.ca_arrays = fwd->ofb_bulks;
+		orw->orw_iod_array.oia_offs = NULL;
+	}
 
-	D_DEBUG(DB_TRACE, DF_UOID" forwarding to rank:%d tag:%d.\n",
-		DP_UOID(orw->orw_oid), tgt_ep.ep_rank, tgt_ep.ep_tag);
+	if (ioc->ioc_coc != NULL)
+		remote_arg->opm = ioc->ioc_coc->sc_pool->spc_metrics[DAOS_OBJ_MODULE];
+	remote_arg->start_time = daos_get_ntime();
+
+	D_DEBUG(DB_TRACE, DF_UOID" forwarding to rank:%d tag:%d%s.\n",
+		DP_UOID(orw->orw_oid), tgt_ep.ep_rank, tgt_ep.ep_tag,
+		fwd != NULL ? " (relay)" : "");
 	rc = crt_req_send(req, shard_update_req_cb, remote_arg);
 	if (rc != 0) {
 		D_ASSERT(sub->dss_comp == 1);
@@ -279,13 +299,8 @@ out:
 }
 
 static void
-do_shard_cpd_req_cb(crt_rpc_t *req, struct obj_remote_cb_arg *arg, int rc)
+shard_cpd_req_done(struct obj_remote_cb_arg *arg, int rc)
 {
-	struct obj_cpd_out	*oco = crt_reply_get(req);
-
-	if (rc >= 0)
-		rc = oco->oco_ret;
-
 	arg->comp_cb(arg->dlh, arg->idx, rc);
 	crt_req_decref(arg->parent_req);
 	D_FREE(arg->cpd_reqs);
@@ -296,12 +311,212 @@ do_shard_cpd_req_cb(crt_rpc_t *req, struct obj_remote_cb_arg *arg, int rc)
 	D_FREE(arg);
 }
 
+static void
+do_shard_cpd_req_cb(crt_rpc_t *req, struct obj_remote_cb_arg *arg, int rc)
+{
+	struct obj_cpd_out	*oco = crt_reply_get(req);
+
+	if (rc >= 0)
+		rc = oco->oco_ret;
+
+	shard_cpd_req_done(arg, rc);
+}
+
 static inline void
 shard_cpd_req_cb(const struct crt_cb_info *cb_info)
 {
 	do_shard_cpd_req_cb(cb_info->cci_rpc, cb_info->cci_arg, cb_info->cci_rc);
 }
 
+/*
+ * The CPD dispatches from different DTXs (usually from concurrent CPD RPCs)
+ * to the same follower target, that are coalesced into one CPD RPC.
+ */
+struct obj_cpd_batch {
+	d_list_t			 ocb_link;
+	crt_endpoint_t			 ocb_ep;
+	uuid_t				 ocb_pool_uuid;
+	uuid_t				 ocb_co_hdl;
+	uuid_t				 ocb_co_uuid;
+	uint32_t			 ocb_map_ver;
+	uint32_t			 ocb_flags;
+	uint32_t			 ocb_nr;
+	uint32_t			 ocb_max;
+	struct obj_pool_metrics		*ocb_opm;
+	struct daos_cpd_sg		*ocb_heads;
+	struct daos_cpd_sg		*ocb_reqs;
+	struct daos_cpd_sg		*ocb_disps;
+	struct obj_remote_cb_arg	*ocb_args[OBJ_CPD_BATCH_MAX];
+};
+
+static void
+obj_cpd_batch_free(struct obj_cpd_batch *ocb)
+{
+	D_FREE(ocb->ocb_heads);
+	D_FREE(ocb->ocb_reqs);
+	D_FREE(ocb->ocb_disps);
+	D_FREE(ocb);
+}
+
+static void
+obj_cpd_batch_cb(const struct crt_cb_info *cb_info)
+{
+	struct obj_cpd_batch	*ocb = cb_info->cci_arg;
+	struct obj_cpd_out	*oco = crt_reply_get(cb_info->cci_rpc);
+	int			 rc = cb_info->cci_rc;
+	int			 rc1;
+	int			 i;
+
+	if (rc >= 0)
+		rc = oco->oco_ret;
+
+	for (i = 0; i < ocb->ocb_nr; i++) {
+		rc1 = rc;
+		/* Each coalesced DTX has its own result on the follower. */
+		if (rc1 == 0 && ocb->ocb_nr > 1) {
+			if (oco->oco_sub_rets.ca_count != ocb->ocb_nr)
+				rc1 = -DER_PROTO;
+			else
+				rc1 = ((int32_t *)oco->oco_sub_rets.ca_arrays)[i];
+		}
+
+		shard_cpd_req_done(ocb->ocb_args[i], rc1);
+	}
+
+	obj_cpd_batch_free(ocb);
+}
+
+static void
+obj_cpd_batch_send(struct obj_cpd_batch *ocb)
+{
+	struct obj_cpd_in	*oci;
+	crt_rpc_t		*req = NULL;
+	int			 rc;
+	int			 i;
+
+	D_ALLOC_ARRAY(ocb->ocb_heads, ocb->ocb_nr);
+	D_ALLOC_ARRAY(ocb->ocb_reqs, ocb->ocb_nr);
+	D_ALLOC_ARRAY(ocb->ocb_disps, ocb->ocb_nr);
+	if (ocb->ocb_heads == NULL || ocb->ocb_reqs == NULL ||
+	    ocb->ocb_disps == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	rc = obj_req_create(dss_get_module_info()->dmi_ctx, &ocb->ocb_ep,
+			    DAOS_OBJ_RPC_CPD, &req);
+	if (rc != 0) {
+		D_ERROR("CPD crt_req_create failed for %u DTXs: "DF_RC"\n",
+			ocb->ocb_nr, DP_RC(rc));
+		goto out;
+	}
+
+	for (i = 0; i < ocb->ocb_nr; i++) {
+		ocb->ocb_heads[i] = *(struct daos_cpd_sg *)ocb->ocb_args[i]->cpd_head;
+		ocb->ocb_reqs[i] = *(struct daos_cpd_sg *)ocb->ocb_args[i]->cpd_dcsr;
+		ocb->ocb_disps[i] = *(struct daos_cpd_sg *)ocb->ocb_args[i]->cpd_dcde;
+	}
+
+	oci = crt_req_get(req);
+	uuid_copy(oci->oci_pool_uuid, ocb->ocb_pool_uuid);
+	uuid_copy(oci->oci_co_hdl, ocb->ocb_co_hdl);
+	uuid_copy(oci->oci_co_uuid, ocb->ocb_co_uuid);
+	oci->oci_map_ver = ocb->ocb_map_ver;
+	oci->oci_flags = ocb->ocb_flags;
+	oci->oci_sub_heads.ca_arrays = ocb->ocb_heads;
+	oci->oci_sub_heads.ca_count = ocb->ocb_nr;
+	oci->oci_sub_reqs.ca_arrays = ocb->ocb_reqs;
+	oci->oci_sub_reqs.ca_count = ocb->ocb_nr;
+	oci->oci_disp_ents.ca_arrays = ocb->ocb_disps;
+	oci->oci_disp_ents.ca_count = ocb->ocb_nr;
+	oci->oci_disp_tgts.ca_arrays = NULL;
+	oci->oci_disp_tgts.ca_count = 0;
+
+	if (ocb->ocb_nr > 1)
+		d_tm_inc_counter(ocb->ocb_opm->opm_cpd_coalesced, ocb->ocb_nr);
+
+	D_DEBUG(DB_TRACE, "Forwarding CPD RPC to rank:%d tag:%d for %u DTXs\n",
+		ocb->ocb_ep.ep_rank, ocb->ocb_ep.ep_tag, ocb->ocb_nr);
+
+	/* The callback is always triggered, even if failed to send. */
+	rc = crt_req_send(req, obj_cpd_batch_cb, ocb);
+	if (rc != 0)
+		D_ERROR("crt_req_send failed, rc "DF_RC"\n", DP_RC(rc));
+	return;
+
+out:
+	for (i = 0; i < ocb->ocb_nr; i++)
+		shard_cpd_req_done(ocb->ocb_args[i], rc);
+	obj_cpd_batch_free(ocb);
+}
+
+static void
+obj_cpd_batch_ult(void *arg)
+{
+	struct obj_cpd_batch	*ocb = arg;
+
+	/*
+	 * Yield to let the DTXs from the concurrent CPD RPCs on this xstream
+	 * join the batch. The batch is removed from the list if it is full.
+	 */
+	if (ocb->ocb_nr < ocb->ocb_max)
+		ABT_thread_yield();
+
+	d_list_del_init(&ocb->ocb_link);
+	obj_cpd_batch_send(ocb);
+}
+
+/*
+ * Add the dispatch to the batch for the same follower target, container, pool
+ * map version and RPC flags on current xstream. The first dispatch creates the
+ * batch and the ULT to send it. No lock is needed as all of them are on the
+ * same xstream.
+ */
+static int
+obj_cpd_batch_add(struct obj_remote_cb_arg *remote_arg, crt_endpoint_t *tgt_ep,
+		  struct obj_cpd_in *oci_parent, uint32_t flags,
+		  struct obj_pool_metrics *opm, uint32_t max)
+{
+	struct obj_tls		*tls = obj_tls_get();
+	struct obj_cpd_batch	*ocb;
+	int			 rc;
+
+	d_list_for_each_entry(ocb, &tls->ot_cpd_batches, ocb_link) {
+		if (ocb->ocb_ep.ep_rank == tgt_ep->ep_rank &&
+		    ocb->ocb_ep.ep_tag == tgt_ep->ep_tag &&
+		    ocb->ocb_map_ver == oci_parent->oci_map_ver &&
+		    ocb->ocb_flags == flags &&
+		    uuid_compare(ocb->ocb_co_hdl, oci_parent->oci_co_hdl) == 0)
+			goto add;
+	}
+
+	D_ALLOC_PTR(ocb);
+	if (ocb == NULL)
+		return -DER_NOMEM;
+
+	ocb->ocb_ep = *tgt_ep;
+	uuid_copy(ocb->ocb_pool_uuid, oci_parent->oci_pool_uuid);
+	uuid_copy(ocb->ocb_co_hdl, oci_parent->oci_co_hdl);
+	uuid_copy(ocb->ocb_co_uuid, oci_parent->oci_co_uuid);
+	ocb->ocb_map_ver = oci_parent->oci_map_ver;
+	ocb->ocb_flags = flags;
+	ocb->ocb_max = max;
+	ocb->ocb_opm = opm;
+
+	rc = dss_ult_create(obj_cpd_batch_ult, ocb, DSS_XS_SELF, 0, 0, NULL);
+	if (rc != 0) {
+		D_FREE(ocb);
+		return rc;
+	}
+
+	d_list_add_tail(&ocb->ocb_link, &tls->ot_cpd_batches);
+
+add:
+	ocb->ocb_args[ocb->ocb_nr++] = remote_arg;
+	if (ocb->ocb_nr >= ocb->ocb_max)
+		d_list_del_init(&ocb->ocb_link);
+
+	return 0;
+}
+
 static int
 ds_obj_cpd_clone_reqs(struct daos_shard_tgt *tgt, struct daos_cpd_disp_ent *dcde_parent,
 		      struct daos_cpd_sub_req *dcsr_parent, int total,
@@ -408,6 +623,8 @@ ds_obj_cpd_dispatch(struct dtx_leader_handle *dlh, void *arg, int idx,
 	struct daos_cpd_sg		*head_dcs = NULL;
 	struct daos_cpd_sg		*dcsr_dcs = NULL;
 	struct daos_cpd_sg		*dcde_dcs = NULL;
+	uint32_t			 flags;
+	uint32_t			 batch;
 	int				 total;
 	int				 count;
 	int				 rc = 0;
@@ -447,33 +664,14 @@ ds_obj_cpd_dispatch(struct dtx_leader_handle *dlh, void *arg, int idx,
 	tgt_ep.ep_rank = shard_tgt->st_rank;
 	tgt_ep.ep_tag = shard_tgt->st_tgt_idx;
 
-	rc = obj_req_create(dss_get_module_info()->dmi_ctx, &tgt_ep,
-			    DAOS_OBJ_RPC_CPD, &req);
-	if (rc != 0) {
-		D_ERROR("CPD crt_req_create failed, idx %u: "DF_RC"\n",
-			idx, DP_RC(rc));
-		D_GOTO(out, rc);
-	}
-
 	oci_parent = crt_req_get(parent_req);
-	oci = crt_req_get(req);
-
-	uuid_copy(oci->oci_pool_uuid, oci_parent->oci_pool_uuid);
-	uuid_copy(oci->oci_co_hdl, oci_parent->oci_co_hdl);
-	uuid_copy(oci->oci_co_uuid, oci_parent->oci_co_uuid);
-	oci->oci_map_ver = oci_parent->oci_map_ver;
-	oci->oci_flags = (oci_parent->oci_flags | exec_arg->flags) &
-			~(ORF_HAS_EC_SPLIT | ORF_CPD_LEADER);
-
-	oci->oci_disp_tgts.ca_arrays = NULL;
-	oci->oci_disp_tgts.ca_count = 0;
+	flags = (oci_parent->oci_flags | exec_arg->flags) &
+		~(ORF_HAS_EC_SPLIT | ORF_CPD_LEADER);
 
 	dcsh = ds_obj_cpd_get_dcsh(dca->dca_rpc, dca->dca_idx);
 	head_dcs->dcs_type = DCST_HEAD;
 	head_dcs->dcs_nr = 1;
 	head_dcs->dcs_buf = dcsh;
-	oci->oci_sub_heads.ca_arrays = head_dcs;
-	oci->oci_sub_heads.ca_count = 1;
 
 	dcsr_parent = ds_obj_cpd_get_dcsr(dca->dca_rpc, dca->dca_idx);
 	total = ds_obj_cpd_get_dcsr_cnt(dca->dca_rpc, dca->dca_idx);
@@ -500,14 +698,53 @@ ds_obj_cpd_dispatch(struct dtx_leader_handle *dlh, void *arg, int idx,
 	dcsr_dcs->dcs_type = DCST_REQ_SRV;
 	dcsr_dcs->dcs_nr = count;
 	dcsr_dcs->dcs_buf = dcsr;
-	oci->oci_sub_reqs.ca_arrays = dcsr_dcs;
-	oci->oci_sub_reqs.ca_count = 1;
 
 	dcde_dcs->dcs_type = DCST_DISP;
 	dcde_dcs->dcs_nr = 1;
 	dcde_dcs->dcs_buf = dcde;
+
+	batch = obj_cpd_batch_size;
+	/* Tests enable the coalescing with the batch size as fail value. */
+	if (DAOS_FAIL_CHECK(DAOS_DTX_CPD_BATCH))
+		batch = min(daos_fail_value_get(), OBJ_CPD_BATCH_MAX);
+
+	if (batch > 1) {
+		struct obj_pool_metrics	*opm;
+
+		opm = exec_arg->ioc->ioc_coc->sc_pool->spc_metrics[DAOS_OBJ_MODULE];
+		rc = obj_cpd_batch_add(remote_arg, &tgt_ep, oci_parent, flags,
+				       opm, batch);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		D_DEBUG(DB_TRACE, "Coalescing CPD RPC to rank:%d tag:%d idx %u "
+			"for DXT "DF_DTI"\n", tgt_ep.ep_rank, tgt_ep.ep_tag, idx,
+			DP_DTI(&dcsh->dcsh_xid));
+		return 0;
+	}
+
+	rc = obj_req_create(dss_get_module_info()->dmi_ctx, &tgt_ep,
+			    DAOS_OBJ_RPC_CPD, &req);
+	if (rc != 0) {
+		D_ERROR("CPD crt_req_create failed, idx %u: "DF_RC"\n",
+			idx, DP_RC(rc));
+		D_GOTO(out, rc);
+	}
+
+	oci = crt_req_get(req);
+	uuid_copy(oci->oci_pool_uuid, oci_parent->oci_pool_uuid);
+	uuid_copy(oci->oci_co_hdl, oci_parent->oci_co_hdl);
+	uuid_copy(oci->oci_co_uuid, oci_parent->oci_co_uuid);
+	oci->oci_map_ver = oci_parent->oci_map_ver;
+	oci->oci_flags = flags;
+	oci->oci_sub_heads.ca_arrays = head_dcs;
+	oci->oci_sub_heads.ca_count = 1;
+	oci->oci_sub_reqs.ca_arrays = dcsr_dcs;
+	oci->oci_sub_reqs.ca_count = 1;
 	oci->oci_disp_ents.ca_arrays = dcde_dcs;
 	oci->oci_disp_ents.ca_count = 1;
+	oci->oci_disp_tgts.ca_arrays = NULL;
+	oci->oci_disp_tgts.ca_count = 0;
 
 	D_DEBUG(DB_TRACE, "Forwarding CPD RPC to rank:%d tag:%d idx %u for DXT "
 		DF_DTI"\n",
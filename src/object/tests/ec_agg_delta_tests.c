@@ -0,0 +1,183 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests of the incremental parity update used by EC aggregation for
+ * partial stripes.
+ */
+
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include <daos/common.h>
+#include <daos/tests_lib.h>
+#include "../obj_ec.h"
+
+#define DELTA_K		4
+#define DELTA_P		2
+#define DELTA_CELL	4096
+
+struct delta_test_arg {
+	unsigned char	*dt_matrix;
+	unsigned char	*dt_gftbls;
+	unsigned char	*dt_data[DELTA_K];
+	unsigned char	*dt_parity[DELTA_P];
+	unsigned char	*dt_expected[DELTA_P];
+};
+
+static void
+fill_random(unsigned char *buf, size_t len)
+{
+	size_t	i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = rand();
+}
+
+static int
+delta_setup(void **state)
+{
+	struct delta_test_arg	*arg;
+	int			 i;
+
+	D_ALLOC_PTR(arg);
+	assert_non_null(arg);
+	D_ALLOC(arg->dt_matrix, (DELTA_K + DELTA_P) * DELTA_K);
+	assert_non_null(arg->dt_matrix);
+	D_ALLOC(arg->dt_gftbls, 32 * DELTA_K * DELTA_P);
+	assert_non_null(arg->dt_gftbls);
+	gf_gen_cauchy1_matrix(arg->dt_matrix, DELTA_K + DELTA_P, DELTA_K);
+	ec_init_tables(DELTA_K, DELTA_P, &arg->dt_matrix[DELTA_K * DELTA_K],
+		       arg->dt_gftbls);
+
+	for (i = 0; i < DELTA_K; i++) {
+		D_ALLOC(arg->dt_data[i], DELTA_CELL);
+		assert_non_null(arg->dt_data[i]);
+		fill_random(arg->dt_data[i], DELTA_CELL);
+	}
+	for (i = 0; i < DELTA_P; i++) {
+		D_ALLOC(arg->dt_parity[i], DELTA_CELL);
+		assert_non_null(arg->dt_parity[i]);
+		D_ALLOC(arg->dt_expected[i], DELTA_CELL);
+		assert_non_null(arg->dt_expected[i]);
+	}
+	ec_encode_data(DELTA_CELL, DELTA_K, DELTA_P, arg->dt_gftbls,
+		       arg->dt_data, arg->dt_parity);
+
+	*state = arg;
+	return 0;
+}
+
+static int
+delta_teardown(void **state)
+{
+	struct delta_test_arg	*arg = *state;
+	int			 i;
+
+	for (i = 0; i < DELTA_K; i++)
+		D_FREE(arg->dt_data[i]);
+	for (i = 0; i < DELTA_P; i++) {
+		D_FREE(arg->dt_parity[i]);
+		D_FREE(arg->dt_expected[i]);
+	}
+	D_FREE(arg->dt_gftbls);
+	D_FREE(arg->dt_matrix);
+	D_FREE(arg);
+	return 0;
+}
+
+/**
+ * Overwrite the cells in @bit_map, update the parity incrementally and
+ * compare it with the parity encoded from the full new stripe.
+ */
+static void
+delta_update_check(struct delta_test_arg *arg, uint8_t bit_map)
+{
+	unsigned char	*odata;
+	unsigned char	*data;
+	unsigned char	*diff;
+	unsigned int	 cell_cnt = 0;
+	int		 i;
+	int		 rc;
+
+	D_ALLOC(odata, DELTA_K * DELTA_CELL);
+	assert_non_null(odata);
+	D_ALLOC(data, DELTA_K * DELTA_CELL);
+	assert_non_null(data);
+	D_ALLOC(diff, DELTA_CELL);
+	assert_non_null(diff);
+
+	for (i = 0; i < DELTA_K; i++) {
+		if (!isset(&bit_map, i))
+			continue;
+		memcpy(&odata[cell_cnt * DELTA_CELL], arg->dt_data[i],
+		       DELTA_CELL);
+		fill_random(arg->dt_data[i], DELTA_CELL);
+		memcpy(&data[cell_cnt * DELTA_CELL], arg->dt_data[i],
+		       DELTA_CELL);
+		cell_cnt++;
+	}
+
+	rc = obj_ec_parity_delta_update(arg->dt_gftbls, DELTA_K, DELTA_P,
+					DELTA_CELL, &bit_map, cell_cnt, odata,
+					data, diff, arg->dt_parity, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	ec_encode_data(DELTA_CELL, DELTA_K, DELTA_P, arg->dt_gftbls,
+		       arg->dt_data, arg->dt_expected);
+	for (i = 0; i < DELTA_P; i++)
+		assert_memory_equal(arg->dt_parity[i], arg->dt_expected[i],
+				    DELTA_CELL);
+
+	D_FREE(diff);
+	D_FREE(data);
+	D_FREE(odata);
+}
+
+static void
+delta_update_single_cell(void **state)
+{
+	delta_update_check(*state, 1 << 2);
+}
+
+static void
+delta_update_adjacent_cells(void **state)
+{
+	delta_update_check(*state, (1 << 0) | (1 << 1));
+}
+
+static void
+delta_update_sparse_cells(void **state)
+{
+	delta_update_check(*state, (1 << 1) | (1 << 3));
+	delta_update_check(*state, (1 << 0) | (1 << 2) | (1 << 3));
+}
+
+#define	TS(desc, test_fn) \
+	{ "EC_AGG_DELTA" desc, test_fn, delta_setup, delta_teardown }
+
+static const struct CMUnitTest delta_tests[] = {
+	TS("01: Delta update of one cell", delta_update_single_cell),
+	TS("02: Delta update of adjacent cells", delta_update_adjacent_cells),
+	TS("03: Delta update of non-adjacent cells", delta_update_sparse_cells),
+};
+
+int
+main(int argc, char **argv)
+{
+	int	rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0)
+		return rc;
+
+	rc = cmocka_run_group_tests_name("EC aggregation parity delta update",
+					 delta_tests, NULL, NULL);
+
+	daos_debug_fini();
+	return rc;
+}
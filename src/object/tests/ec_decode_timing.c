@@ -0,0 +1,255 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Measure the client side latency of recovering one EC cell in degraded
+ * mode, with the decode tables generated for every recovery (as the client
+ * did before the per object class decode tables cache) and with the tables
+ * taken from the cache.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include <daos/common.h>
+#include <gurt/common.h>
+#include "../obj_ec.h"
+
+struct dec_timing_args {
+	struct obj_ec_codec	*codec;
+	unsigned char		**cells;	/* k data cells + p parity */
+	unsigned char		**recov;	/* recovered cells */
+	size_t			 len;
+	uint32_t		 iterations;
+	uint32_t		 nerrs;
+	bool			 cached;
+};
+
+static int
+timebox(int (*cb)(void *), void *arg, uint64_t *nsec)
+{
+	struct timespec	start, end;
+	int		rc;
+
+	d_gettime(&start);
+	rc = cb(arg);
+	d_gettime(&end);
+
+	*nsec = d_timediff_ns(&start, &end);
+
+	return rc;
+}
+
+/** Convert nanosec to human readable time */
+static void
+nsec_hr(double nsec, char *buf)
+{
+	int			 i = 0;
+	static const char	*const units[] = {"nsec", "usec", "sec",
+						    "min", "hr"};
+	uint32_t divisor[] = {
+		1e3 /** nsec->usec */,
+		1e6 /** usec->sec */,
+		60 /** sec->min */,
+		60 /** min->hr */};
+
+	while (nsec >= divisor[i]) {
+		nsec /= divisor[i];
+		i++;
+	}
+	sprintf(buf, "%.*f %s", i, nsec, units[i]);
+}
+
+/**
+ * Recover the failed cells, the failure pattern rotates over the data cells
+ * like degraded fetches from different objects would do.
+ */
+static int
+dec_timed_cb(void *arg)
+{
+	struct dec_timing_args	*args = arg;
+	struct obj_ec_codec	*codec = args->codec;
+	unsigned char		 gftbls[OBJ_EC_MAX_K * OBJ_EC_MAX_P * 32];
+	unsigned char		*srcs[OBJ_EC_MAX_K];
+	uint32_t		 err_list[OBJ_EC_MAX_P];
+	uint32_t		 dec_idx[OBJ_EC_MAX_K];
+	uint32_t		 k = codec->ec_k;
+	uint32_t		 i, j;
+	int			 rc;
+
+	for (i = 0; i < args->iterations; i++) {
+		for (j = 0; j < args->nerrs; j++)
+			err_list[j] = (i + j) % k;
+
+		if (args->cached)
+			rc = obj_ec_dec_tbl_get(codec, args->nerrs, err_list,
+						gftbls, dec_idx);
+		else
+			rc = obj_ec_dec_tbl_gen(codec, args->nerrs, err_list,
+						gftbls, dec_idx);
+		if (rc)
+			return rc;
+
+		for (j = 0; j < k; j++)
+			srcs[j] = args->cells[dec_idx[j]];
+		ec_encode_data(args->len, k, args->nerrs, gftbls, srcs,
+			       args->recov);
+
+		for (j = 0; j < args->nerrs; j++) {
+			if (memcmp(args->recov[j], args->cells[err_list[j]],
+				   args->len) != 0) {
+				printf("recovered cell %u mismatch\n",
+				       err_list[j]);
+				return -DER_IO;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+run_timings(daos_oclass_id_t oc_id, size_t len, uint32_t iterations)
+{
+	struct obj_ec_codec	*codec;
+	struct dec_timing_args	 args = { 0 };
+	unsigned char		*cells[OBJ_EC_MAX_M];
+	unsigned char		*recov[OBJ_EC_MAX_P];
+	char			 name[32];
+	char			 hr_str[2][20];
+	uint64_t		 nsec[2];
+	uint32_t		 k, p, i;
+	int			 rc = 0;
+
+	codec = obj_ec_codec_get(oc_id);
+	if (codec == NULL)
+		return -DER_INVAL;
+	k = codec->ec_k;
+	p = codec->ec_p;
+
+	memset(cells, 0, sizeof(cells));
+	memset(recov, 0, sizeof(recov));
+	for (i = 0; i < k + p; i++) {
+		D_ALLOC(cells[i], len);
+		if (cells[i] == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		if (i < k)
+			memset(cells[i], 'a' + i, len);
+	}
+	for (i = 0; i < p; i++) {
+		D_ALLOC(recov[i], len);
+		if (recov[i] == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+	}
+	ec_encode_data(len, k, p, codec->ec_gftbls, cells, &cells[k]);
+
+	daos_oclass_id2name(oc_id, name);
+	args.codec = codec;
+	args.cells = cells;
+	args.recov = recov;
+	args.len = len;
+	args.iterations = iterations;
+	for (args.nerrs = 1; args.nerrs <= p; args.nerrs++) {
+		args.cached = false;
+		rc = timebox(dec_timed_cb, &args, &nsec[0]);
+		if (rc)
+			break;
+		args.cached = true;
+		rc = timebox(dec_timed_cb, &args, &nsec[1]);
+		if (rc)
+			break;
+
+		nsec_hr(nsec[0] / iterations, hr_str[0]);
+		nsec_hr(nsec[1] / iterations, hr_str[1]);
+		printf("\t%-14s %u lost:\tgenerated %s\tcached %s\n",
+		       name, args.nerrs, hr_str[0], hr_str[1]);
+	}
+
+out:
+	for (i = 0; i < k + p; i++)
+		D_FREE(cells[i]);
+	for (i = 0; i < p; i++)
+		D_FREE(recov[i]);
+	return rc;
+}
+
+static void
+print_usage(char *name)
+{
+	printf("usage: %s [OPTIONS] ...\n\n", name);
+	printf("\t-s BYTES, --size=BYTES\t\tCell size. Default: 4096\n");
+	printf("\t-i NUM, --iterations=NUM\tRecoveries per class and "
+	       "failure number. Default: 10000\n");
+	printf("\t-h, --help\t\t\tShow this message\n");
+}
+
+static struct option l_opts[] = {
+	{"size",	required_argument,	NULL, 's'},
+	{"iterations",	required_argument,	NULL, 'i'},
+	{"help",	no_argument,		NULL, 'h'},
+	{NULL,		0,			NULL, 0}
+};
+
+int
+main(int argc, char *argv[])
+{
+	daos_oclass_id_t	 oc_ids[] = { OC_EC_2P1G1, OC_EC_4P2G1,
+					      OC_EC_8P2G1, OC_EC_16P2G1 };
+	size_t			 len = 4096;
+	uint32_t		 iterations = 10000;
+	uint32_t		 i;
+	int			 opt;
+	int			 rc;
+
+	while ((opt = getopt_long(argc, argv, "s:i:h", l_opts, NULL)) != -1) {
+		switch (opt) {
+		case 's':
+			len = (size_t)atoll(optarg);
+			break;
+		case 'i':
+			iterations = atoi(optarg);
+			break;
+		case 'h':
+		default:
+			print_usage(argv[0]);
+			return 0;
+		}
+	}
+	if (len == 0 || iterations == 0) {
+		print_usage(argv[0]);
+		return -1;
+	}
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc)
+		return rc;
+
+	rc = obj_class_init();
+	if (rc)
+		goto out_debug;
+
+	rc = obj_ec_codec_init();
+	if (rc)
+		goto out_class;
+
+	printf("Degraded recovery of %zu bytes cells, %u iterations\n", len,
+	       iterations);
+	for (i = 0; i < ARRAY_SIZE(oc_ids); i++) {
+		rc = run_timings(oc_ids[i], len, iterations);
+		if (rc) {
+			printf("class %u failed: "DF_RC"\n", i, DP_RC(rc));
+			break;
+		}
+	}
+
+	obj_ec_codec_fini();
+out_class:
+	obj_class_fini();
+out_debug:
+	daos_debug_fini();
+	return rc;
+}
@@ -0,0 +1,85 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests of the per-target fetch latency estimate driving the hedged
+ * replica reads.
+ */
+
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "../obj_internal.h"
+
+#define HEDGE_PCT	90
+
+static void
+lat_est_converge(void **state)
+{
+	struct obj_lat_est	est = { 0 };
+	int			i;
+
+	/* The first sample seeds the estimate. */
+	obj_lat_est_update(&est, 1000, HEDGE_PCT);
+	assert_int_equal(est.ole_lat, 1000);
+	assert_int_equal(est.ole_pct, 1000 * 100);
+
+	/* The EWMA moves towards the new latency. */
+	for (i = 0; i < 100; i++)
+		obj_lat_est_update(&est, 200, HEDGE_PCT);
+	assert_true(est.ole_lat < 250);
+	assert_true(est.ole_lat >= 200);
+}
+
+static void
+lat_est_abort_no_lower(void **state)
+{
+	struct obj_lat_est	est = { 0 };
+	uint64_t		lat;
+	int			i;
+
+	for (i = 0; i < 16; i++)
+		obj_lat_est_update(&est, 1000, HEDGE_PCT);
+	lat = est.ole_lat;
+
+	/*
+	 * The primary fetch won, the hedged one to the alternate is aborted
+	 * shortly after it was sent, which must not lower the EWMA of the
+	 * alternate.
+	 */
+	for (i = 0; i < 16; i++) {
+		obj_lat_est_abort(&est, 10, HEDGE_PCT);
+		assert_true(est.ole_lat >= lat);
+	}
+
+	/* A fetch aborted later than the EWMA still raises it. */
+	obj_lat_est_abort(&est, 10000, HEDGE_PCT);
+	assert_true(est.ole_lat > lat);
+}
+
+static void
+lat_est_abort_unsampled(void **state)
+{
+	struct obj_lat_est	est = { 0 };
+
+	/* An aborted fetch seeds a never sampled target with its time. */
+	obj_lat_est_abort(&est, 500, HEDGE_PCT);
+	assert_int_equal(est.ole_lat, 500);
+}
+
+static const struct CMUnitTest hedge_lat_tests[] = {
+	cmocka_unit_test(lat_est_converge),
+	cmocka_unit_test(lat_est_abort_no_lower),
+	cmocka_unit_test(lat_est_abort_unsampled),
+};
+
+int
+main(int argc, char **argv)
+{
+	return cmocka_run_group_tests_name("Hedged read latency estimate",
+					   hedge_lat_tests, NULL, NULL);
+}
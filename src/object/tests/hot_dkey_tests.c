@@ -0,0 +1,118 @@
+/**
+ * (C) Copyright 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Unit tests of the Space-Saving sketch tracking the dkey hashes hit by
+ * conflicts.
+ */
+
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include "../obj_internal.h"
+
+static void
+hot_dkey_fill(void **state)
+{
+	struct obj_hot_dkey	sketch[OBJ_HOT_DKEY_NR] = { 0 };
+	int			i;
+
+	/* The free slots are taken in order. */
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++)
+		assert_int_equal(obj_hot_dkey_sketch_add(sketch, 100 + i), i);
+
+	/* A tracked hash keeps its slot. */
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++) {
+		assert_int_equal(obj_hot_dkey_sketch_add(sketch, 100 + i), i);
+		assert_int_equal(sketch[i].ohd_hash, 100 + i);
+		assert_int_equal(sketch[i].ohd_hits, 2);
+	}
+}
+
+static void
+hot_dkey_evict(void **state)
+{
+	struct obj_hot_dkey	sketch[OBJ_HOT_DKEY_NR] = { 0 };
+	int			idx;
+	int			i;
+
+	/* Slot i is hit i + 1 times. */
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++) {
+		int	j;
+
+		for (j = 0; j <= i; j++)
+			obj_hot_dkey_sketch_add(sketch, 100 + i);
+	}
+
+	/* A new hash evicts the least hit slot and inherits its hits. */
+	idx = obj_hot_dkey_sketch_add(sketch, 200);
+	assert_int_equal(idx, 0);
+	assert_int_equal(sketch[0].ohd_hash, 200);
+	assert_int_equal(sketch[0].ohd_hits, 2);
+
+	/* Now slots 0 and 1 tie, the first one is evicted. */
+	idx = obj_hot_dkey_sketch_add(sketch, 201);
+	assert_int_equal(idx, 0);
+	assert_int_equal(sketch[0].ohd_hash, 201);
+	assert_int_equal(sketch[0].ohd_hits, 3);
+
+	/* The other slots are untouched. */
+	for (i = 1; i < OBJ_HOT_DKEY_NR; i++) {
+		assert_int_equal(sketch[i].ohd_hash, 100 + i);
+		assert_int_equal(sketch[i].ohd_hits, i + 1);
+	}
+}
+
+static void
+hot_dkey_heavy_hitter(void **state)
+{
+	struct obj_hot_dkey	sketch[OBJ_HOT_DKEY_NR] = { 0 };
+	uint64_t		hot = 0xdeadbeef;
+	uint64_t		total = 0;
+	uint64_t		hits = 0;
+	int			i;
+
+	/*
+	 * Every third conflict hits the same dkey, the others are spread over
+	 * many more dkeys than the slots. A dkey hit more than 1/NR of the
+	 * conflicts must hold a slot, with no less hits than its real ones.
+	 */
+	for (i = 0; i < 3000; i++) {
+		if (i % 3 == 0) {
+			obj_hot_dkey_sketch_add(sketch, hot);
+			hits++;
+		} else {
+			obj_hot_dkey_sketch_add(sketch, i);
+		}
+		total++;
+	}
+
+	for (i = 0; i < OBJ_HOT_DKEY_NR; i++) {
+		if (sketch[i].ohd_hash == hot)
+			break;
+	}
+	assert_true(i < OBJ_HOT_DKEY_NR);
+	assert_true(sketch[i].ohd_hits >= hits);
+
+	/* The hits of all the slots sum up to the conflicts. */
+	for (i = 0, hits = 0; i < OBJ_HOT_DKEY_NR; i++)
+		hits += sketch[i].ohd_hits;
+	assert_int_equal(hits, total);
+}
+
+static const struct CMUnitTest hot_dkey_tests[] = {
+	cmocka_unit_test(hot_dkey_fill),
+	cmocka_unit_test(hot_dkey_evict),
+	cmocka_unit_test(hot_dkey_heavy_hitter),
+};
+
+int
+main(int argc, char **argv)
+{
+	return cmocka_run_group_tests_name("Conflict hot dkey sketch",
+					   hot_dkey_tests, NULL, NULL);
+}
@@ -31,6 +31,245 @@ enum {
 
 int	ts_mode = TS_MODE_DAOS;
 int	ts_class = OC_SX;
+/* number of updates packed into one multi-dkey request, 0 or 1 to disable */
+int	ts_batch;
+
+/* updates of one object waiting for the multi-dkey submission */
+struct pf_batch {
+	/* number of dkeys in pb_ios */
+	unsigned int	 pb_dkey_nr;
+	/* number of iods of all the dkeys */
+	unsigned int	 pb_io_nr;
+	daos_dkey_io_t	*pb_ios;
+	daos_key_t	*pb_dkeys;
+	daos_iod_t	*pb_iods;
+	daos_recx_t	*pb_recxs;
+	d_sg_list_t	*pb_sgls;
+	d_iov_t		*pb_vals;
+	char		*pb_vbufs;
+};
+
+/*
+ * The batch being filled of each object. In asynchronous mode, a submitted
+ * batch is owned by the credit of the submission until the credit is taken
+ * again, the object gets the batch released by that credit in exchange.
+ */
+static struct pf_batch	**ts_batches;
+static struct pf_batch	**ts_cred_batches;
+static struct pf_batch	 *ts_batch_pool;
+static int		  ts_batch_pool_nr;
+
+static void
+batch_fini(void)
+{
+	struct pf_batch	*b;
+	int		 i;
+
+	if (ts_batch_pool == NULL)
+		return;
+
+	for (i = 0; i < ts_batch_pool_nr; i++) {
+		b = &ts_batch_pool[i];
+		D_FREE(b->pb_ios);
+		D_FREE(b->pb_dkeys);
+		D_FREE(b->pb_iods);
+		D_FREE(b->pb_recxs);
+		D_FREE(b->pb_sgls);
+		D_FREE(b->pb_vals);
+		D_FREE(b->pb_vbufs);
+	}
+	D_FREE(ts_batch_pool);
+	D_FREE(ts_batches);
+	D_FREE(ts_cred_batches);
+}
+
+static int
+batch_init(void)
+{
+	struct pf_batch	*b;
+	int		 i;
+
+	ts_batch_pool_nr = ts_obj_p_cont + ts_ctx.tsc_cred_nr;
+	D_ALLOC_ARRAY(ts_batch_pool, ts_batch_pool_nr);
+	D_ALLOC_ARRAY(ts_batches, ts_obj_p_cont);
+	D_ALLOC_ARRAY(ts_cred_batches, ts_ctx.tsc_cred_nr);
+	if (ts_batch_pool == NULL || ts_batches == NULL ||
+	    ts_cred_batches == NULL) {
+		batch_fini();
+		return -DER_NOMEM;
+	}
+
+	for (i = 0; i < ts_batch_pool_nr; i++) {
+		b = &ts_batch_pool[i];
+		D_ALLOC_ARRAY(b->pb_ios, ts_batch);
+		D_ALLOC_ARRAY(b->pb_dkeys, ts_batch);
+		D_ALLOC_ARRAY(b->pb_iods, ts_batch);
+		D_ALLOC_ARRAY(b->pb_recxs, ts_batch);
+		D_ALLOC_ARRAY(b->pb_sgls, ts_batch);
+		D_ALLOC_ARRAY(b->pb_vals, ts_batch);
+		D_ALLOC(b->pb_vbufs, (size_t)ts_batch * ts_stride);
+		if (b->pb_ios == NULL || b->pb_dkeys == NULL ||
+		    b->pb_iods == NULL || b->pb_recxs == NULL ||
+		    b->pb_sgls == NULL || b->pb_vals == NULL ||
+		    b->pb_vbufs == NULL) {
+			batch_fini();
+			return -DER_NOMEM;
+		}
+
+		if (i < ts_obj_p_cont)
+			ts_batches[i] = b;
+		else
+			ts_cred_batches[i - ts_obj_p_cont] = b;
+	}
+	return 0;
+}
+
+/*
+ * Submit the batch of the object with the credit in \a credp, which is
+ * consumed, or with a new credit if there is none.
+ */
+static int
+batch_flush(int obj_idx, struct io_credit **credp, double *duration)
+{
+	struct pf_batch		*b = ts_batches[obj_idx];
+	struct io_credit	*cred = NULL;
+	uint64_t		 start = 0;
+	int			 idx;
+	int			 rc;
+
+	if (b->pb_dkey_nr == 0)
+		return 0;
+
+	if (credp != NULL) {
+		cred = *credp;
+		*credp = NULL;
+	}
+	if (cred == NULL)
+		cred = credit_take(&ts_ctx);
+	if (cred == NULL) {
+		fprintf(stderr, "credit cannot be NULL for IO\n");
+		return -1;
+	}
+
+	if (cred->tc_evp != NULL) {
+		/* the batch of the previous submission of the credit is done */
+		idx = cred - ts_ctx.tsc_cred_buf;
+		ts_batches[obj_idx] = ts_cred_batches[idx];
+		ts_cred_batches[idx] = b;
+	}
+
+	if (!dts_is_async(&ts_ctx))
+		TS_TIME_START(duration, start);
+	rc = daos_obj_update_multi(ts_ohs[obj_idx], DAOS_TX_NONE, 0,
+				   b->pb_dkey_nr, b->pb_ios, cred->tc_evp);
+	if (!dts_is_async(&ts_ctx))
+		TS_TIME_END(duration, start);
+
+	b = ts_batches[obj_idx];
+	b->pb_dkey_nr = 0;
+	b->pb_io_nr = 0;
+	return rc;
+}
+
+static int
+batch_flush_all(struct pf_param *param)
+{
+	int	i;
+	int	rc = 0;
+	int	ret;
+
+	if (ts_batches == NULL)
+		return 0;
+
+	for (i = 0; i < ts_obj_p_cont; i++) {
+		ret = batch_flush(i, NULL, &param->pa_duration);
+		if (rc == 0)
+			rc = ret;
+	}
+	return rc;
+}
+
+/*
+ * Copy the update of the credit into the batch of the object. Updates against
+ * the same dkey are grouped together, the batch is submitted when it is full
+ * or when the update can't be packed into the same multi-dkey request. The
+ * first submission reuses the credit of the update, \a credp is set to NULL
+ * then.
+ */
+static int
+batch_add(int obj_idx, struct io_credit **credp, double *duration)
+{
+	struct io_credit *cred = *credp;
+	struct pf_batch	*b;
+	daos_dkey_io_t	*io = NULL;
+	daos_iod_t	*iod;
+	char		*vbuf;
+	unsigned int	 i;
+	int		 rc;
+
+	if (ts_batches == NULL) {
+		rc = batch_init();
+		if (rc)
+			return rc;
+	}
+
+	b = ts_batches[obj_idx];
+	if (b->pb_dkey_nr > 0) {
+		io = &b->pb_ios[b->pb_dkey_nr - 1];
+		if (daos_key_match(io->dio_dkey, &cred->tc_dkey)) {
+			for (i = 0; i < io->dio_nr; i++) {
+				if (daos_key_match(&io->dio_iods[i].iod_name,
+						   &cred->tc_iod.iod_name))
+					break;
+			}
+		} else {
+			for (i = 0; i < b->pb_dkey_nr - 1; i++) {
+				if (daos_key_match(b->pb_ios[i].dio_dkey,
+						   &cred->tc_dkey))
+					break;
+			}
+			io = NULL;
+		}
+
+		/* the same akey or dkey can only be packed once */
+		if ((io != NULL && i < io->dio_nr) ||
+		    (io == NULL && i < b->pb_dkey_nr - 1)) {
+			rc = batch_flush(obj_idx, credp, duration);
+			if (rc)
+				return rc;
+			b = ts_batches[obj_idx];
+			io = NULL;
+		}
+	}
+
+	if (io == NULL) {
+		io = &b->pb_ios[b->pb_dkey_nr];
+		b->pb_dkeys[b->pb_dkey_nr] = cred->tc_dkey;
+		io->dio_dkey = &b->pb_dkeys[b->pb_dkey_nr];
+		io->dio_nr = 0;
+		io->dio_iods = &b->pb_iods[b->pb_io_nr];
+		io->dio_sgls = &b->pb_sgls[b->pb_io_nr];
+		b->pb_dkey_nr++;
+	}
+
+	i = b->pb_io_nr;
+	vbuf = &b->pb_vbufs[(size_t)i * ts_stride];
+	memcpy(vbuf, cred->tc_vbuf, cred->tc_val.iov_len);
+
+	b->pb_recxs[i] = cred->tc_recx;
+	iod = &b->pb_iods[i];
+	*iod = cred->tc_iod;
+	iod->iod_recxs = &b->pb_recxs[i];
+	d_iov_set(&b->pb_vals[i], vbuf, cred->tc_val.iov_len);
+	b->pb_sgls[i].sg_iovs = &b->pb_vals[i];
+	b->pb_sgls[i].sg_nr = 1;
+	b->pb_sgls[i].sg_nr_out = 0;
+	io->dio_nr++;
+
+	if (++b->pb_io_nr == ts_batch)
+		return batch_flush(obj_idx, credp, duration);
+	return 0;
+}
 
 static int
 daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
@@ -41,6 +280,18 @@ daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
 	uint64_t      start = 0;
 	int	      rc;
 
+	/*
+	 * Verification needs the result of each I/O, don't batch it. There is
+	 * no multi-dkey fetch RPC, so only updates are batched.
+	 */
+	if (ts_batch > 1 && !sync && op_type == TS_DO_UPDATE) {
+		rc = batch_add(obj_idx, &cred, duration);
+		/* not consumed by a batch submission */
+		if (cred != NULL)
+			credit_return(&ts_ctx, cred);
+		return rc;
+	}
+
 	if (!dts_is_async(&ts_ctx))
 		TS_TIME_START(duration, start);
 	if (op_type == TS_DO_UPDATE) {
@@ -290,6 +541,10 @@ const char perf_daos_usage[] = "\n"
 "	Object class for DAOS full stack test.\n\n"
 "-g dmg_conf\n"
 "	dmg configuration file.\n\n"
+"-B number\n"
+"	Pack up to this number of updates of an object into one multi-dkey\n"
+"	update request, updates against the same dkey are grouped. Fetch and\n"
+"	verification I/Os are never batched. The default value is 0 (off).\n\n"
 "Examples:\n"
 "	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n";
 
@@ -309,10 +564,11 @@ const struct option perf_daos_opts[] = {
 	{ "credits",	required_argument,	NULL,	'C' },
 	{ "class",	required_argument,	NULL,	'c' },
 	{ "dmg_conf",	required_argument,	NULL,	'g' },
+	{ "batch",	required_argument,	NULL,	'B' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_daos_optstr[] = "T:C:c:g:";
+const char perf_daos_optstr[] = "T:C:c:g:B:";
 
 int
 main(int argc, char **argv)
@@ -381,6 +637,9 @@ main(int argc, char **argv)
 		case 'g':
 			dmg_conf = optarg;
 			break;
+		case 'B':
+			ts_batch = strtoul(optarg, &endp, 0);
+			break;
 		}
 	}
 
@@ -455,6 +714,8 @@ main(int argc, char **argv)
 	}
 
 	ts_update_or_fetch_fn = daos_update_or_fetch;
+	if (ts_batch > 1)
+		ts_flush_fn = batch_flush_all;
 
 	rc = dts_ctx_init(&ts_ctx, NULL);
 	if (rc)
@@ -476,7 +737,8 @@ main(int argc, char **argv)
 			"\takey_per_dkey : %u\n"
 			"\trecx_per_akey : %u\n"
 			"\tvalue type    : %s\n"
-			"\tstride size   : %u\n",
+			"\tstride size   : %u\n"
+			"\tbatch size    : %d\n",
 			pf_class2name(ts_class), uuid_buf,
 			(unsigned int)(ts_scm_size >> 20),
 			(unsigned int)(ts_nvme_size >> 20),
@@ -487,7 +749,8 @@ main(int argc, char **argv)
 			ts_akey_p_dkey,
 			ts_recx_p_akey,
 			ts_val_type(),
-			ts_stride);
+			ts_stride,
+			ts_batch);
 	}
 
 	rc = perf_alloc_keys();
@@ -503,6 +766,7 @@ main(int argc, char **argv)
 
 	if (ts_indices)
 		free(ts_indices);
+	batch_fini();
 	stride_buf_fini();
 	dts_ctx_fini(&ts_ctx);
 
@@ -61,9 +61,9 @@ static struct global {
 	CIRCLEQ_HEAD(, swim_target)	 target_list[MEMBERS_MAX];
 	struct swim_target		*target[MEMBERS_MAX];
 	struct swim_context		*swim_ctx[MEMBERS_MAX];
-	/* SWIM statistics: */
-	uint64_t			 detect_sec[MEMBERS_MAX];
-	uint64_t			 victim_sec;
+	/* SWIM statistics (in ms since victim selection): */
+	uint64_t			 detect_ms[MEMBERS_MAX];
+	uint64_t			 victim_ms;
 	uint64_t			 detect_min;
 	uint64_t			 detect_max;
 	/* SWIM control flags: */
@@ -156,8 +156,7 @@ static int test_set_member_state(struct swim_context *ctx,
 {
 	swim_id_t self_id = swim_self_get(ctx);
 	enum swim_member_status s;
-	struct timespec now;
-	uint64_t sec;
+	uint64_t ms;
 	int i, cnt, rc = 0;
 
 	if (self_id == SWIM_ID_INVALID)
@@ -173,18 +172,12 @@ static int test_set_member_state(struct swim_context *ctx,
 		break;
 	case SWIM_MEMBER_DEAD:
 		if (id == victim) {
-			rc = clock_gettime(CLOCK_MONOTONIC, &now);
-			if (!rc) {
-				g.detect_sec[self_id] = now.tv_sec;
-				sec = g.detect_sec[self_id] - g.victim_sec;
-				if (sec < g.detect_min)
-					g.detect_min = sec;
-				if (sec > g.detect_max)
-					g.detect_max = sec;
-			} else {
-				fprintf(stderr, "%lu: clock_gettime() "
-					"error %d\n", self_id, rc);
-			}
+			g.detect_ms[self_id] = swim_now_ms();
+			ms = g.detect_ms[self_id] - g.victim_ms;
+			if (ms < g.detect_min)
+				g.detect_min = ms;
+			if (ms > g.detect_max)
+				g.detect_max = ms;
 		} else if (self_id != victim) {
 			fprintf(stdout, "%lu: false DEAD %lu\n", self_id, id);
 			abort();
@@ -213,10 +206,35 @@ static int test_set_member_state(struct swim_context *ctx,
 	return rc;
 }
 
+static void test_stats_print(void)
+{
+	struct swim_stats total = { 0 };
+	struct swim_stats stats;
+	uint32_t lhm_max = 0;
+	int i;
+
+	for (i = 0; i < members_count; i++) {
+		swim_stats_get(g.swim_ctx[i], &stats);
+		total.ss_suspicions += stats.ss_suspicions;
+		total.ss_confirms   += stats.ss_confirms;
+		total.ss_refutes    += stats.ss_refutes;
+		total.ss_false_pos  += stats.ss_false_pos;
+		total.ss_deaths     += stats.ss_deaths;
+		if (stats.ss_lhm > lhm_max)
+			lhm_max = stats.ss_lhm;
+	}
+
+	fprintf(stderr, "suspicions %lu confirms %lu refutes %lu "
+		"false positives %lu deaths %lu max local health %u\n",
+		total.ss_suspicions, total.ss_confirms, total.ss_refutes,
+		total.ss_false_pos, total.ss_deaths, lhm_max);
+	fprintf(stderr, "packets sent %zu delivered %zu glitched %zu\n",
+		pkt_sent, pkt_total, pkt_glitch);
+}
+
 int test_run(void)
 {
 	enum swim_member_status s;
-	struct timespec now;
 	uint64_t time = swim_now_ms();
 	int i, j, cs, cd, tick, rc = 0;
 
@@ -282,26 +300,23 @@ int test_run(void)
 			fflush(stdout);
 		}
 
-		if (victim == SWIM_ID_INVALID && !g.victim_sec && tick > 0) {
-			rc = clock_gettime(CLOCK_MONOTONIC, &now);
-			if (!rc) {
-				victim = rand() % members_count;
-				g.victim_sec = now.tv_sec;
+		if (victim == SWIM_ID_INVALID && !g.victim_ms && tick > 0) {
+			victim = rand() % members_count;
+			g.victim_ms = swim_now_ms();
 
-				fprintf(stdout, "%3d. *** VICTIM %lu ***\n",
-					tick, victim);
-				fflush(stdout);
-			} else {
-				fprintf(stderr, "clock_gettime() rc=%d\n", rc);
-			}
+			fprintf(stdout, "%3d. *** VICTIM %lu ***\n",
+				tick, victim);
+			fflush(stdout);
 		}
 		usleep(1000);
 	}
 	g.shutdown = 1;
 
 	fprintf(stderr, "\nWith %zu members failure was detected after:\n"
-		"min %lu sec max %lu sec\n",
-		members_count, g.detect_min, g.detect_max);
+		"min %lu.%03lu sec max %lu.%03lu sec (convergence)\n",
+		members_count, g.detect_min / 1000, g.detect_min % 1000,
+		g.detect_max / 1000, g.detect_max % 1000);
+	test_stats_print();
 
 	return rc;
 }
@@ -532,6 +547,7 @@ int test_init(void)
 			fprintf(stderr, "swim_init() failed\n");
 			goto out;
 		}
+		swim_members_count_set(g.swim_ctx[i], members_count);
 	}
 
 	rc = D_SPIN_INIT(&g.lock, PTHREAD_PROCESS_PRIVATE);
@@ -167,6 +167,102 @@ test_hlc_epsilon(void **state)
 	assert_true(crt_hlc_epsilon_get_bound(hlc2) <= ((pt1 + mask) | mask));
 }
 
+static void
+test_hlc_uncertainty(void **state)
+{
+	uint64_t eps = 1ULL << 30;
+	uint64_t hlc = crt_hlc_get();
+
+	/*
+	 * Without any peer HLC offset sample (CaRT is not even initialized),
+	 * the uncertainty window shall be the maximum system clock offset.
+	 */
+	crt_hlc_epsilon_set(eps);
+	assert_true(crt_hlc_uncertainty_get() == crt_hlc_epsilon_get());
+	assert_true(crt_hlc_uncertainty_get_bound(hlc) ==
+		    crt_hlc_epsilon_get_bound(hlc));
+
+	/* The window shall follow the new maximum system clock offset. */
+	crt_hlc_epsilon_set(eps * 2);
+	assert_true(crt_hlc_uncertainty_get() == crt_hlc_epsilon_get());
+}
+
+static void
+test_hlc_window(void **state)
+{
+	d_rank_t	ranks[] = {0, 1, 2};
+	d_rank_list_t	membs = { .rl_ranks = ranks, .rl_nr = 3 };
+	uint64_t	unit = 1ULL << 18;	/* internal physical resolution */
+	uint64_t	age = 10ULL * 1000 * 1000 * 1000 * 16;	/* 10 s */
+	uint64_t	now = crt_hlc_get();
+	uint64_t	window;
+
+	crt_hlc_epsilon_set(1ULL << 34);
+
+	/* Rank 0 is self, rank 2 has no sample yet. */
+	crt_hlc_peer_sample(1, now - 8 * unit, now - 7 * unit, now - 6 * unit);
+	window = crt_hlc_window_calc(&membs, 0, now, age);
+	assert_true(window == crt_hlc_epsilon_get());
+
+	/*
+	 * With every peer sampled, the window shall be the max ahead plus the
+	 * max behind offset (rank 2: 3 units, rank 1: 1 unit), plus the drift
+	 * allowance since the samples are taken, rounded up.
+	 */
+	crt_hlc_peer_sample(2, now - 4 * unit, now - unit, now);
+	window = crt_hlc_window_calc(&membs, 0, now, age);
+	print_message("window: "DF_U64"\n", window);
+	assert_true(window == 5 * unit);
+
+	/*
+	 * A newer sample shall replace the older one of the same peer. Both
+	 * peers are 1 unit ahead and behind now, plus rank 1's drift allowance.
+	 */
+	crt_hlc_peer_sample(2, now - 2 * unit, now - unit, now);
+	window = crt_hlc_window_calc(&membs, 0, now, age);
+	assert_true(window == 3 * unit);
+
+	/* The window shall never exceed the maximum system clock offset. */
+	crt_hlc_epsilon_set(unit);
+	window = crt_hlc_window_calc(&membs, 0, now, age);
+	assert_true(window == crt_hlc_epsilon_get());
+	crt_hlc_epsilon_set(1ULL << 34);
+}
+
+static void
+test_hlc_window_drift(void **state)
+{
+	d_rank_t	ranks[] = {3, 4};
+	d_rank_list_t	membs = { .rl_ranks = ranks, .rl_nr = 2 };
+	uint64_t	unit = 1ULL << 18;
+	uint64_t	age = 10ULL * 1000 * 1000 * 1000 * 16;	/* 10 s */
+	uint64_t	now = crt_hlc_get();
+	uint64_t	window;
+	uint64_t	later;
+
+	crt_hlc_epsilon_set(1ULL << 34);
+
+	crt_hlc_peer_sample(4, now - 2 * unit, now - unit, now);
+	window = crt_hlc_window_calc(&membs, 3, now, age);
+	assert_true(window == 2 * unit);
+
+	/* Each offset grows by 1/10000 of the sample age, i.e., 100 ppm. */
+	later = crt_hlc_window_calc(&membs, 3, now + age / 2, age);
+	print_message("window: "DF_U64" -> "DF_U64"\n", window, later);
+	assert_true(later ==
+		    ((2 * unit + 2 * (age / 2 / 10000) + unit - 1) &
+		     ~(unit - 1)));
+	assert_true(later > window);
+
+	/* A sample older than the age limit shall not be trusted. */
+	later = crt_hlc_window_calc(&membs, 3, now + age + 1, age);
+	assert_true(later == crt_hlc_epsilon_get());
+
+	/* The same sample shall be trusted with a larger age limit. */
+	later = crt_hlc_window_calc(&membs, 3, now + age + 1, age * 2);
+	assert_true(later < crt_hlc_epsilon_get());
+}
+
 static int
 init_tests(void **state)
 {
@@ -193,6 +289,9 @@ int main(int argc, char **argv)
 		cmocka_unit_test(test_hlc_get_msg),
 		cmocka_unit_test(test_hlc_conversion),
 		cmocka_unit_test(test_hlc_epsilon),
+		cmocka_unit_test(test_hlc_uncertainty),
+		cmocka_unit_test(test_hlc_window),
+		cmocka_unit_test(test_hlc_window_drift),
 	};
 
 	d_register_alt_assert(mock_assert);
@@ -52,6 +52,7 @@ uint64_t	*ts_indices;
 
 struct credit_context	ts_ctx;
 pf_update_or_fetch_fn_t	ts_update_or_fetch_fn;
+pf_flush_fn_t		ts_flush_fn;
 
 /* buffer for data verification */
 struct pf_stride_buf {
@@ -331,6 +332,11 @@ objects_update(struct pf_param *param)
 		if (rc)
 			break;
 	}
+	if (ts_flush_fn != NULL) {
+		rc_drain = ts_flush_fn(param);
+		if (rc == 0)
+			rc = rc_drain;
+	}
 	rc_drain = credit_drain(&ts_ctx);
 	if (rc == 0)
 		rc = rc_drain;
@@ -359,6 +365,11 @@ objects_fetch(struct pf_param *param)
 		if (rc != 0)
 			break;
 	}
+	if (ts_flush_fn != NULL) {
+		rc_drain = ts_flush_fn(param);
+		if (rc == 0)
+			rc = rc_drain;
+	}
 	rc_drain = credit_drain(&ts_ctx);
 	if (rc == 0)
 		rc = rc_drain;
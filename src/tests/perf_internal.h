@@ -72,6 +72,7 @@ typedef int (*pf_update_or_fetch_fn_t)(int, enum ts_op_type,
 				       struct io_credit *, daos_epoch_t,
 				       bool, double *);
 typedef int (*pf_parse_cb_t)(char *, struct pf_param *, char **);
+typedef int (*pf_flush_fn_t)(struct pf_param *);
 
 struct pf_test {
 	/* identifier of test */
@@ -108,6 +109,8 @@ extern uint64_t		*ts_indices;
 
 extern struct credit_context	ts_ctx;
 extern pf_update_or_fetch_fn_t	ts_update_or_fetch_fn;
+/* submit the I/Os buffered by ts_update_or_fetch_fn, optional */
+extern pf_flush_fn_t		ts_flush_fn;
 
 #define TS_TIME_START(time, start)		\
 do {						\
@@ -18,6 +18,7 @@
 #define	DTX_TEST_SUB_REQS	32
 #define DTX_IO_SMALL		32
 #define DTX_NC_CNT		10
+#define DTX_BATCH_CNT		16
 
 D_CASSERT(DTX_NC_CNT % IOREQ_SG_IOD_NR == 0);
 
@@ -582,7 +583,9 @@ dtx_14(void **state)
 	daos_handle_t	 th = { 0 };
 	daos_obj_id_t	 oid;
 	struct ioreq	 req;
+	struct daos_tx_stats stats;
 	int		 nrestarts = 13;
+	int		 total = nrestarts;
 	int		 rc;
 
 	FAULT_INJECTION_REQUIRED();
@@ -634,6 +637,17 @@ again:
 
 	MUST(daos_tx_commit(th, NULL));
 
+	/* The statistics are kept across the restarts. */
+	MUST(daos_tx_hdl2stats(th, &stats));
+	print_message("restarts %u, IO conflicts %u, commit conflicts %u, "
+		      "pool map changes %u\n", stats.ts_restarts,
+		      stats.ts_io_conflicts, stats.ts_commit_conflicts,
+		      stats.ts_pm_changes);
+	assert_int_equal(stats.ts_restarts, total);
+	assert_int_equal(stats.ts_commit_conflicts, total);
+	assert_int_equal(stats.ts_io_conflicts, 0);
+	assert_int_equal(stats.ts_pm_changes, 0);
+
 	lookup_single(dkey, akey, 0, fetch_buf, DTX_IO_SMALL,
 		      DAOS_TX_NONE, &req);
 	assert_memory_equal(write_buf, fetch_buf, DTX_IO_SMALL);
@@ -653,6 +667,7 @@ dtx_15(void **state)
 	daos_handle_t	 th = { 0 };
 	daos_obj_id_t	 oid;
 	struct ioreq	 req;
+	struct daos_tx_stats stats;
 
 	FAULT_INJECTION_REQUIRED();
 
@@ -694,6 +709,11 @@ dtx_15(void **state)
 
 	MUST(daos_tx_commit(th, NULL));
 
+	MUST(daos_tx_hdl2stats(th, &stats));
+	assert_int_equal(stats.ts_restarts, 1);
+	assert_true(stats.ts_pm_changes >= 1);
+	assert_int_equal(stats.ts_commit_conflicts, 0);
+
 	ioreq_fini(&req);
 	MUST(daos_tx_close(th, NULL));
 }
@@ -3009,6 +3029,178 @@ dtx_41(void **state)
 	dtx_uncertainty_miss_request(*state, DAOS_DTX_MISS_ABORT, true, true);
 }
 
+static void
+dtx_42(void **state)
+{
+	test_arg_t	*arg = *state;
+	const char	*akey = dts_dtx_akey;
+	daos_handle_t	 ths[DTX_BATCH_CNT];
+	daos_event_t	 evs[DTX_BATCH_CNT];
+	int		 rcs[DTX_BATCH_CNT];
+	char		 dkey[32];
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint64_t	 val;
+	bool		 ev_flag;
+	int		 failed = 0;
+	int		 i;
+	int		 rc;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("DTX42: coalesced CPD RPCs - independent DTX results\n");
+
+	if (!test_runable(arg, 2))
+		skip();
+
+	arg->async = 0;
+	/* All the DTXs share the same leader and follower targets. */
+	oid = daos_test_oid_gen(arg->coh, OC_RP_2G1, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/*
+	 * Coalesce up to DTX_BATCH_CNT dispatches to the same follower, the
+	 * follower fails the first DTX of each coalesced CPD RPC.
+	 */
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank == 0) {
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_VALUE,
+				      DTX_BATCH_CNT, 0, NULL);
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC,
+				      DAOS_DTX_CPD_BATCH | DAOS_FAIL_ALWAYS,
+				      0, NULL);
+	}
+	par_barrier(PAR_COMM_WORLD);
+
+	for (i = 0; i < DTX_BATCH_CNT; i++) {
+		MUST(daos_tx_open(arg->coh, &ths[i], 0, NULL));
+
+		sprintf(dkey, "batch_dkey_%d", i);
+		val = i + 1;
+		insert_single(dkey, akey, 0, &val, sizeof(val), ths[i], &req);
+
+		rc = daos_event_init(&evs[i], arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+	}
+
+	/* Commit all of them concurrently to let the leader coalesce them. */
+	for (i = 0; i < DTX_BATCH_CNT; i++) {
+		rc = daos_tx_commit(ths[i], &evs[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < DTX_BATCH_CNT; i++) {
+		rc = daos_event_test(&evs[i], DAOS_EQ_WAIT, &ev_flag);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(ev_flag, true);
+
+		rcs[i] = evs[i].ev_error;
+		if (rcs[i] != 0) {
+			assert_rc_equal(rcs[i], -DER_IO);
+			failed++;
+		}
+
+		MUST(daos_event_fini(&evs[i]));
+		MUST(daos_tx_close(ths[i], NULL));
+	}
+
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank == 0) {
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC, 0,
+				      0, NULL);
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_VALUE, 0,
+				      0, NULL);
+	}
+	par_barrier(PAR_COMM_WORLD);
+
+	print_message("%d of %d DTXs failed in coalesced CPD RPCs\n",
+		      failed, DTX_BATCH_CNT);
+
+	/*
+	 * A coalesced CPD RPC carries at least two DTXs, one fails. At least
+	 * one DTX must fail, otherwise nothing has been coalesced at all.
+	 */
+	assert_true(failed <= DTX_BATCH_CNT / 2);
+	assert_true(failed >= 1);
+
+	/* Each DTX is either fully applied or not at all. */
+	for (i = 0; i < DTX_BATCH_CNT; i++) {
+		sprintf(dkey, "batch_dkey_%d", i);
+		val = 0;
+		lookup_single(dkey, akey, 0, &val, sizeof(val), DAOS_TX_NONE,
+			      &req);
+		if (rcs[i] == 0)
+			assert_int_equal(val, i + 1);
+		else
+			assert_int_equal(val, 0);
+	}
+
+	ioreq_fini(&req);
+}
+
+static void
+dtx_rdonly_commit(test_arg_t *arg, daos_oclass_id_t oclass, int expected)
+{
+	const char	*dkey = dts_dtx_dkey;
+	const char	*akey = dts_dtx_akey;
+	daos_handle_t	 th = { 0 };
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	uint64_t	 val = 1;
+	int		 rc;
+
+	oid = daos_test_oid_gen(arg->coh, oclass, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+	insert_single(dkey, akey, 0, &val, sizeof(val), DAOS_TX_NONE, &req);
+
+	MUST(daos_tx_open(arg->coh, &th, 0, NULL));
+	val = 0;
+	lookup_single(dkey, akey, 0, &val, sizeof(val), th, &req);
+	assert_int_equal(val, 1);
+
+	/* Any CPD RPC for the commit fails with -DER_TX_RESTART. */
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC,
+				      DAOS_DTX_RESTART | DAOS_FAIL_ALWAYS,
+				      0, NULL);
+	par_barrier(PAR_COMM_WORLD);
+
+	rc = daos_tx_commit(th, NULL);
+	assert_rc_equal(rc, expected);
+
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC, 0,
+				      0, NULL);
+	par_barrier(PAR_COMM_WORLD);
+
+	MUST(daos_tx_close(th, NULL));
+	ioreq_fini(&req);
+}
+
+static void
+dtx_43(void **state)
+{
+	test_arg_t	*arg = *state;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("DTX43: read-only TX commit without CPD RPC\n");
+
+	if (!test_runable(arg, 2))
+		skip();
+
+	arg->async = 0;
+
+	print_message("read-only TX against object without redundancy\n");
+	dtx_rdonly_commit(arg, OC_S1, 0);
+
+	/* The read TS has to be spread to the other replicas via CPD RPC. */
+	print_message("read-only TX against replicated object\n");
+	dtx_rdonly_commit(arg, OC_RP_2G1, -DER_TX_RESTART);
+}
+
 static test_arg_t *saved_dtx_arg;
 
 static int
@@ -3123,6 +3315,10 @@ static const struct CMUnitTest dtx_tests[] = {
 	 dtx_40, NULL, test_case_teardown},
 	{"DTX41: uncertain check - miss abort with delay",
 	 dtx_41, NULL, test_case_teardown},
+	{"DTX42: coalesced CPD RPCs - independent DTX results",
+	 dtx_42, NULL, test_case_teardown},
+	{"DTX43: read-only TX commit without CPD RPC",
+	 dtx_43, NULL, test_case_teardown},
 };
 
 static int
@@ -335,6 +335,110 @@ kv_cond_ops(void **state)
 	print_message("all good\n");
 } /* End simple_put_get */
 
+static void
+kv_cache_rw(void **state)
+{
+	test_arg_t			*arg = *state;
+	struct daos_kv_cache_stats	 stats;
+	daos_obj_id_t			 oid;
+	daos_handle_t			 coh;
+	daos_handle_t			 oh;
+	daos_handle_t			 oh2;
+	int				 val, val_out;
+	size_t				 size;
+	int				 i;
+	int				 rc;
+
+	/* The cache is set up when the container handle is opened. */
+	print_message("Open a container handle with the KV cache\n");
+	setenv("DAOS_KV_CACHE_MB", "1", 1);
+	setenv("DAOS_KV_CACHE_LEASE_MS", "1000", 1);
+	rc = daos_cont_open(arg->pool.poh, arg->co_str, DAOS_COO_RW, &coh,
+			    NULL, NULL);
+	unsetenv("DAOS_KV_CACHE_MB");
+	unsetenv("DAOS_KV_CACHE_LEASE_MS");
+	assert_rc_equal(rc, 0);
+
+	oid = daos_test_oid_gen(coh, OC_SX, type, 0, arg->myrank);
+
+	rc = daos_kv_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("Reread overwritten Key\n");
+	for (i = 0; i < 10; i++) {
+		val = i;
+		rc = daos_kv_put(oh, DAOS_TX_NONE, 0, "Key1", sizeof(int), &val,
+				 NULL);
+		assert_rc_equal(rc, 0);
+
+		size = sizeof(int);
+		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, "Key1", &size, &val_out,
+				 NULL);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(size, sizeof(int));
+		assert_int_equal(val_out, i);
+
+		size = 0;
+		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, "Key1", &size, NULL,
+				 NULL);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(size, sizeof(int));
+	}
+
+	rc = daos_kv_cache_query(coh, &stats);
+	assert_rc_equal(rc, 0);
+	print_message("KV cache hits "DF_U64" misses "DF_U64"\n",
+		      stats.kcs_hits, stats.kcs_misses);
+	assert_true(stats.kcs_hits > 0);
+	assert_int_equal(stats.kcs_entries, 1);
+
+	print_message("Reread removed Key\n");
+	rc = daos_kv_remove(oh, DAOS_TX_NONE, 0, "Key1", NULL);
+	assert_rc_equal(rc, 0);
+
+	size = 0;
+	rc = daos_kv_get(oh, DAOS_TX_NONE, 0, "Key1", &size, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, 0);
+
+	rc = daos_kv_cache_query(coh, &stats);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stats.kcs_entries, 0);
+
+	print_message("Reread Key overwritten through another handle\n");
+	val = 1;
+	rc = daos_kv_put(oh, DAOS_TX_NONE, 0, "Key2", sizeof(int), &val, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_kv_open(arg->coh, oid, DAOS_OO_RW, &oh2, NULL);
+	assert_rc_equal(rc, 0);
+	val = 2;
+	rc = daos_kv_put(oh2, DAOS_TX_NONE, 0, "Key2", sizeof(int), &val, NULL);
+	assert_rc_equal(rc, 0);
+
+	/* The write of the other handle is seen once the lease expires. */
+	sleep(2);
+	size = sizeof(int);
+	rc = daos_kv_get(oh, DAOS_TX_NONE, 0, "Key2", &size, &val_out, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(size, sizeof(int));
+	assert_int_equal(val_out, 2);
+
+	rc = daos_kv_close(oh2, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_kv_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_kv_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("all good\n");
+}
+
 static const struct CMUnitTest kv_tests[] = {
 	{"KV: Object Put/GET (blocking)",
 	 simple_put_get, async_disable, NULL},
@@ -344,6 +448,8 @@ static const struct CMUnitTest kv_tests[] = {
 	 simple_put_get, async_enable, NULL},
 	{"KV: Object Conditional Ops (blocking)",
 	 kv_cond_ops, async_disable, NULL},
+	{"KV: Reread own writes (blocking)",
+	 kv_cache_rw, async_disable, NULL},
 };
 
 int
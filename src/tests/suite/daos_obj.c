@@ -4736,6 +4736,131 @@ io_tx_convert(void **state)
 	ioreq_fini(&req);
 }
 
+#define MULTI_DKEY_NR	24
+
+static void
+io_multi_dkey_update(test_arg_t *arg, daos_handle_t oh, daos_dkey_io_t *ios)
+{
+	daos_event_t	ev;
+	daos_event_t	*evp = arg->async ? &ev : NULL;
+	bool		ev_flag;
+	int		rc;
+
+	if (evp != NULL) {
+		rc = daos_event_init(evp, arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+	}
+
+	rc = daos_obj_update_multi(oh, DAOS_TX_NONE, 0, MULTI_DKEY_NR, ios,
+				   evp);
+	if (evp != NULL) {
+		assert_rc_equal(rc, 0);
+		rc = daos_event_test(evp, DAOS_EQ_WAIT, &ev_flag);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(ev_flag, true);
+		rc = evp->ev_error;
+		daos_event_fini(evp);
+	}
+	assert_rc_equal(rc, 0);
+}
+
+static void
+io_multi_dkey(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	 oid;
+	daos_handle_t	 oh;
+	daos_dkey_io_t	 ios[MULTI_DKEY_NR];
+	daos_key_t	 dkeys[MULTI_DKEY_NR];
+	daos_iod_t	 iods[MULTI_DKEY_NR][2];
+	daos_recx_t	 recxs[MULTI_DKEY_NR];
+	d_sg_list_t	 sgls[MULTI_DKEY_NR][2];
+	d_iov_t		 iovs[MULTI_DKEY_NR][2];
+	char		 dkey_bufs[MULTI_DKEY_NR][32];
+	char		 sv_bufs[MULTI_DKEY_NR][32];
+	char		 ar_bufs[MULTI_DKEY_NR][IO_SIZE_SCM];
+	char		 akey_sv[] = "multi_sv";
+	char		 akey_ar[] = "multi_ar";
+	char		 buf[IO_SIZE_SCM];
+	int		 i;
+	int		 rc;
+
+	oid = daos_test_oid_gen(arg->coh, dts_obj_class, 0, 0, arg->myrank);
+	rc = daos_obj_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < MULTI_DKEY_NR; i++) {
+		snprintf(dkey_bufs[i], sizeof(dkey_bufs[i]), "multi_dkey_%d", i);
+		d_iov_set(&dkeys[i], dkey_bufs[i], strlen(dkey_bufs[i]));
+		snprintf(sv_bufs[i], sizeof(sv_bufs[i]), "single_value_%d", i);
+		memset(ar_bufs[i], 'a' + i % 26, sizeof(ar_bufs[i]));
+
+		d_iov_set(&iods[i][0].iod_name, akey_sv, strlen(akey_sv));
+		iods[i][0].iod_type = DAOS_IOD_SINGLE;
+		iods[i][0].iod_size = sizeof(sv_bufs[i]);
+		iods[i][0].iod_nr = 1;
+		iods[i][0].iod_recxs = NULL;
+		iods[i][0].iod_flags = 0;
+
+		recxs[i].rx_idx = 0;
+		recxs[i].rx_nr = sizeof(ar_bufs[i]);
+		d_iov_set(&iods[i][1].iod_name, akey_ar, strlen(akey_ar));
+		iods[i][1].iod_type = DAOS_IOD_ARRAY;
+		iods[i][1].iod_size = 1;
+		iods[i][1].iod_nr = 1;
+		iods[i][1].iod_recxs = &recxs[i];
+		iods[i][1].iod_flags = 0;
+
+		d_iov_set(&iovs[i][0], sv_bufs[i], sizeof(sv_bufs[i]));
+		d_iov_set(&iovs[i][1], ar_bufs[i], sizeof(ar_bufs[i]));
+		sgls[i][0].sg_nr = 1;
+		sgls[i][0].sg_nr_out = 0;
+		sgls[i][0].sg_iovs = &iovs[i][0];
+		sgls[i][1].sg_nr = 1;
+		sgls[i][1].sg_nr_out = 0;
+		sgls[i][1].sg_iovs = &iovs[i][1];
+
+		ios[i].dio_dkey = &dkeys[i];
+		ios[i].dio_nr = 2;
+		ios[i].dio_iods = iods[i];
+		ios[i].dio_sgls = sgls[i];
+	}
+
+	print_message("Update %d dkeys with one multi-dkey update\n",
+		      MULTI_DKEY_NR);
+	io_multi_dkey_update(arg, oh, ios);
+
+	print_message("Verify each dkey with regular fetch\n");
+	for (i = 0; i < MULTI_DKEY_NR; i++) {
+		memset(sv_bufs[i], 0, sizeof(sv_bufs[i]));
+		memset(ar_bufs[i], 0, sizeof(ar_bufs[i]));
+		rc = daos_obj_fetch(oh, DAOS_TX_NONE, 0, &dkeys[i], 2,
+				    iods[i], sgls[i], NULL, NULL);
+		assert_rc_equal(rc, 0);
+
+		snprintf(buf, sizeof(sv_bufs[i]), "single_value_%d", i);
+		assert_string_equal(sv_bufs[i], buf);
+		assert_int_equal(iods[i][0].iod_size, sizeof(sv_bufs[i]));
+		memset(buf, 'a' + i % 26, sizeof(buf));
+		assert_memory_equal(ar_bufs[i], buf, sizeof(buf));
+	}
+
+	print_message("Conditional insert of existing dkeys should fail\n");
+	rc = daos_obj_update_multi(oh, DAOS_TX_NONE, DAOS_COND_DKEY_INSERT,
+				   MULTI_DKEY_NR, ios, NULL);
+	assert_rc_equal(rc, -DER_EXIST);
+
+	print_message("Invalid multi-dkey parameters\n");
+	rc = daos_obj_update_multi(oh, DAOS_TX_NONE, 0, 0, ios, NULL);
+	assert_rc_equal(rc, -DER_INVAL);
+	rc = daos_obj_update_multi(oh, DAOS_TX_NONE, 0, MULTI_DKEY_NR, NULL,
+				   NULL);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+}
+
 static const struct CMUnitTest io_tests[] = {
 	{ "IO1: simple update/fetch/verify",
 	  io_simple, async_disable, test_case_teardown},
@@ -4831,6 +4956,10 @@ static const struct CMUnitTest io_tests[] = {
 	  enum_recxs_with_aggregation, async_disable, test_case_teardown},
 	{ "IO46: tx convert",
 	  io_tx_convert, async_disable, test_case_teardown},
+	{ "IO47: multi-dkey update",
+	  io_multi_dkey, async_disable, test_case_teardown},
+	{ "IO48: multi-dkey update (async)",
+	  io_multi_dkey, async_enable, test_case_teardown},
 };
 
 int
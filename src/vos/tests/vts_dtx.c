@@ -854,6 +854,187 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+/* Committed DTX entries across multiple DRAM slabs */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct vos_container		*cont;
+	struct dtx_id			*xid;
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	uint64_t			 start;
+	uint32_t			 shift;
+	int				 count = 0;
+	int				 rc;
+	int				 i;
+
+	/* Grow up to two max slabs, but still in the same committed DTX blob. */
+	for (shift = DTX_CMT_SLAB_MIN_SHIFT; shift < DTX_CMT_SLAB_MAX_SHIFT; shift++)
+		count += vos_dtx_cmt_slab_cap(shift);
+	count += vos_dtx_cmt_slab_cap(DTX_CMT_SLAB_MAX_SHIFT) * 2 + 100;
+	D_ALLOC_ARRAY(xid, count);
+	assert_non_null(xid);
+
+	for (i = 0; i < count; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+
+		xid[i] = dth->dth_xid;
+
+		vts_dtx_end(dth);
+	}
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+
+	/* A single commit only takes the smallest slab. */
+	rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[0], 1, NULL);
+	assert_rc_equal(rc, 1);
+	assert_non_null(cont->vc_dtx_cmt_slab);
+	assert_int_equal(cont->vc_dtx_cmt_slab->dcs_shift, DTX_CMT_SLAB_MIN_SHIFT);
+
+	/* Commit the DTXs in batch as the DTX batched commit does. */
+	start = daos_get_ntime();
+	for (i = 1; i < count; i += DTX_THRESHOLD_COUNT) {
+		int	nr = min(count - i, DTX_THRESHOLD_COUNT);
+
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[i], nr, NULL);
+		assert_rc_equal(rc, nr);
+	}
+	print_message("Committed %d DTXs, %lu ns per DTX\n", count - 1,
+		      (daos_get_ntime() - start) / (count - 1));
+
+	/* The slabs have grown up to the max size. */
+	assert_int_equal(cont->vc_dtx_cmt_slab->dcs_shift, DTX_CMT_SLAB_MAX_SHIFT);
+
+	for (i = 0; i < count; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, NULL);
+		assert_rc_equal(rc, DTX_ST_COMMITTED);
+	}
+
+	/* Aggregate the DTXs, all the slabs will be released. */
+	rc = vos_dtx_aggregate(args->ctx.tc_co_hdl);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < count; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, NULL);
+		assert_rc_equal(rc, -DER_NONEXIST);
+	}
+
+	D_FREE(xid);
+}
+
+#define DTX_TEST_ACT_QUOTA	8
+
+/* Active DTX entries beyond the per-container quota are refused */
+static void
+dtx_20(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct vos_container		*cont;
+	struct vos_pool			*pool;
+	struct dtx_id			 xid[DTX_TEST_ACT_QUOTA + 1];
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	unsigned int			 quota = vos_dtx_act_quota;
+	int				 rc;
+	int				 i;
+
+	cont = vos_hdl2cont(args->ctx.tc_co_hdl);
+	pool = vos_hdl2pool(args->ctx.tc_po_hdl);
+	assert_int_equal(pool->vp_dtx_act_count, 0);
+
+	vos_dtx_act_quota = DTX_TEST_ACT_QUOTA;
+
+	for (i = 0; i <= DTX_TEST_ACT_QUOTA; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, false);
+		xid[i] = dth->dth_xid;
+		vts_dtx_end(dth);
+
+		if (i < DTX_TEST_ACT_QUOTA) {
+			assert_rc_equal(rc, 0);
+			continue;
+		}
+
+		/* Quota reached, refused until some DTX is committed. */
+		assert_rc_equal(rc, -DER_INPROGRESS);
+		assert_int_equal(cont->vc_dtx_act_count, DTX_TEST_ACT_QUOTA);
+		assert_int_equal(pool->vp_dtx_act_count, DTX_TEST_ACT_QUOTA);
+
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[0], 1, NULL);
+		assert_rc_equal(rc, 1);
+		assert_int_equal(cont->vc_dtx_act_count,
+				 DTX_TEST_ACT_QUOTA - 1);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+		xid[i] = dth->dth_xid;
+		vts_dtx_end(dth);
+	}
+
+	assert_int_equal(pool->vp_dtx_act_count, DTX_TEST_ACT_QUOTA);
+
+	rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[1], DTX_TEST_ACT_QUOTA,
+			    NULL);
+	assert_rc_equal(rc, DTX_TEST_ACT_QUOTA);
+
+	assert_int_equal(cont->vc_dtx_act_count, 0);
+	assert_int_equal(pool->vp_dtx_act_count, 0);
+
+	for (i = 0; i <= DTX_TEST_ACT_QUOTA; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL,
+				   NULL, NULL);
+		assert_rc_equal(rc, DTX_ST_COMMITTED);
+	}
+
+	vos_dtx_act_quota = quota;
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -888,6 +1069,10 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: committed DTX entries across multiple slabs",
+	  dtx_19, NULL, dtx_tst_teardown },
+	{ "VOS520: active DTX quota per container",
+	  dtx_20, NULL, dtx_tst_teardown },
 };
 
 int
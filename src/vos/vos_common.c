@@ -489,6 +489,13 @@ vos_mod_init(void)
 	D_INFO("Set aggregate NVMe record threshold to %u blocks (blk_sz:%lu).\n",
 	       vos_agg_nvme_thresh, VOS_BLK_SZ);
 
+	d_getenv_int("DAOS_DTX_ACT_QUOTA", &vos_dtx_act_quota);
+	if (vos_dtx_act_quota < DTX_ACT_QUOTA_MIN || vos_dtx_act_quota > DTX_ARRAY_LEN)
+		vos_dtx_act_quota = DTX_ACT_QUOTA_DEF;
+
+	D_INFO("Set per-container active DTX entries quota to %u\n",
+	       vos_dtx_act_quota);
+
 	return rc;
 }
 
@@ -18,6 +18,11 @@
 
 /* 128 KB per SCM blob */
 #define DTX_BLOB_SIZE		(1 << 17)
+/* SCM slot and DRAM lru entry consumed by one active DTX, not including
+ * the out-of-line records and memberships.
+ */
+#define DTX_ACT_ENT_SIZE	(sizeof(struct vos_dtx_act_ent_df) +	\
+				 sizeof(struct vos_dtx_act_ent))
 /** Ensure 16-bit signed int is sufficient to store record index */
 D_CASSERT((DTX_BLOB_SIZE / sizeof(struct vos_dtx_act_ent_df)) <  (1 << 15));
 D_CASSERT((DTX_BLOB_SIZE / sizeof(struct vos_dtx_cmt_ent_df)) <  (1 << 15));
@@ -34,6 +39,9 @@ enum {
 #define DTX_UMOFF_TYPES		(DTX_UMOFF_ILOG | DTX_UMOFF_SVT | DTX_UMOFF_EVT)
 #define DTX_INDEX_INVAL		(int32_t)(-1)
 
+/* The max count of active DTX entries per container. */
+unsigned int vos_dtx_act_quota = DTX_ACT_QUOTA_DEF;
+
 #define dtx_evict_lid(cont, dae)					\
 	do {								\
 		if (dae->dae_dth != NULL &&				\
@@ -43,7 +51,11 @@ enum {
 		}							\
 		D_DEBUG(DB_TRACE, "Evicting lid "DF_DTI": lid=%d\n",	\
 			DP_DTI(&DAE_XID(dae)), DAE_LID(dae));		\
-		d_list_del_init(&dae->dae_link);			\
+		if (!d_list_empty(&dae->dae_link)) {			\
+			d_list_del_init(&dae->dae_link);		\
+			cont->vc_dtx_act_count--;			\
+			cont->vc_pool->vp_dtx_act_count--;		\
+		}							\
 		lrua_evictx(cont->vc_dtx_array,				\
 			    DAE_LID(dae) - DTX_LID_RESERVED,		\
 			    DAE_EPOCH(dae));				\
@@ -274,13 +286,17 @@ static int
 dtx_act_ent_free(struct btr_instance *tins, struct btr_record *rec,
 		 void *args)
 {
+	struct vos_container	*cont = tins->ti_priv;
 	struct vos_dtx_act_ent	*dae;
 
 	dae = umem_off2ptr(&tins->ti_umm, rec->rec_off);
 	rec->rec_off = UMOFF_NULL;
 
-	if (dae != NULL)
+	if (dae != NULL && !d_list_empty(&dae->dae_link)) {
 		d_list_del_init(&dae->dae_link);
+		cont->vc_dtx_act_count--;
+		cont->vc_pool->vp_dtx_act_count--;
+	}
 
 	if (args != NULL) {
 		/* Return the record addreass (offset in DRAM).
@@ -342,6 +358,50 @@ static btr_ops_t dtx_active_btr_ops = {
 	.to_rec_update	= dtx_act_ent_update,
 };
 
+static struct vos_dtx_cmt_ent *
+dtx_cmt_ent_get(struct vos_container *cont)
+{
+	struct vos_dtx_cmt_slab	*dcs = cont->vc_dtx_cmt_slab;
+	struct vos_dtx_cmt_ent	*dce;
+	uint32_t		 shift;
+
+	if (dcs == NULL || dcs->dcs_index == dcs->dcs_cap) {
+		/* Start small, then an idle container does not pin a large slab. */
+		if (dcs == NULL)
+			shift = DTX_CMT_SLAB_MIN_SHIFT;
+		else
+			shift = min(dcs->dcs_shift + 1, DTX_CMT_SLAB_MAX_SHIFT);
+
+		/* Aligned with its size, then the slab can be found via the entry address. */
+		D_ALIGNED_ALLOC(dcs, 1UL << shift, 1UL << shift);
+		if (dcs == NULL)
+			return NULL;
+
+		dcs->dcs_refs = 1;
+		dcs->dcs_index = 0;
+		dcs->dcs_shift = shift;
+		dcs->dcs_cap = vos_dtx_cmt_slab_cap(shift);
+
+		if (cont->vc_dtx_cmt_slab != NULL)
+			vos_dtx_cmt_slab_put(cont->vc_dtx_cmt_slab);
+		cont->vc_dtx_cmt_slab = dcs;
+	}
+
+	dce = &dcs->dcs_ents[dcs->dcs_index++];
+	memset(dce, 0, sizeof(*dce));
+	dce->dce_slab_shift = dcs->dcs_shift;
+	dcs->dcs_refs++;
+
+	return dce;
+}
+
+static void
+dtx_cmt_ent_put(struct vos_dtx_cmt_ent *dce)
+{
+	vos_dtx_cmt_slab_put((struct vos_dtx_cmt_slab *)
+			     ((uintptr_t)dce & ~((1UL << dce->dce_slab_shift) - 1)));
+}
+
 static int
 dtx_cmt_ent_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
@@ -363,7 +423,7 @@ dtx_cmt_ent_free(struct btr_instance *tins, struct btr_record *rec,
 	D_ASSERT(dce != NULL);
 
 	rec->rec_off = UMOFF_NULL;
-	D_FREE_PTR(dce);
+	dtx_cmt_ent_put(dce);
 
 	return 0;
 }
@@ -412,7 +472,7 @@ dtx_cmt_ent_update(struct btr_instance *tins, struct btr_record *rec,
 
 	if (dce_old->dce_invalid) {
 		rec->rec_off = umem_ptr2off(&tins->ti_umm, dce_new);
-		D_FREE(dce_old);
+		dtx_cmt_ent_put(dce_old);
 	} else if (!dce_old->dce_reindex) {
 		D_ASSERTF(dce_new->dce_reindex, "Repeatedly commit DTX "DF_DTI"\n",
 			  DP_DTI(&DCE_XID(dce_new)));
@@ -811,7 +871,7 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti, daos_epoch_t
 		}
 	}
 
-	D_ALLOC_PTR(dce);
+	dce = dtx_cmt_ent_get(cont);
 	if (dce == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
@@ -853,8 +913,8 @@ out:
 	D_CDEBUG(rc != 0 && rc != -DER_NONEXIST, DLOG_ERR, DB_IO,
 		 "Commit the DTX "DF_DTI": rc = "DF_RC"\n",
 		 DP_DTI(dti), DP_RC(rc));
-	if (rc != 0)
-		D_FREE(dce);
+	if (rc != 0 && dce != NULL)
+		dtx_cmt_ent_put(dce);
 
 	if (rm_cos != NULL && (rc == 0 || rc == -DER_NONEXIST))
 		*rm_cos = true;
@@ -952,6 +1012,16 @@ vos_dtx_alloc(struct vos_dtx_blob_df *dbd, struct dtx_handle *dth)
 	cont = vos_hdl2cont(dth->dth_coh);
 	D_ASSERT(cont != NULL);
 
+	/* Bound the SCM and DRAM consumed by one container's active DTXs,
+	 * the client will retry after some of them have been committed.
+	 */
+	if (cont->vc_dtx_act_count >= vos_dtx_act_quota) {
+		D_DEBUG(DB_IO, "Too many active DTXs (%u) in "DF_UUID", refuse "
+			DF_DTI"\n", cont->vc_dtx_act_count, DP_UUID(cont->vc_id),
+			DP_DTI(&dth->dth_xid));
+		return -DER_INPROGRESS;
+	}
+
 	rc = lrua_allocx(cont->vc_dtx_array, &idx, dth->dth_epoch, &dae);
 	if (rc != 0) {
 		/* The array is full, need to commit some transactions first */
@@ -1004,6 +1074,8 @@ vos_dtx_alloc(struct vos_dtx_blob_df *dbd, struct dtx_handle *dth)
 	if (rc == 0) {
 		dae->dae_start_time = crt_hlc_get();
 		d_list_add_tail(&dae->dae_link, &cont->vc_dtx_act_list);
+		cont->vc_dtx_act_count++;
+		cont->vc_pool->vp_dtx_act_count++;
 		dth->dth_ent = dae;
 	} else {
 		dtx_evict_lid(cont, dae);
@@ -2373,8 +2445,12 @@ vos_dtx_stat(daos_handle_t coh, struct dtx_stat *stat, uint32_t flags)
 	}
 
 cmt:
+	stat->dtx_cont_act_count = cont->vc_dtx_act_count;
+	stat->dtx_cont_act_quota = vos_dtx_act_quota;
 	stat->dtx_cont_cmt_count = cont->vc_dtx_committed_count;
 	stat->dtx_pool_cmt_count = cont->vc_pool->vp_dtx_committed_count;
+	stat->dtx_pool_act_bytes = (uint64_t)cont->vc_pool->vp_dtx_act_count *
+				   DTX_ACT_ENT_SIZE;
 
 	stat->dtx_first_cmt_blob_time_up = 0;
 	stat->dtx_first_cmt_blob_time_lo = 0;
@@ -2411,6 +2487,17 @@ cmt:
 	}
 }
 
+bool
+vos_dtx_act_busy(daos_handle_t coh)
+{
+	struct vos_container	*cont;
+
+	cont = vos_hdl2cont(coh);
+	D_ASSERT(cont != NULL);
+
+	return cont->vc_dtx_act_count >= DTX_ACT_QUOTA_HI(vos_dtx_act_quota);
+}
+
 void
 vos_dtx_mark_committable(struct dtx_handle *dth)
 {
@@ -2555,6 +2642,8 @@ vos_dtx_act_reindex(struct vos_container *cont)
 
 			dae->dae_start_time = crt_hlc_get();
 			d_list_add_tail(&dae->dae_link, &cont->vc_dtx_act_list);
+			cont->vc_dtx_act_count++;
+			cont->vc_pool->vp_dtx_act_count++;
 		}
 
 		dbd_off = dbd->dbd_next;
@@ -2605,7 +2694,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh, void *hint)
 			continue;
 		}
 
-		D_ALLOC_PTR(dce);
+		dce = dtx_cmt_ent_get(cont);
 		if (dce == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
 
@@ -2618,7 +2707,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh, void *hint)
 		rc = dbtree_upsert(cont->vc_dtx_committed_hdl, BTR_PROBE_EQ,
 				   DAOS_INTENT_UPDATE, &kiov, &riov, NULL);
 		if (rc != 0) {
-			D_FREE(dce);
+			dtx_cmt_ent_put(dce);
 			goto out;
 		}
 
@@ -2626,7 +2715,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh, void *hint)
 		 * Related re-index logic can stop.
 		 */
 		if (dce->dce_exist) {
-			D_FREE(dce);
+			dtx_cmt_ent_put(dce);
 			D_GOTO(out, rc = 1);
 		}
 	}
@@ -85,6 +85,9 @@ extern struct dss_module_key vos_module_key;
 /** Up to 1 million lid entries split into 2048 expansion slots */
 #define DTX_ARRAY_LEN		(1 << 20) /* Total array slots for DTX lid */
 #define DTX_ARRAY_NR		(1 << 11)  /* Number of expansion arrays */
+/** Default per-container active DTX entries quota */
+#define DTX_ACT_QUOTA_DEF	DTX_ARRAY_LEN
+#define DTX_ACT_QUOTA_MIN	(1 << 10)
 
 enum {
 	/** Used for marking an in-tree record committed */
@@ -132,6 +135,7 @@ enum {
 #define VOS_NOSPC_ERROR_INTVL	60	/* seconds */
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_dtx_act_quota;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -228,6 +232,8 @@ struct vos_pool {
 	struct vos_pool_metrics	*vp_metrics;
 	/* The count of committed DTXs for the whole pool. */
 	uint32_t		 vp_dtx_committed_count;
+	/* The count of active DTXs for the whole pool. */
+	uint32_t		 vp_dtx_act_count;
 	/** Tiering policy */
 	struct policy_desc_t	vp_policy_desc;
 };
@@ -256,8 +262,12 @@ struct vos_container {
 	struct btr_root		vc_dtx_committed_btr;
 	/* The list for active DTXs, roughly ordered in time. */
 	d_list_t		vc_dtx_act_list;
+	/* The count of the DTXs in vc_dtx_act_list. */
+	uint32_t		vc_dtx_act_count;
 	/* The count of committed DTXs. */
 	uint32_t		vc_dtx_committed_count;
+	/* The current slab for allocating committed DTX entries in DRAM. */
+	struct vos_dtx_cmt_slab	*vc_dtx_cmt_slab;
 	/** Index for timestamp lookup */
 	uint32_t		*vc_ts_idx;
 	/** Direct pointer to the VOS container */
@@ -350,9 +360,51 @@ struct vos_dtx_cmt_ent {
 
 	uint32_t			 dce_reindex:1,
 					 dce_exist:1,
-					 dce_invalid:1;
+					 dce_invalid:1,
+					 /* log2 of the size of the slab holding the entry. */
+					 dce_slab_shift:5;
 };
 
+/*
+ * The DRAM slabs for committed DTX entries are aligned to their size. The
+ * first slab of a container is small, each next one doubles up to the max.
+ */
+#define DTX_CMT_SLAB_MIN_SHIFT	10
+#define DTX_CMT_SLAB_MAX_SHIFT	16
+
+/**
+ * The committed DTX entries in DRAM are allocated from append-only slabs in
+ * the same order as they are appended to the committed DTX blobs. The slab is
+ * freed when all its entries have been removed, usually by DTX aggregation.
+ */
+struct vos_dtx_cmt_slab {
+	/* Entries in use, plus one for the container if it is the current slab. */
+	uint32_t			 dcs_refs;
+	/* The next available slot. */
+	uint32_t			 dcs_index;
+	/* The total slots in the slab. */
+	uint32_t			 dcs_cap;
+	/* log2 of the slab size. */
+	uint32_t			 dcs_shift;
+	struct vos_dtx_cmt_ent		 dcs_ents[0];
+};
+
+static inline uint32_t
+vos_dtx_cmt_slab_cap(uint32_t shift)
+{
+	return ((1UL << shift) - sizeof(struct vos_dtx_cmt_slab)) /
+	       sizeof(struct vos_dtx_cmt_ent);
+}
+
+static inline void
+vos_dtx_cmt_slab_put(struct vos_dtx_cmt_slab *dcs)
+{
+	D_ASSERT(dcs->dcs_refs > 0);
+
+	if (--dcs->dcs_refs == 0)
+		D_FREE(dcs);
+}
+
 #define DCE_XID(dce)		((dce)->dce_base.dce_xid)
 #define DCE_EPOCH(dce)		((dce)->dce_base.dce_epoch)
 #define DCE_CMT_TIME(dce)	((dce)->dce_base.dce_cmt_time)
@@ -764,6 +764,7 @@ pool_open(PMEMobjpool *ph, struct vos_pool_df *pool_df, unsigned int flags, void
 	}
 
 	pool->vp_dtx_committed_count = 0;
+	pool->vp_dtx_act_count = 0;
 	pool->vp_pool_df = pool_df;
 	pool->vp_opened = 1;
 	pool->vp_excl = !!(flags & VOS_POF_EXCL);
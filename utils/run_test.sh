@@ -152,6 +152,11 @@ if [ -d "/mnt/daos" ]; then
     run_test "${SL_BUILD_DIR}/src/common/tests/prop_tests"
     run_test "${SL_BUILD_DIR}/src/common/tests/fault_domain_tests"
 
+    COMP="UTEST_object"
+    run_test "${SL_BUILD_DIR}/src/object/tests/ec_agg_delta_tests"
+    run_test "${SL_BUILD_DIR}/src/object/tests/hot_dkey_tests"
+    run_test "${SL_BUILD_DIR}/src/object/tests/hedge_lat_tests"
+
     COMP="UTEST_client"
     run_test "${SL_BUILD_DIR}/src/client/api/tests/eq_tests"
 